@@ -264,7 +264,7 @@ void SwitcherData::Thread()
 		vblog(LOG_INFO, "try to sleep for %ld",
 		      (long int)duration.count());
 		SetWaitScene();
-		cv.wait_for(lock, duration);
+		WaitForNextInterval(lock, duration);
 
 		startTime = std::chrono::high_resolution_clock::now();
 		sleep = 0;
@@ -275,6 +275,7 @@ void SwitcherData::Thread()
 			break;
 		}
 		if (checkPause()) {
+			nextSceneSequenceDeadline.reset();
 			continue;
 		}
 		SetPreconditions();
@@ -328,6 +329,22 @@ void SwitcherData::Thread()
 	blog(LOG_INFO, "stopped");
 }
 
+void SwitcherData::WaitForNextInterval(std::unique_lock<std::mutex> &lock,
+				       std::chrono::milliseconds duration)
+{
+	const auto intervalEnd =
+		std::chrono::high_resolution_clock::now() + duration;
+
+	// End the wait early if a scene sequence step becomes due before the
+	// end of the interval, so the step is handled by the regular check
+	if (nextSceneSequenceDeadline &&
+	    *nextSceneSequenceDeadline < intervalEnd) {
+		cv.wait_until(lock, *nextSceneSequenceDeadline);
+		return;
+	}
+	cv.wait_until(lock, intervalEnd);
+}
+
 void SwitcherData::SetPreconditions()
 {
 	// Window title
@@ -373,6 +390,7 @@ bool SwitcherData::CheckForMatch(OBSWeakSource &scene,
 				 bool &macroMatch)
 {
 	bool match = false;
+	nextSceneSequenceDeadline.reset();
 
 	if (uninterruptibleSceneSequenceActive) {
 		match = checkSceneSequence(scene, transition, linger,
@@ -56,6 +56,8 @@ public slots:
 	void on_enableCooldown_stateChanged(int state);
 	void on_startupBehavior_currentIndexChanged(int index);
 	void on_logLevel_currentIndexChanged(int index);
+	void on_traceMacroLatency_stateChanged(int state);
+	void on_exportMacroTraces_clicked();
 	void on_autoStartEvent_currentIndexChanged(int index);
 	void on_noMatchSwitchScene_currentTextChanged(const QString &text);
 	void on_checkInterval_valueChanged(int value);
@@ -201,6 +203,7 @@ private:
 
 	void SetupMacroSegmentSelection(MacroSection type, int idx);
 	bool ResolveMacroImportNameConflict(std::shared_ptr<Macro> &);
+	void ImportMacrosFromFile(const QString &path);
 	bool MacroTabIsInFocus();
 
 	MacroSection lastInteracted = MacroSection::CONDITIONS;
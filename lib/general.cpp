@@ -121,6 +121,32 @@ void AdvSceneSwitcher::on_logLevel_currentIndexChanged(int value)
 	switcher->logLevel = static_cast<SwitcherData::LogLevel>(value);
 }
 
+void AdvSceneSwitcher::on_traceMacroLatency_stateChanged(int state)
+{
+	if (loading) {
+		return;
+	}
+	if (state && !MacroTracingEnabled()) {
+		ClearMacroTraces();
+	}
+	EnableMacroTracing(state);
+}
+
+void AdvSceneSwitcher::on_exportMacroTraces_clicked()
+{
+	const QString path = QFileDialog::getSaveFileName(
+		this,
+		tr(obs_module_text(
+			"AdvSceneSwitcher.generalTab.generalBehavior.exportMacroTraces.windowTitle")),
+		FileSelection::ValidPathOrDesktop(""),
+		tr(obs_module_text(
+			"AdvSceneSwitcher.generalTab.generalBehavior.exportMacroTraces.fileType")));
+	if (path.isEmpty()) {
+		return;
+	}
+	WriteMacroTraces(path.toStdString());
+}
+
 void AdvSceneSwitcher::on_autoStartEvent_currentIndexChanged(int index)
 {
 	if (loading) {
@@ -527,6 +553,7 @@ void SwitcherData::SaveGeneralSettings(obs_data_t *obj)
 			 static_cast<int>(autoStartEvent));
 
 	obs_data_set_int(obj, "logLevel", static_cast<int>(logLevel));
+	obs_data_set_bool(obj, "traceMacroLatency", MacroTracingEnabled());
 	obs_data_set_bool(obj, "showSystemTrayNotifications",
 			  showSystemTrayNotifications);
 	obs_data_set_bool(obj, "disableHints", disableHints);
@@ -583,6 +610,7 @@ void SwitcherData::LoadGeneralSettings(obs_data_t *obj)
 		static_cast<AutoStart>(obs_data_get_int(obj, "autoStartEvent"));
 
 	logLevel = static_cast<LogLevel>(obs_data_get_int(obj, "logLevel"));
+	EnableMacroTracing(obs_data_get_bool(obj, "traceMacroLatency"));
 	showSystemTrayNotifications =
 		obs_data_get_bool(obj, "showSystemTrayNotifications");
 	disableHints = obs_data_get_bool(obj, "disableHints");
@@ -849,6 +877,9 @@ void AdvSceneSwitcher::SetupGeneralTab()
 			 SLOT(CooldownDurationChanged(const Duration &)));
 
 	ui->logLevel->setCurrentIndex(static_cast<int>(switcher->logLevel));
+	ui->traceMacroLatency->setChecked(MacroTracingEnabled());
+	ui->traceMacroLatency->setToolTip(obs_module_text(
+		"AdvSceneSwitcher.generalTab.generalBehavior.traceMacroLatency.tooltip"));
 
 	ui->saveWindowGeo->setChecked(switcher->saveWindowGeo);
 	ui->showTrayNotifications->setChecked(
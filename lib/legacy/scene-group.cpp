@@ -45,17 +45,16 @@ OBSWeakSource SceneGroup::getNextSceneCount()
 
 OBSWeakSource SceneGroup::getNextSceneTime()
 {
-	if (lastAdvTime.time_since_epoch().count() == 0) {
-		lastAdvTime = std::chrono::high_resolution_clock::now();
+	const auto now = std::chrono::high_resolution_clock::now();
+	const auto advanceInterval =
+		std::chrono::milliseconds((long long)(time * 1000));
+	if (nextAdvTime.time_since_epoch().count() == 0) {
+		nextAdvTime = now + advanceInterval;
 	}
 
-	auto now = std::chrono::high_resolution_clock::now();
-	auto passedTime = std::chrono::duration_cast<std::chrono::milliseconds>(
-		now - lastAdvTime);
-
-	if (passedTime.count() >= time * 1000) {
+	if (now >= nextAdvTime) {
 		advanceIdx();
-		lastAdvTime = now;
+		nextAdvTime = now + advanceInterval;
 	}
 
 	return scenes[currentIdx];
@@ -68,11 +67,16 @@ OBSWeakSource SceneGroup::getNextSceneRandom()
 		return scenes[currentIdx];
 	}
 
-	int rIdx = lastRandomScene;
-	std::srand(std::time(0));
-	do {
-		rIdx = rand() % scenes.size();
-	} while (rIdx == lastRandomScene);
+	// Pick from all scenes except the last one selected without having to
+	// retry until a different scene is drawn
+	const bool excludeLast = lastRandomScene >= 0 &&
+				 (size_t)lastRandomScene < scenes.size();
+	std::uniform_int_distribution<int> dist(
+		0, (int)scenes.size() - (excludeLast ? 2 : 1));
+	int rIdx = dist(randomEngine);
+	if (excludeLast && rIdx >= lastRandomScene) {
+		++rIdx;
+	}
 
 	lastRandomScene = rIdx;
 	currentIdx = rIdx;
@@ -687,6 +691,11 @@ void SceneGroupEditWidget::TimeChanged(double time)
 	}
 
 	std::lock_guard<std::mutex> lock(switcher->m);
+	// Keep the time the current scene was selected at
+	if (sceneGroup->nextAdvTime.time_since_epoch().count() != 0) {
+		sceneGroup->nextAdvTime += std::chrono::milliseconds(
+			(long long)((time - sceneGroup->time) * 1000));
+	}
 	sceneGroup->time = time;
 }
 
@@ -1,5 +1,7 @@
 #pragma once
+#include <chrono>
 #include <deque>
+#include <random>
 #include <vector>
 #include <QDialog>
 #include <QLabel>
@@ -38,8 +40,11 @@ struct SceneGroup {
 	size_t currentIdx = 0;
 
 	int currentCount = -1;
-	std::chrono::high_resolution_clock::time_point lastAdvTime;
+	// Point in time at which the next scene will be selected for groups
+	// of type AdvanceCondition::Time
+	std::chrono::high_resolution_clock::time_point nextAdvTime;
 	int lastRandomScene = -1;
+	std::mt19937 randomEngine{std::random_device{}()};
 
 	inline SceneGroup(){};
 	inline SceneGroup(const std::string &name_) : name(name_){};
@@ -203,6 +203,18 @@ bool SwitcherData::checkSceneSequence(OBSWeakSource &scene,
 	}
 
 	bool match = false;
+	nextSceneSequenceDeadline.reset();
+
+	// We cannot rely on switcher->currentScene for this information.
+	// Depending on the transition length the frontend event for the scene
+	// change of the previous element in the sequence might not yet have
+	// been received, which would lead to the sequencence being aborted.
+	// Thus we have to use obs_frontend_get_current_scene() here.
+	auto sceneSource = obs_frontend_get_current_scene();
+	OBSWeakSourceAutoRelease currentScene =
+		obs_source_get_weak_source(sceneSource);
+	obs_source_release(sceneSource);
+	const auto now = std::chrono::high_resolution_clock::now();
 
 	for (SceneSequenceSwitch &s : sceneSequenceSwitches) {
 		// Continue the active uninterruptible sequence and skip others
@@ -211,7 +223,7 @@ bool SwitcherData::checkSceneSequence(OBSWeakSource &scene,
 			continue;
 		}
 
-		bool matched = s.checkMatch(linger);
+		bool matched = s.checkMatch(linger, currentScene.Get(), now);
 
 		if (!match && matched) {
 			match = matched;
@@ -248,6 +260,17 @@ bool SwitcherData::checkSceneSequence(OBSWeakSource &scene,
 		uninterruptibleSceneSequenceActive = false;
 	}
 
+	// Allow the main loop to wake up in time for the next step instead
+	// of waiting for the next interval
+	for (const auto &s : sceneSequenceSwitches) {
+		auto deadline = s.nextDeadline();
+		if (deadline && *deadline > now &&
+		    (!nextSceneSequenceDeadline ||
+		     *deadline < *nextSceneSequenceDeadline)) {
+			nextSceneSequenceDeadline = deadline;
+		}
+	}
+
 	return match;
 }
 
@@ -408,7 +431,10 @@ SceneSequenceSwitch *SceneSequenceSwitch::extend()
 	return extendedSequence.get();
 }
 
-bool SceneSequenceSwitch::checkMatch(int &linger, SceneSequenceSwitch *root)
+bool SceneSequenceSwitch::checkMatch(int &linger,
+				     obs_weak_source_t *currentScene,
+				     const TimePoint &now,
+				     SceneSequenceSwitch *root)
 {
 	if (!initialized()) {
 		if (root) {
@@ -417,31 +443,22 @@ bool SceneSequenceSwitch::checkMatch(int &linger, SceneSequenceSwitch *root)
 		return false;
 	}
 
-	bool match = false;
-
-	// We cannot rely on switcher->currentScene for this information.
-	// Depending on the transition length the frontend event for the scene
-	// change of the previous element in the sequence might not yet have
-	// been received, which would lead to the sequencence being aborted.
-	// Thus we have to use obs_frontend_get_current_scene() here.
-	auto sceneSource = obs_frontend_get_current_scene();
-	auto currentScene = obs_source_get_weak_source(sceneSource);
-	obs_weak_source_release(currentScene);
-	obs_source_release(sceneSource);
-
+	// Only the currently active step of the sequence has to be checked
 	if (activeSequence) {
-		return activeSequence->checkMatch(linger, this);
+		return activeSequence->checkMatch(linger, currentScene, now,
+						  this);
 	}
 
+	bool match = false;
 	if (startScene == currentScene) {
 		if (interruptible) {
-			match = checkDurationMatchInterruptible();
+			match = checkDurationMatchInterruptible(now);
 		} else {
 			match = true;
 			prepareUninterruptibleMatch(linger);
 		}
 	} else {
-		delay.Reset();
+		deadline.reset();
 
 		if (root) {
 			root->activeSequence = nullptr;
@@ -452,13 +469,27 @@ bool SceneSequenceSwitch::checkMatch(int &linger, SceneSequenceSwitch *root)
 	return match;
 }
 
-bool SceneSequenceSwitch::checkDurationMatchInterruptible()
+bool SceneSequenceSwitch::checkDurationMatchInterruptible(const TimePoint &now)
 {
-	if (delay.DurationReached()) {
-		delay.Reset();
-		return true;
+	// The delay is only resolved once when the start scene becomes active
+	if (!deadline) {
+		deadline = now + std::chrono::milliseconds(
+					 (long long)delay.Milliseconds());
 	}
-	return false;
+	if (now < *deadline) {
+		return false;
+	}
+	deadline.reset();
+	return true;
+}
+
+std::optional<SceneSequenceSwitch::TimePoint>
+SceneSequenceSwitch::nextDeadline() const
+{
+	if (activeSequence) {
+		return activeSequence->deadline;
+	}
+	return deadline;
 }
 
 void SceneSequenceSwitch::prepareUninterruptibleMatch(int &linger)
@@ -507,7 +538,7 @@ void SceneSequenceSwitch::advanceActiveSequence()
 		}
 
 		// Reinit delay in case it was previously set
-		activeSequence->delay.Reset();
+		activeSequence->deadline.reset();
 	}
 }
 
@@ -11,11 +11,16 @@
 #include "switch-generic.hpp"
 #include "duration-control.hpp"
 
+#include <chrono>
+#include <optional>
+
 namespace advss {
 
 constexpr auto round_trip_func = 1;
 
 struct SceneSequenceSwitch : SceneSwitcherEntry {
+	using TimePoint = std::chrono::high_resolution_clock::time_point;
+
 	static bool pause;
 	SwitchTargetType startTargetType = SwitchTargetType::Scene;
 	OBSWeakSource startScene = nullptr;
@@ -24,6 +29,9 @@ struct SceneSequenceSwitch : SceneSwitcherEntry {
 
 	// nullptr marks start point and reaching end of extended sequence
 	SceneSequenceSwitch *activeSequence = nullptr;
+	// Set once the start scene of this step is active and an
+	// interruptible delay is being waited on
+	std::optional<TimePoint> deadline;
 
 	std::unique_ptr<SceneSequenceSwitch> extendedSequence = nullptr;
 
@@ -36,8 +44,11 @@ struct SceneSequenceSwitch : SceneSwitcherEntry {
 	bool reduce();
 	SceneSequenceSwitch *extend();
 
-	bool checkMatch(int &linger, SceneSequenceSwitch *root = nullptr);
-	bool checkDurationMatchInterruptible();
+	bool checkMatch(int &linger, obs_weak_source_t *currentScene,
+			const TimePoint &now,
+			SceneSequenceSwitch *root = nullptr);
+	bool checkDurationMatchInterruptible(const TimePoint &now);
+	std::optional<TimePoint> nextDeadline() const;
 	void prepareUninterruptibleMatch(int &linger);
 	void advanceActiveSequence();
 	void logAdvanceSequence();
@@ -1,5 +1,6 @@
 #include "platform-funcs.hpp"
 #include "log-helper.hpp"
+#include "x11-window-state.hpp"
 
 #include <X11/Xlib.h>
 #include <X11/Xatom.h>
@@ -230,6 +231,12 @@ std::string getWindowName(Window window)
 
 void GetWindowList(std::vector<std::string> &windows)
 {
+	auto &model = X11WindowStateModel::Instance();
+	if (model.IsRunning()) {
+		windows = model.GetWindowTitles();
+		return;
+	}
+
 	windows.resize(0);
 	for (auto window : getTopLevelWindows()) {
 		auto name = getWindowName(window);
@@ -243,6 +250,14 @@ void GetWindowList(std::vector<std::string> &windows)
 void GetWindowList(QStringList &windows)
 {
 	windows.clear();
+	auto &model = X11WindowStateModel::Instance();
+	if (model.IsRunning()) {
+		for (const auto &title : model.GetWindowTitles()) {
+			windows << QString::fromStdString(title);
+		}
+		return;
+	}
+
 	for (auto window : getTopLevelWindows()) {
 		auto name = getWindowName(window);
 		if (name.empty()) {
@@ -275,6 +290,15 @@ int getActiveWindow(Window *&window)
 
 void GetCurrentWindowTitle(std::string &title)
 {
+	auto &model = X11WindowStateModel::Instance();
+	if (model.IsRunning()) {
+		auto activeTitle = model.GetActiveWindowTitle();
+		if (activeTitle) {
+			title = *activeTitle;
+		}
+		return;
+	}
+
 	Window *data = 0;
 	if (getActiveWindow(data) != Success || !data) {
 		return;
@@ -335,6 +359,13 @@ bool windowStatesAreSet(const std::string &windowTitle,
 
 bool IsMaximized(const std::string &title)
 {
+	auto &model = X11WindowStateModel::Instance();
+	if (model.IsRunning()) {
+		return model.WindowStatesAreSet(
+			title, {"_NET_WM_STATE_MAXIMIZED_VERT",
+				"_NET_WM_STATE_MAXIMIZED_HORZ"});
+	}
+
 	std::vector<QString> states;
 	states.emplace_back("_NET_WM_STATE_MAXIMIZED_VERT");
 	states.emplace_back("_NET_WM_STATE_MAXIMIZED_HORZ");
@@ -343,6 +374,12 @@ bool IsMaximized(const std::string &title)
 
 bool IsFullscreen(const std::string &title)
 {
+	auto &model = X11WindowStateModel::Instance();
+	if (model.IsRunning()) {
+		return model.WindowStatesAreSet(title,
+						{"_NET_WM_STATE_FULLSCREEN"});
+	}
+
 	std::vector<QString> states;
 	states.emplace_back("_NET_WM_STATE_FULLSCREEN");
 	return windowStatesAreSet(title, states);
@@ -408,6 +445,11 @@ void GetProcessList(QStringList &processes)
 
 long getForegroundProcessPid()
 {
+	auto &model = X11WindowStateModel::Instance();
+	if (model.IsRunning()) {
+		return model.GetActiveWindowPid().value_or(-1);
+	}
+
 	Window *window;
 	if (getActiveWindow(window) != Success || !window || !*window) {
 		return -1;
@@ -556,6 +598,10 @@ void PlatformInit()
 	initXss();
 	initProcps();
 	initProc2();
+
+	if (ewmhIsSupported()) {
+		X11WindowStateModel::Instance().Start();
+	}
 }
 
 static void cleanupHelper(QLibrary *lib)
@@ -568,6 +614,7 @@ static void cleanupHelper(QLibrary *lib)
 
 void PlatformCleanup()
 {
+	X11WindowStateModel::Instance().Stop();
 	cleanupHelper(libXssHandle);
 	cleanupHelper(libprocps);
 	cleanupHelper(libproc2);
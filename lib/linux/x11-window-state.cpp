@@ -0,0 +1,394 @@
+#include "x11-window-state.hpp"
+#include "log-helper.hpp"
+
+#include <X11/Xlib.h>
+#include <X11/Xatom.h>
+#include <X11/Xutil.h>
+#undef Bool
+#undef CursorShape
+#undef Expose
+#undef KeyPress
+#undef KeyRelease
+#undef FocusIn
+#undef FocusOut
+#undef FontChange
+#undef None
+#undef Status
+#undef Unsorted
+#include <algorithm>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <QRegularExpression>
+#include <QString>
+
+namespace advss {
+
+static Display *modelDisplay = nullptr;
+static XErrorHandler previousErrorHandler = nullptr;
+
+static int errorHandler(Display *display, XErrorEvent *event)
+{
+	// Windows can be destroyed at any time, so errors caused by accessing
+	// windows which no longer exist are expected on the model's connection
+	if (display == modelDisplay) {
+		return 0;
+	}
+	return previousErrorHandler ? previousErrorHandler(display, event) : 0;
+}
+
+static std::vector<unsigned long>
+getWindowProperty(Display *display, Window window, Atom property, Atom type)
+{
+	std::vector<unsigned long> result;
+	Atom actualType;
+	int format = 0;
+	unsigned long num = 0, bytes = 0;
+	unsigned char *data = nullptr;
+	int status = XGetWindowProperty(display, window, property, 0L, ~0L,
+					false, type, &actualType, &format,
+					&num, &bytes, &data);
+	if (status != Success || !data) {
+		return result;
+	}
+	// Format 32 properties are returned as an array of longs
+	if (format == 32) {
+		auto values = reinterpret_cast<unsigned long *>(data);
+		result.assign(values, values + num);
+	}
+	XFree(data);
+	return result;
+}
+
+static std::string getWindowTitle(Display *display, Window window)
+{
+	std::string title;
+	char *name = nullptr;
+	int status = XFetchName(display, window, &name);
+	if (status >= Success && name != nullptr) {
+		title = name;
+		XFree(name);
+		return title;
+	}
+
+	XTextProperty textProperty;
+	if (XGetWMName(display, window, &textProperty) != 0 &&
+	    textProperty.value != nullptr) {
+		title = (const char *)textProperty.value;
+		XFree(textProperty.value);
+	}
+	return title;
+}
+
+X11WindowStateModel &X11WindowStateModel::Instance()
+{
+	static X11WindowStateModel model;
+	return model;
+}
+
+X11WindowStateModel::~X11WindowStateModel()
+{
+	Stop();
+}
+
+bool X11WindowStateModel::Start()
+{
+	if (_running) {
+		return true;
+	}
+
+	// Use a dedicated connection, as it will be used from the event thread
+	_display = XOpenDisplay(NULL);
+	if (!_display) {
+		return false;
+	}
+
+	_netClientList = XInternAtom(_display, "_NET_CLIENT_LIST", true);
+	_netActiveWindow = XInternAtom(_display, "_NET_ACTIVE_WINDOW", true);
+	_netWmName = XInternAtom(_display, "_NET_WM_NAME", false);
+	_netWmState = XInternAtom(_display, "_NET_WM_STATE", false);
+	_netWmPid = XInternAtom(_display, "_NET_WM_PID", false);
+	if (!_netClientList || !_netActiveWindow || pipe(_wakeupPipe) != 0) {
+		blog(LOG_INFO, "X11 window state tracking not supported");
+		XCloseDisplay(_display);
+		_display = nullptr;
+		return false;
+	}
+	fcntl(_wakeupPipe[0], F_SETFL, O_NONBLOCK);
+
+	modelDisplay = _display;
+	previousErrorHandler = XSetErrorHandler(errorHandler);
+
+	for (int i = 0; i < ScreenCount(_display); ++i) {
+		Window root = RootWindow(_display, i);
+		if (!root) {
+			continue;
+		}
+		XSelectInput(_display, root, PropertyChangeMask);
+		_roots.emplace_back(root);
+	}
+	UpdateClientList();
+	UpdateActiveWindow();
+	XFlush(_display);
+
+	_stop = false;
+	_running = true;
+	_thread = std::thread(&X11WindowStateModel::Run, this);
+	return true;
+}
+
+void X11WindowStateModel::Stop()
+{
+	if (!_running) {
+		return;
+	}
+
+	_stop = true;
+	if (write(_wakeupPipe[1], "x", 1) < 0) {
+		blog(LOG_WARNING, "failed to wake up X11 event thread");
+	}
+	if (_thread.joinable()) {
+		_thread.join();
+	}
+
+	XSetErrorHandler(previousErrorHandler);
+	modelDisplay = nullptr;
+	XCloseDisplay(_display);
+	_display = nullptr;
+	close(_wakeupPipe[0]);
+	close(_wakeupPipe[1]);
+	_wakeupPipe[0] = -1;
+	_wakeupPipe[1] = -1;
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_roots.clear();
+	_atomNames.clear();
+	_clients.clear();
+	_windows.clear();
+	_activeWindow = 0;
+	_running = false;
+}
+
+void X11WindowStateModel::Run()
+{
+	const int fd = ConnectionNumber(_display);
+	while (!_stop) {
+		while (XPending(_display) > 0) {
+			XEvent event;
+			XNextEvent(_display, &event);
+			HandleEvent(event);
+		}
+		XFlush(_display);
+
+		pollfd fds[2] = {{fd, POLLIN, 0}, {_wakeupPipe[0], POLLIN, 0}};
+		poll(fds, 2, -1);
+	}
+}
+
+void X11WindowStateModel::HandleEvent(const XEvent &event)
+{
+	if (event.type != PropertyNotify) {
+		return;
+	}
+
+	const auto &propertyEvent = event.xproperty;
+	if (std::find(_roots.begin(), _roots.end(), propertyEvent.window) !=
+	    _roots.end()) {
+		if (propertyEvent.atom == _netClientList) {
+			UpdateClientList();
+		} else if (propertyEvent.atom == _netActiveWindow) {
+			UpdateActiveWindow();
+		}
+		return;
+	}
+
+	if (_windows.find(propertyEvent.window) == _windows.end()) {
+		return;
+	}
+
+	if (propertyEvent.atom == _netWmName ||
+	    propertyEvent.atom == XA_WM_NAME) {
+		UpdateTitle(propertyEvent.window);
+	} else if (propertyEvent.atom == _netWmState) {
+		UpdateStates(propertyEvent.window);
+	} else if (propertyEvent.atom == _netWmPid) {
+		auto pid = getWindowProperty(_display, propertyEvent.window,
+					     _netWmPid, XA_CARDINAL);
+		std::lock_guard<std::mutex> lock(_mutex);
+		_windows[propertyEvent.window].pid =
+			pid.empty() ? -1 : (long)pid[0];
+	}
+}
+
+// The tables are only modified by the event thread, so reading them without
+// holding the lock is safe here
+void X11WindowStateModel::UpdateClientList()
+{
+	std::vector<unsigned long> clients;
+	for (auto root : _roots) {
+		auto list = getWindowProperty(_display, root, _netClientList,
+					      XA_WINDOW);
+		clients.insert(clients.end(), list.begin(), list.end());
+	}
+
+	std::unordered_map<unsigned long, WindowInfo> windows;
+	auto keepOrRead = [&](unsigned long window) {
+		auto it = _windows.find(window);
+		if (it != _windows.end()) {
+			windows.emplace(window, it->second);
+			return;
+		}
+		XSelectInput(_display, window, PropertyChangeMask);
+		windows.emplace(window, ReadWindowInfo(window));
+	};
+	for (auto client : clients) {
+		keepOrRead(client);
+	}
+	if (_activeWindow) {
+		keepOrRead(_activeWindow);
+	}
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_clients = std::move(clients);
+	_windows = std::move(windows);
+}
+
+void X11WindowStateModel::UpdateActiveWindow()
+{
+	Window active = 0;
+	if (!_roots.empty()) {
+		auto value = getWindowProperty(_display, _roots[0],
+					       _netActiveWindow, XA_WINDOW);
+		active = value.empty() ? 0 : value[0];
+	}
+
+	// The active window is not necessarily part of the client list
+	std::optional<WindowInfo> info;
+	if (active && _windows.find(active) == _windows.end()) {
+		XSelectInput(_display, active, PropertyChangeMask);
+		info = ReadWindowInfo(active);
+	}
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_activeWindow = active;
+	if (info) {
+		_windows[active] = *info;
+	}
+}
+
+void X11WindowStateModel::UpdateTitle(unsigned long window)
+{
+	auto title = getWindowTitle(_display, window);
+	std::lock_guard<std::mutex> lock(_mutex);
+	_windows[window].title = title;
+}
+
+void X11WindowStateModel::UpdateStates(unsigned long window)
+{
+	std::vector<std::string> states;
+	for (auto atom :
+	     getWindowProperty(_display, window, _netWmState, XA_ATOM)) {
+		states.emplace_back(GetAtomName(atom));
+	}
+	std::lock_guard<std::mutex> lock(_mutex);
+	_windows[window].states = std::move(states);
+}
+
+X11WindowStateModel::WindowInfo
+X11WindowStateModel::ReadWindowInfo(unsigned long window)
+{
+	WindowInfo info;
+	info.title = getWindowTitle(_display, window);
+	for (auto atom :
+	     getWindowProperty(_display, window, _netWmState, XA_ATOM)) {
+		info.states.emplace_back(GetAtomName(atom));
+	}
+	auto pid = getWindowProperty(_display, window, _netWmPid, XA_CARDINAL);
+	if (!pid.empty()) {
+		info.pid = (long)pid[0];
+	}
+	return info;
+}
+
+const std::string &X11WindowStateModel::GetAtomName(unsigned long atom)
+{
+	auto it = _atomNames.find(atom);
+	if (it != _atomNames.end()) {
+		return it->second;
+	}
+
+	std::string name;
+	char *atomName = XGetAtomName(_display, atom);
+	if (atomName) {
+		name = atomName;
+		XFree(atomName);
+	}
+	return _atomNames.emplace(atom, name).first->second;
+}
+
+std::vector<std::string> X11WindowStateModel::GetWindowTitles() const
+{
+	std::vector<std::string> titles;
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (auto client : _clients) {
+		auto it = _windows.find(client);
+		if (it == _windows.end() || it->second.title.empty()) {
+			continue;
+		}
+		titles.emplace_back(it->second.title);
+	}
+	return titles;
+}
+
+std::optional<std::string> X11WindowStateModel::GetActiveWindowTitle() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto it = _windows.find(_activeWindow);
+	if (!_activeWindow || it == _windows.end() ||
+	    it->second.title.empty()) {
+		return {};
+	}
+	return it->second.title;
+}
+
+std::optional<long> X11WindowStateModel::GetActiveWindowPid() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto it = _windows.find(_activeWindow);
+	if (!_activeWindow || it == _windows.end() || it->second.pid < 0) {
+		return {};
+	}
+	return it->second.pid;
+}
+
+bool X11WindowStateModel::WindowStatesAreSet(
+	const std::string &title, const std::vector<std::string> &states) const
+{
+	const QRegularExpression regex(QString::fromStdString(title));
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (auto client : _clients) {
+		auto it = _windows.find(client);
+		if (it == _windows.end() || it->second.title.empty()) {
+			continue;
+		}
+
+		const auto &info = it->second;
+		bool equals = title == info.title;
+		bool matches =
+			QString::fromStdString(info.title).contains(regex);
+		if (!(equals || matches)) {
+			continue;
+		}
+
+		for (const auto &state : states) {
+			if (std::find(info.states.begin(), info.states.end(),
+				      state) == info.states.end()) {
+				return false;
+			}
+		}
+		return true;
+	}
+	return false;
+}
+
+} // namespace advss
@@ -0,0 +1,76 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct _XDisplay;
+union _XEvent;
+
+namespace advss {
+
+// Keeps track of the title, state and pid of all top level windows and the
+// currently active window by listening to PropertyNotify events instead of
+// querying the X server every time the information is needed
+class X11WindowStateModel {
+public:
+	static X11WindowStateModel &Instance();
+
+	// Returns false if the X server or window manager does not provide
+	// the required EWMH properties
+	bool Start();
+	void Stop();
+	bool IsRunning() const { return _running; }
+
+	std::vector<std::string> GetWindowTitles() const;
+	std::optional<std::string> GetActiveWindowTitle() const;
+	std::optional<long> GetActiveWindowPid() const;
+	// Checks the states of the first window whose title equals or matches
+	// the given title
+	bool WindowStatesAreSet(const std::string &title,
+				const std::vector<std::string> &states) const;
+
+private:
+	struct WindowInfo {
+		std::string title;
+		std::vector<std::string> states;
+		long pid = -1;
+	};
+
+	X11WindowStateModel() = default;
+	~X11WindowStateModel();
+
+	void Run();
+	void HandleEvent(const _XEvent &);
+	void UpdateClientList();
+	void UpdateActiveWindow();
+	void UpdateTitle(unsigned long window);
+	void UpdateStates(unsigned long window);
+	WindowInfo ReadWindowInfo(unsigned long window);
+	const std::string &GetAtomName(unsigned long atom);
+
+	_XDisplay *_display = nullptr;
+	std::vector<unsigned long> _roots;
+	unsigned long _netClientList = 0;
+	unsigned long _netActiveWindow = 0;
+	unsigned long _netWmName = 0;
+	unsigned long _netWmState = 0;
+	unsigned long _netWmPid = 0;
+	// Only accessed by the event thread after Start()
+	std::unordered_map<unsigned long, std::string> _atomNames;
+
+	mutable std::mutex _mutex;
+	std::vector<unsigned long> _clients;
+	std::unordered_map<unsigned long, WindowInfo> _windows;
+	unsigned long _activeWindow = 0;
+
+	std::thread _thread;
+	std::atomic_bool _running = {false};
+	std::atomic_bool _stop = {false};
+	int _wakeupPipe[2] = {-1, -1};
+};
+
+} // namespace advss
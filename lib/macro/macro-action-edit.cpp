@@ -87,6 +87,9 @@ void MacroActionEdit::ActionSelectionChanged(const QString &text)
 		(*_entryData)->SetIndex(idx);
 		(*_entryData)->PostLoad();
 		RunPostLoadSteps();
+		if (macro) {
+			macro->PublishActionSnapshots();
+		}
 	}
 	auto widget = MacroActionFactory::CreateWidget(id, this, *_entryData);
 	QWidget::connect(widget, SIGNAL(HeaderInfoChanged(const QString &)),
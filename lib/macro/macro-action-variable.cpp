@@ -8,6 +8,8 @@
 #include "source-helpers.hpp"
 #include "utility.hpp"
 
+#include <nlohmann/json.hpp>
+
 namespace advss {
 
 const std::string MacroActionVariable::id = "variable";
@@ -60,6 +62,54 @@ const static std::map<MacroActionVariable::Type, std::string> actionTypes = {
 	 "AdvSceneSwitcher.action.variable.type.truncateValue"},
 	{MacroActionVariable::Type::SWAP_VALUES,
 	 "AdvSceneSwitcher.action.variable.type.swapValues"},
+	{MacroActionVariable::Type::LIST_PUSH,
+	 "AdvSceneSwitcher.action.variable.type.listPush"},
+	{MacroActionVariable::Type::LIST_POP_FRONT,
+	 "AdvSceneSwitcher.action.variable.type.listPopFront"},
+	{MacroActionVariable::Type::LIST_POP_BACK,
+	 "AdvSceneSwitcher.action.variable.type.listPopBack"},
+	{MacroActionVariable::Type::LIST_GET,
+	 "AdvSceneSwitcher.action.variable.type.listGet"},
+	{MacroActionVariable::Type::LIST_SET,
+	 "AdvSceneSwitcher.action.variable.type.listSet"},
+	{MacroActionVariable::Type::MAP_SET,
+	 "AdvSceneSwitcher.action.variable.type.mapSet"},
+	{MacroActionVariable::Type::MAP_GET,
+	 "AdvSceneSwitcher.action.variable.type.mapGet"},
+	{MacroActionVariable::Type::MAP_REMOVE,
+	 "AdvSceneSwitcher.action.variable.type.mapRemove"},
+	{MacroActionVariable::Type::CONTAINS,
+	 "AdvSceneSwitcher.action.variable.type.contains"},
+	{MacroActionVariable::Type::SIZE,
+	 "AdvSceneSwitcher.action.variable.type.size"},
+	{MacroActionVariable::Type::FOR_EACH,
+	 "AdvSceneSwitcher.action.variable.type.forEach"},
+};
+
+const static std::map<MacroActionVariable::Type, std::string>
+	collectionLayouts = {
+		{MacroActionVariable::Type::LIST_PUSH,
+		 "AdvSceneSwitcher.action.variable.entry.listPush"},
+		{MacroActionVariable::Type::LIST_POP_FRONT,
+		 "AdvSceneSwitcher.action.variable.entry.listPop"},
+		{MacroActionVariable::Type::LIST_POP_BACK,
+		 "AdvSceneSwitcher.action.variable.entry.listPop"},
+		{MacroActionVariable::Type::LIST_GET,
+		 "AdvSceneSwitcher.action.variable.entry.listGet"},
+		{MacroActionVariable::Type::LIST_SET,
+		 "AdvSceneSwitcher.action.variable.entry.listSet"},
+		{MacroActionVariable::Type::MAP_SET,
+		 "AdvSceneSwitcher.action.variable.entry.mapSet"},
+		{MacroActionVariable::Type::MAP_GET,
+		 "AdvSceneSwitcher.action.variable.entry.mapGet"},
+		{MacroActionVariable::Type::MAP_REMOVE,
+		 "AdvSceneSwitcher.action.variable.entry.mapRemove"},
+		{MacroActionVariable::Type::CONTAINS,
+		 "AdvSceneSwitcher.action.variable.entry.contains"},
+		{MacroActionVariable::Type::SIZE,
+		 "AdvSceneSwitcher.action.variable.entry.size"},
+		{MacroActionVariable::Type::FOR_EACH,
+		 "AdvSceneSwitcher.action.variable.entry.forEach"},
 };
 
 static void apppend(Variable &var, const std::string &value)
@@ -159,6 +209,111 @@ void MacroActionVariable::HandleMathExpression(Variable *var)
 	var->SetValue(std::get<double>(result));
 }
 
+void MacroActionVariable::HandleCollectionOperation(Variable *var)
+{
+	auto target = _variable2.lock();
+	const int index = _listIndex - 1;
+	bool success = true;
+
+	switch (_type) {
+	case Type::LIST_PUSH:
+		success = var->ListPush(_strValue);
+		break;
+	case Type::LIST_POP_FRONT:
+	case Type::LIST_POP_BACK: {
+		auto value = var->ListPop(_type == Type::LIST_POP_FRONT);
+		success = value.has_value();
+		if (value && target) {
+			target->SetValue(*value);
+		}
+		break;
+	}
+	case Type::LIST_GET: {
+		auto value = index < 0 ? std::optional<std::string>()
+				       : var->ListGet(index);
+		success = value.has_value();
+		if (value && target) {
+			target->SetValue(*value);
+		}
+		break;
+	}
+	case Type::LIST_SET:
+		success = index >= 0 && var->ListSet(index, _strValue);
+		break;
+	case Type::MAP_SET:
+		success = var->MapSet(_mapKey, _strValue);
+		break;
+	case Type::MAP_GET: {
+		auto value = var->MapGet(_mapKey);
+		success = value.has_value();
+		if (value && target) {
+			target->SetValue(*value);
+		}
+		break;
+	}
+	case Type::MAP_REMOVE:
+		var->MapRemove(_mapKey);
+		break;
+	case Type::CONTAINS:
+		if (target) {
+			target->SetBoolValue(var->Contains(_strValue));
+		}
+		break;
+	case Type::SIZE: {
+		auto size = var->Size();
+		success = size.has_value();
+		if (size && target) {
+			target->SetIntValue(*size);
+		}
+		break;
+	}
+	default:
+		break;
+	}
+
+	if (!success) {
+		vblog(LOG_INFO,
+		      "list or map operation failed for variable \"%s\"",
+		      var->Name().c_str());
+	}
+}
+
+bool MacroActionVariable::IterateElements(Variable *var)
+{
+	auto target = _variable2.lock();
+	auto macro = _iterationMacro.GetMacro();
+	if (!target || !macro) {
+		return true;
+	}
+	if (macro.get() == GetMacro()) {
+		blog(LOG_WARNING,
+		     "macro \"%s\" cannot run its own actions for each element of variable \"%s\"",
+		     macro->Name().c_str(), var->Name().c_str());
+		return true;
+	}
+
+	// Iterate over a snapshot, so the actions can modify the collection
+	auto elements = var->Elements();
+	if (!elements) {
+		return true;
+	}
+	for (const auto &element : *elements) {
+		if (GetMacro()->GetStop()) {
+			return false;
+		}
+		target->SetValue(element);
+		// The actions have to be done with the current element before
+		// moving on to the next one, so never run them in parallel
+		if (!macro->PerformActionsSynchronously(true, true)) {
+			blog(LOG_WARNING,
+			     "stopped iterating over variable \"%s\" as the actions of macro \"%s\" did not complete",
+			     var->Name().c_str(), macro->Name().c_str());
+			return false;
+		}
+	}
+	return true;
+}
+
 struct GetSceneItemNameHelper {
 	int curIdx = 0;
 	int targetIdx = 0;
@@ -304,7 +459,7 @@ bool MacroActionVariable::PerformAction()
 		if (!curValue.has_value()) {
 			return true;
 		}
-		var->SetValue(std::to_string(int(std::round(*curValue))));
+		var->SetIntValue(int(std::round(*curValue)));
 		return true;
 	}
 	case Type::SUBSTRING: {
@@ -356,19 +511,28 @@ bool MacroActionVariable::PerformAction()
 		return true;
 	}
 	case Type::SCENE_ITEM_COUNT: {
-		var->SetValue(GetSceneItemCount(_scene.GetScene(false)));
+		var->SetIntValue(GetSceneItemCount(_scene.GetScene(false)));
 		return true;
 	}
 	case Type::STRING_LENGTH: {
-		var->SetValue(std::string(_strValue).length());
+		var->SetIntValue(std::string(_strValue).length());
 		return true;
 	}
 	case Type::EXTRACT_JSON: {
-		auto value = GetJsonField(var->Value(), _strValue);
-		if (!value.has_value()) {
+		// Avoid parsing the value again if it already is JSON
+		auto json = var->JsonValue();
+		if (!json || !json->is_object()) {
 			return true;
 		}
-		var->SetValue(*value);
+		auto it = json->find(std::string(_strValue));
+		if (it == json->end()) {
+			return true;
+		}
+		if (it->is_string()) {
+			var->SetValue(it->get<std::string>());
+		} else {
+			var->SetJsonValue(*it);
+		}
 		return true;
 	}
 	case Type::SET_TO_TEMPVAR: {
@@ -405,6 +569,20 @@ bool MacroActionVariable::PerformAction()
 		var2->SetValue(tempValue);
 		return true;
 	}
+	case Type::LIST_PUSH:
+	case Type::LIST_POP_FRONT:
+	case Type::LIST_POP_BACK:
+	case Type::LIST_GET:
+	case Type::LIST_SET:
+	case Type::MAP_SET:
+	case Type::MAP_GET:
+	case Type::MAP_REMOVE:
+	case Type::CONTAINS:
+	case Type::SIZE:
+		HandleCollectionOperation(var.get());
+		return true;
+	case Type::FOR_EACH:
+		return IterateElements(var.get());
 	}
 
 	return true;
@@ -441,6 +619,11 @@ bool MacroActionVariable::Save(obs_data_t *obj) const
 	obs_data_set_int(obj, "direction", static_cast<int>(_direction));
 	_stringLength.Save(obj, "stringLength");
 	obs_data_set_int(obj, "paddingChar", _paddingChar);
+	_listIndex.Save(obj, "listIndex");
+	_mapKey.Save(obj, "mapKey");
+	OBSDataAutoRelease iterationMacro = obs_data_create();
+	_iterationMacro.Save(iterationMacro);
+	obs_data_set_obj(obj, "iterationMacro", iterationMacro);
 	return true;
 }
 
@@ -479,12 +662,18 @@ bool MacroActionVariable::Load(obs_data_t *obj)
 	} else {
 		_paddingChar = ' ';
 	}
+	_listIndex.Load(obj, "listIndex");
+	_mapKey.Load(obj, "mapKey");
+	OBSDataAutoRelease iterationMacro =
+		obs_data_get_obj(obj, "iterationMacro");
+	_iterationMacro.Load(iterationMacro);
 	return true;
 }
 
 bool MacroActionVariable::PostLoad()
 {
 	SetSegmentIndexValue(_segmentIdxLoadValue);
+	_iterationMacro.PostLoad();
 	return true;
 }
 
@@ -577,6 +766,8 @@ void MacroActionVariable::ResolveVariablesToFixedValues()
 	_envVariableName.ResolveVariables();
 	_scene.ResolveVariables();
 	_sceneItemIndex.ResolveVariables();
+	_listIndex.ResolveVariables();
+	_mapKey.ResolveVariables();
 }
 
 void MacroActionVariable::DecrementCurrentSegmentVariableRef()
@@ -649,6 +840,9 @@ MacroActionVariableEdit::MacroActionVariableEdit(
 	  _direction(new QComboBox()),
 	  _stringLength(new VariableSpinBox()),
 	  _paddingCharSelection(new SingleCharSelection()),
+	  _listIndex(new VariableSpinBox(this)),
+	  _mapKey(new VariableLineEdit(this)),
+	  _iterationMacro(new MacroSelection(this)),
 	  _entryLayout(new QHBoxLayout())
 {
 	_numValue->setMinimum(-9999999999);
@@ -669,6 +863,9 @@ MacroActionVariableEdit::MacroActionVariableEdit(
 				    QSizePolicy::Preferred);
 	_sceneItemIndex->setMinimum(1);
 	_stringLength->setMaximum(999);
+	_listIndex->setMinimum(1);
+	_listIndex->setMaximum(9999999);
+	_iterationMacro->HideSelectedMacro();
 	populateTypeSelection(_actions);
 	populateDirectionSelection(_direction);
 
@@ -735,6 +932,15 @@ MacroActionVariableEdit::MacroActionVariableEdit(
 	QWidget::connect(_paddingCharSelection,
 			 SIGNAL(CharChanged(const QString &)), this,
 			 SLOT(CharSelectionChanged(const QString &)));
+	QWidget::connect(
+		_listIndex,
+		SIGNAL(NumberVariableChanged(const NumberVariable<int> &)),
+		this, SLOT(ListIndexChanged(const NumberVariable<int> &)));
+	QWidget::connect(_mapKey, SIGNAL(editingFinished()), this,
+			 SLOT(MapKeyChanged()));
+	QWidget::connect(_iterationMacro,
+			 SIGNAL(currentTextChanged(const QString &)), this,
+			 SLOT(IterationMacroChanged(const QString &)));
 
 	const std::unordered_map<std::string, QWidget *> widgetPlaceholders = {
 		{"{{variables}}", _variables},
@@ -762,6 +968,9 @@ MacroActionVariableEdit::MacroActionVariableEdit(
 		{"{{direction}}", _direction},
 		{"{{stringLength}}", _stringLength},
 		{"{{paddingCharSelection}}", _paddingCharSelection},
+		{"{{listIndex}}", _listIndex},
+		{"{{mapKey}}", _mapKey},
+		{"{{iterationMacro}}", _iterationMacro},
 	};
 	PlaceWidgets(
 		obs_module_text("AdvSceneSwitcher.action.variable.entry.other"),
@@ -862,6 +1071,9 @@ void MacroActionVariableEdit::UpdateEntryData()
 	_stringLength->SetValue(_entryData->_stringLength);
 	_paddingCharSelection->setText(
 		QChar::fromLatin1(_entryData->_paddingChar));
+	_listIndex->SetValue(_entryData->_listIndex);
+	_mapKey->setText(_entryData->_mapKey);
+	_iterationMacro->SetCurrentMacro(_entryData->_iterationMacro);
 	SetWidgetVisibility();
 }
 
@@ -1268,6 +1480,36 @@ void MacroActionVariableEdit::CharSelectionChanged(const QString &character)
 	}
 }
 
+void MacroActionVariableEdit::ListIndexChanged(const NumberVariable<int> &value)
+{
+	if (_loading || !_entryData) {
+		return;
+	}
+
+	auto lock = LockContext();
+	_entryData->_listIndex = value;
+}
+
+void MacroActionVariableEdit::MapKeyChanged()
+{
+	if (_loading || !_entryData) {
+		return;
+	}
+
+	auto lock = LockContext();
+	_entryData->_mapKey = _mapKey->text().toStdString();
+}
+
+void MacroActionVariableEdit::IterationMacroChanged(const QString &text)
+{
+	if (_loading || !_entryData) {
+		return;
+	}
+
+	auto lock = LockContext();
+	_entryData->_iterationMacro = text;
+}
+
 void MacroActionVariableEdit::SetWidgetVisibility()
 {
 	if (!_entryData) {
@@ -1290,6 +1532,9 @@ void MacroActionVariableEdit::SetWidgetVisibility()
 		{"{{direction}}", _direction},
 		{"{{stringLength}}", _stringLength},
 		{"{{paddingCharSelection}}", _paddingCharSelection},
+		{"{{listIndex}}", _listIndex},
+		{"{{mapKey}}", _mapKey},
+		{"{{iterationMacro}}", _iterationMacro},
 	};
 
 	const char *layoutString = "";
@@ -1299,6 +1544,9 @@ void MacroActionVariableEdit::SetWidgetVisibility()
 	} else if (_entryData->_type == MacroActionVariable::Type::TRUNCATE) {
 		layoutString = obs_module_text(
 			"AdvSceneSwitcher.action.variable.entry.truncate");
+	} else if (auto it = collectionLayouts.find(_entryData->_type);
+		   it != collectionLayouts.end()) {
+		layoutString = obs_module_text(it->second.c_str());
 	} else {
 		layoutString = obs_module_text(
 			"AdvSceneSwitcher.action.variable.entry.other");
@@ -1316,7 +1564,11 @@ void MacroActionVariableEdit::SetWidgetVisibility()
 	    _entryData->_type == MacroActionVariable::Type::MATH_EXPRESSION ||
 	    _entryData->_type == MacroActionVariable::Type::ENV_VARIABLE ||
 	    _entryData->_type == MacroActionVariable::Type::STRING_LENGTH ||
-	    _entryData->_type == MacroActionVariable::Type::EXTRACT_JSON) {
+	    _entryData->_type == MacroActionVariable::Type::EXTRACT_JSON ||
+	    _entryData->_type == MacroActionVariable::Type::LIST_PUSH ||
+	    _entryData->_type == MacroActionVariable::Type::LIST_SET ||
+	    _entryData->_type == MacroActionVariable::Type::MAP_SET ||
+	    _entryData->_type == MacroActionVariable::Type::CONTAINS) {
 		RemoveStretchIfPresent(_entryLayout);
 	} else {
 		AddStretchIfNecessary(_entryLayout);
@@ -1324,13 +1576,25 @@ void MacroActionVariableEdit::SetWidgetVisibility()
 
 	_variables2->setVisible(
 		_entryData->_type == MacroActionVariable::Type::APPEND_VAR ||
-		_entryData->_type == MacroActionVariable::Type::SWAP_VALUES);
+		_entryData->_type == MacroActionVariable::Type::SWAP_VALUES ||
+		_entryData->_type ==
+			MacroActionVariable::Type::LIST_POP_FRONT ||
+		_entryData->_type == MacroActionVariable::Type::LIST_POP_BACK ||
+		_entryData->_type == MacroActionVariable::Type::LIST_GET ||
+		_entryData->_type == MacroActionVariable::Type::MAP_GET ||
+		_entryData->_type == MacroActionVariable::Type::CONTAINS ||
+		_entryData->_type == MacroActionVariable::Type::SIZE ||
+		_entryData->_type == MacroActionVariable::Type::FOR_EACH);
 	_strValue->setVisible(
 		_entryData->_type ==
 			MacroActionVariable::Type::SET_FIXED_VALUE ||
 		_entryData->_type == MacroActionVariable::Type::APPEND ||
 		_entryData->_type == MacroActionVariable::Type::STRING_LENGTH ||
-		_entryData->_type == MacroActionVariable::Type::EXTRACT_JSON);
+		_entryData->_type == MacroActionVariable::Type::EXTRACT_JSON ||
+		_entryData->_type == MacroActionVariable::Type::LIST_PUSH ||
+		_entryData->_type == MacroActionVariable::Type::LIST_SET ||
+		_entryData->_type == MacroActionVariable::Type::MAP_SET ||
+		_entryData->_type == MacroActionVariable::Type::CONTAINS);
 	_numValue->setVisible(
 		_entryData->_type == MacroActionVariable::Type::INCREMENT ||
 		_entryData->_type == MacroActionVariable::Type::DECREMENT);
@@ -1414,6 +1678,15 @@ void MacroActionVariableEdit::SetWidgetVisibility()
 		_entryData->_type == MacroActionVariable::Type::TRUNCATE);
 	_paddingCharSelection->setVisible(_entryData->_type ==
 					  MacroActionVariable::Type::PAD);
+	_listIndex->setVisible(
+		_entryData->_type == MacroActionVariable::Type::LIST_GET ||
+		_entryData->_type == MacroActionVariable::Type::LIST_SET);
+	_mapKey->setVisible(
+		_entryData->_type == MacroActionVariable::Type::MAP_SET ||
+		_entryData->_type == MacroActionVariable::Type::MAP_GET ||
+		_entryData->_type == MacroActionVariable::Type::MAP_REMOVE);
+	_iterationMacro->setVisible(_entryData->_type ==
+				    MacroActionVariable::Type::FOR_EACH);
 	adjustSize();
 	updateGeometry();
 }
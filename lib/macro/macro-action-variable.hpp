@@ -1,7 +1,9 @@
 #pragma once
 #include "macro-action-edit.hpp"
 #include "help-icon.hpp"
+#include "macro-ref.hpp"
 #include "macro-segment-selection.hpp"
+#include "macro-selection.hpp"
 #include "regex-config.hpp"
 #include "resizing-text-edit.hpp"
 #include "scene-selection.hpp"
@@ -50,6 +52,17 @@ public:
 		PAD,
 		TRUNCATE,
 		SWAP_VALUES,
+		LIST_PUSH,
+		LIST_POP_FRONT,
+		LIST_POP_BACK,
+		LIST_GET,
+		LIST_SET,
+		MAP_SET,
+		MAP_GET,
+		MAP_REMOVE,
+		CONTAINS,
+		SIZE,
+		FOR_EACH,
 	};
 
 	Type _type = Type::SET_FIXED_VALUE;
@@ -88,6 +101,9 @@ public:
 	Direction _direction = Direction::LEFT;
 	IntVariable _stringLength = 1;
 	char _paddingChar = '0';
+	IntVariable _listIndex = 1;
+	StringVariable _mapKey = "";
+	MacroRef _iterationMacro;
 
 private:
 	void DecrementCurrentSegmentVariableRef();
@@ -96,6 +112,8 @@ private:
 	void HandleFindAndReplace(Variable *);
 	void HandleMathExpression(Variable *);
 	void SetToSceneItemName(Variable *);
+	void HandleCollectionOperation(Variable *);
+	bool IterateElements(Variable *);
 
 	std::weak_ptr<MacroSegment> _macroSegment;
 	int _segmentIdxLoadValue = -1;
@@ -148,6 +166,9 @@ private slots:
 	void DirectionChanged(int);
 	void StringLengthChanged(const NumberVariable<int> &);
 	void CharSelectionChanged(const QString &);
+	void ListIndexChanged(const NumberVariable<int> &);
+	void MapKeyChanged();
+	void IterationMacroChanged(const QString &);
 
 signals:
 	void HeaderInfoChanged(const QString &);
@@ -192,6 +213,9 @@ private:
 	QComboBox *_direction;
 	VariableSpinBox *_stringLength;
 	SingleCharSelection *_paddingCharSelection;
+	VariableSpinBox *_listIndex;
+	VariableLineEdit *_mapKey;
+	MacroSelection *_iterationMacro;
 	QHBoxLayout *_entryLayout;
 
 	std::shared_ptr<MacroActionVariable> _entryData;
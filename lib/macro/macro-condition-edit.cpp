@@ -223,6 +223,7 @@ void MacroConditionEdit::ConditionSelectionChanged(const QString &text)
 		(*_entryData)->SetIndex(idx);
 		(*_entryData)->SetLogicType(logic);
 		(*_entryData)->PostLoad();
+		macro->InvalidateConditionPlan();
 		RunPostLoadSteps();
 	}
 	auto widget =
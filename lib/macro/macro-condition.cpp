@@ -1,7 +1,15 @@
 #include "macro-condition.hpp"
+#include "macro.hpp"
 
 namespace advss {
 
+static void invalidateConditionPlan(Macro *macro)
+{
+	if (macro) {
+		macro->InvalidateConditionPlan();
+	}
+}
+
 MacroCondition::MacroCondition(Macro *m, bool supportsVariableValue)
 	: MacroSegment(m, supportsVariableValue)
 {
@@ -20,10 +28,35 @@ bool MacroCondition::Load(obs_data_t *obj)
 {
 	MacroSegment::Load(obj);
 	_logic.Load(obj, "logic");
+	invalidateConditionPlan(GetMacro());
 	_durationModifier.Load(obj);
 	return true;
 }
 
+void MacroCondition::SetLogicType(const Logic::Type &logic)
+{
+	_logic.SetType(logic);
+	invalidateConditionPlan(GetMacro());
+}
+
+void MacroCondition::TraceTriggerEvent(
+	const char *source, std::chrono::steady_clock::time_point arrival)
+{
+	if (!MacroTracingEnabled()) {
+		return;
+	}
+	if (!_traceEvent || arrival < _traceEvent->time) {
+		_traceEvent = MacroTraceEvent{source, arrival};
+	}
+}
+
+std::optional<MacroTraceEvent> MacroCondition::ConsumeTraceEvent()
+{
+	auto event = std::move(_traceEvent);
+	_traceEvent.reset();
+	return event;
+}
+
 void MacroCondition::ValidateLogicSelection(bool isRootCondition,
 					    const char *context)
 {
@@ -32,14 +65,14 @@ void MacroCondition::ValidateLogicSelection(bool isRootCondition,
 	}
 
 	if (_logic.IsRootType()) {
-		_logic.SetType(Logic::Type::ROOT_NONE);
+		SetLogicType(Logic::Type::ROOT_NONE);
 		blog(LOG_WARNING,
 		     "setting invalid logic selection to 'if' for macro %s",
 		     context);
 		return;
 	}
 
-	_logic.SetType(Logic::Type::NONE);
+	SetLogicType(Logic::Type::NONE);
 	blog(LOG_WARNING,
 	     "setting invalid logic selection to 'ignore' for macro %s",
 	     context);
@@ -3,6 +3,7 @@
 #include "condition-logic.hpp"
 #include "duration-modifier.hpp"
 #include "macro-ref.hpp"
+#include "macro-trace.hpp"
 
 namespace advss {
 
@@ -15,7 +16,7 @@ public:
 	virtual bool Load(obs_data_t *obj) = 0;
 
 	Logic::Type GetLogicType() const { return _logic.GetType(); }
-	void SetLogicType(const Logic::Type &logic) { _logic.SetType(logic); }
+	void SetLogicType(const Logic::Type &logic);
 
 	void ValidateLogicSelection(bool isRootCondition, const char *context);
 
@@ -26,11 +27,20 @@ public:
 	void ResetDuration();
 	bool CheckDurationModifier(bool conditionValue);
 
+	// Has to be called from CheckCondition() with the arrival time of
+	// events received from outside of the plugin, so the latency of the
+	// macro run triggered by them can be traced.
+	// Only the oldest event since the last evaluation is kept.
+	void TraceTriggerEvent(const char *source,
+			       std::chrono::steady_clock::time_point arrival);
+	std::optional<MacroTraceEvent> ConsumeTraceEvent();
+
 	static std::string_view GetDefaultID();
 
 private:
 	Logic _logic = Logic(Logic::Type::ROOT_NONE);
 	DurationModifier _durationModifier;
+	std::optional<MacroTraceEvent> _traceEvent;
 };
 
 class EXPORT MacroRefCondition : virtual public MacroCondition {
@@ -1,10 +1,12 @@
 #include "macro-export-import-dialog.hpp"
 #include "obs-module-helper.hpp"
+#include "path-helpers.hpp"
 
 #include <obs.hpp>
 #include <QLayout>
 #include <QLabel>
 #include <QDialogButtonBox>
+#include <QFileDialog>
 
 namespace advss {
 
@@ -14,7 +16,9 @@ MacroExportImportDialog::MacroExportImportDialog(Type type)
 	: QDialog(nullptr),
 	  _importExportString(new QPlainTextEdit(this)),
 	  _usePlainText(new QCheckBox(obs_module_text(
-		  "AdvSceneSwitcher.macroTab.export.usePlainText")))
+		  "AdvSceneSwitcher.macroTab.export.usePlainText"))),
+	  _importFromFile(new QPushButton(
+		  obs_module_text("AdvSceneSwitcher.macroTab.import.file")))
 {
 	_importExportString->setReadOnly(type == Type::EXPORT_MACRO);
 	auto label = new QLabel(obs_module_text(
@@ -39,10 +43,15 @@ MacroExportImportDialog::MacroExportImportDialog(Type type)
 	connect(_usePlainText, &QCheckBox::stateChanged, this,
 		&MacroExportImportDialog::UsePlainTextChanged);
 
+	_importFromFile->setVisible(type == Type::IMPORT_MACRO);
+	connect(_importFromFile, &QPushButton::clicked, this,
+		&MacroExportImportDialog::ImportFromFileClicked);
+
 	auto layout = new QVBoxLayout;
 	layout->addWidget(label);
 	layout->addWidget(_importExportString);
 	layout->addWidget(_usePlainText);
+	layout->addWidget(_importFromFile);
 	layout->addWidget(buttons);
 	setLayout(layout);
 
@@ -90,6 +99,29 @@ void MacroExportImportDialog::UsePlainTextChanged(int value)
 	usePlainText = value;
 }
 
+void MacroExportImportDialog::ImportFromFileClicked()
+{
+	const auto path = QFileDialog::getOpenFileName(
+		this,
+		obs_module_text("AdvSceneSwitcher.macroTab.import.file.title"),
+		GetDefaultSettingsSaveLocation(),
+		obs_module_text("AdvSceneSwitcher.macroTab.export.file.type"));
+	if (path.isEmpty()) {
+		return;
+	}
+	_filePath = path;
+	accept();
+}
+
+QString MacroExportImportDialog::GetExportFilePath(QWidget *parent)
+{
+	return QFileDialog::getSaveFileName(
+		parent,
+		obs_module_text("AdvSceneSwitcher.macroTab.export.file.title"),
+		GetDefaultSettingsSaveLocation(),
+		obs_module_text("AdvSceneSwitcher.macroTab.export.file.type"));
+}
+
 static bool isValidData(const QString &json)
 {
 	OBSDataAutoRelease data =
@@ -97,11 +129,15 @@ static bool isValidData(const QString &json)
 	return !!data;
 }
 
-bool MacroExportImportDialog::ImportMacros(QString &json)
+bool MacroExportImportDialog::ImportMacros(QString &json, QString &filePath)
 {
 	MacroExportImportDialog dialog(
 		MacroExportImportDialog::Type::IMPORT_MACRO);
 	if (dialog.exec() == QDialog::Accepted) {
+		if (!dialog._filePath.isEmpty()) {
+			filePath = dialog._filePath;
+			return true;
+		}
 		json = decompressMacroString(
 			dialog._importExportString->toPlainText());
 		if (!isValidData(json)) { // Fallback to support raw json format
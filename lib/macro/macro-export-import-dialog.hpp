@@ -2,6 +2,7 @@
 #include <QCheckBox>
 #include <QDialog>
 #include <QPlainTextEdit>
+#include <QPushButton>
 
 namespace advss {
 
@@ -12,14 +13,21 @@ public:
 	MacroExportImportDialog(Type type);
 
 	static void ExportMacros(const QString &json);
-	static bool ImportMacros(QString &json);
+	// Either sets json to the pasted import string or filePath to the
+	// selected macro export file
+	static bool ImportMacros(QString &json, QString &filePath);
+
+	static QString GetExportFilePath(QWidget *parent);
 
 private slots:
 	void UsePlainTextChanged(int);
+	void ImportFromFileClicked();
 
 private:
 	QPlainTextEdit *_importExportString;
 	QCheckBox *_usePlainText;
+	QPushButton *_importFromFile;
+	QString _filePath;
 };
 
 } // namespace advss
@@ -0,0 +1,111 @@
+#include "macro-export-stream.hpp"
+
+#include <QtEndian>
+
+namespace advss {
+
+static const QByteArray fileMagic("ADVSSMX1");
+static constexpr int chunkSizeBytes = 4;
+// Guards against allocating huge buffers when reading corrupt files
+static constexpr quint32 maxChunkSize = 256 * 1024 * 1024;
+
+static bool writeChunkSize(QFile &file, quint32 size)
+{
+	uchar buffer[chunkSizeBytes];
+	qToBigEndian(size, buffer);
+	return file.write(reinterpret_cast<const char *>(buffer),
+			  chunkSizeBytes) == chunkSizeBytes;
+}
+
+MacroExportWriter::MacroExportWriter(const QString &path) : _file(path)
+{
+	if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		return;
+	}
+	if (_file.write(fileMagic) != fileMagic.size()) {
+		_file.close();
+	}
+}
+
+bool MacroExportWriter::WriteChunk(const QByteArray &data)
+{
+	// Empty chunks are reserved for the end marker
+	if (!IsOpen() || data.isEmpty()) {
+		return false;
+	}
+
+	const auto compressed = qCompress(data);
+	return writeChunkSize(_file, compressed.size()) &&
+	       _file.write(compressed) == compressed.size();
+}
+
+bool MacroExportWriter::Finish()
+{
+	if (!IsOpen()) {
+		return false;
+	}
+	const bool success = writeChunkSize(_file, 0) && _file.flush();
+	_file.close();
+	return success;
+}
+
+void MacroExportWriter::Discard()
+{
+	_file.close();
+	_file.remove();
+}
+
+MacroImportReader::MacroImportReader(const QString &path) : _file(path)
+{
+	if (!_file.open(QIODevice::ReadOnly)) {
+		return;
+	}
+	_isOpen = _file.read(fileMagic.size()) == fileMagic;
+}
+
+bool MacroImportReader::ReadChunk(QByteArray &data)
+{
+	if (!_isOpen || _done || _failed) {
+		return false;
+	}
+
+	uchar buffer[chunkSizeBytes];
+	if (_file.read(reinterpret_cast<char *>(buffer), chunkSizeBytes) !=
+	    chunkSizeBytes) {
+		_failed = true;
+		return false;
+	}
+
+	const auto size = qFromBigEndian<quint32>(buffer);
+	if (size == 0) {
+		_done = true;
+		return false;
+	}
+	if (size > maxChunkSize) {
+		_failed = true;
+		return false;
+	}
+
+	const auto compressed = _file.read(size);
+	if (compressed.size() != (qint64)size) {
+		_failed = true;
+		return false;
+	}
+
+	data = qUncompress(compressed);
+	if (data.isEmpty()) {
+		_failed = true;
+		return false;
+	}
+	return true;
+}
+
+int MacroImportReader::Progress() const
+{
+	if (!_isOpen || _done || _file.size() == 0) {
+		return 100;
+	}
+	return static_cast<int>(_file.pos() * 100 / _file.size());
+}
+
+} // namespace advss
@@ -0,0 +1,44 @@
+#pragma once
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+namespace advss {
+
+// Macro export files consist of a short header followed by a sequence of
+// chunks, which are compressed individually.
+// This way neither exporting nor importing large macro selections requires
+// the whole export to be kept in memory as a single string.
+class MacroExportWriter {
+public:
+	MacroExportWriter(const QString &path);
+	bool IsOpen() const { return _file.isOpen(); }
+	bool WriteChunk(const QByteArray &data);
+	// Has to be called after the last chunk was written, as files without
+	// the end marker are treated as truncated when importing them
+	bool Finish();
+	// Removes the partially written file
+	void Discard();
+
+private:
+	QFile _file;
+};
+
+class MacroImportReader {
+public:
+	MacroImportReader(const QString &path);
+	bool IsOpen() const { return _isOpen; }
+	// Returns false once all chunks were read or if the file is corrupt
+	bool ReadChunk(QByteArray &data);
+	bool Failed() const { return _failed; }
+	// Percentage of the file which was read already
+	int Progress() const;
+
+private:
+	QFile _file;
+	bool _isOpen = false;
+	bool _done = false;
+	bool _failed = false;
+};
+
+} // namespace advss
@@ -96,6 +96,9 @@ void MacroSegment::SetupTempVars()
 void MacroSegment::ClearAvailableTempvars()
 {
 	_tempVariables.clear();
+	if (_macro) {
+		_macro->InvalidateTempVarScope();
+	}
 	NotifyUIAboutTempVarChange();
 }
 
@@ -138,6 +141,7 @@ void MacroSegment::AddTempvar(const std::string &id, const std::string &name,
 
 	TempVariable var(id, name, description, sharedSegment);
 	_tempVariables.emplace_back(std::move(var));
+	macro->InvalidateTempVarScope();
 	NotifyUIAboutTempVarChange();
 }
 
@@ -20,6 +20,7 @@ void GlobalMacroSettings::Save(obs_data_t *obj) const
 	obs_data_set_bool(data, "highlightActions", _highlightActions);
 	obs_data_set_bool(data, "newMacroRegisterHotkey",
 			  _newMacroRegisterHotkeys);
+	obs_data_set_bool(data, "concurrentRunPhase", _concurrentRunPhase);
 	obs_data_set_obj(obj, "macroSettings", data);
 	obs_data_release(data);
 }
@@ -38,6 +39,7 @@ void GlobalMacroSettings::Load(obs_data_t *obj)
 	_highlightActions = obs_data_get_bool(data, "highlightActions");
 	_newMacroRegisterHotkeys =
 		obs_data_get_bool(data, "newMacroRegisterHotkey");
+	_concurrentRunPhase = obs_data_get_bool(data, "concurrentRunPhase");
 	obs_data_release(data);
 }
 
@@ -53,12 +55,16 @@ MacroSettingsDialog::MacroSettingsDialog(QWidget *parent,
 		  "AdvSceneSwitcher.macroTab.highlightPerformedActions"))),
 	  _newMacroRegisterHotkeys(new QCheckBox(obs_module_text(
 		  "AdvSceneSwitcher.macroTab.newMacroRegisterHotkey"))),
+	  _concurrentRunPhase(new QCheckBox(obs_module_text(
+		  "AdvSceneSwitcher.macroTab.concurrentRunPhase"))),
 	  _currentMacroRegisterHotkeys(new QCheckBox(obs_module_text(
 		  "AdvSceneSwitcher.macroTab.currentDisableHotkeys"))),
 	  _currentSkipOnStartup(new QCheckBox(obs_module_text(
 		  "AdvSceneSwitcher.macroTab.currentSkipExecutionOnStartup"))),
 	  _currentStopActionsIfNotDone(new QCheckBox(obs_module_text(
 		  "AdvSceneSwitcher.macroTab.currentStopActionsIfNotDone"))),
+	  _currentRunExclusive(new QCheckBox(obs_module_text(
+		  "AdvSceneSwitcher.macroTab.currentRunExclusive"))),
 	  _currentInputs(new MacroInputSelection()),
 	  _currentMacroRegisterDock(new QCheckBox(obs_module_text(
 		  "AdvSceneSwitcher.macroTab.currentRegisterDock"))),
@@ -98,6 +104,13 @@ MacroSettingsDialog::MacroSettingsDialog(QWidget *parent,
 	hotkeyLayout->addWidget(_currentMacroRegisterHotkeys);
 	hotkeyOptions->setLayout(hotkeyLayout);
 
+	auto executionOptions = new QGroupBox(
+		obs_module_text("AdvSceneSwitcher.macroTab.executionSettings"));
+	auto executionLayout = new QVBoxLayout;
+	executionLayout->addWidget(_concurrentRunPhase);
+	executionLayout->addWidget(_currentRunExclusive);
+	executionOptions->setLayout(executionLayout);
+
 	auto generalOptions = new QGroupBox(
 		obs_module_text("AdvSceneSwitcher.macroTab.generalSettings"));
 	auto generalLayout = new QVBoxLayout;
@@ -188,6 +201,7 @@ MacroSettingsDialog::MacroSettingsDialog(QWidget *parent,
 	layout->addWidget(highlightOptions);
 	layout->addWidget(hotkeyOptions);
 	layout->addWidget(generalOptions);
+	layout->addWidget(executionOptions);
 	layout->addWidget(inputOptions);
 	layout->addWidget(_dockOptions);
 	layout->setContentsMargins(0, 0, 0, 0);
@@ -202,8 +216,10 @@ MacroSettingsDialog::MacroSettingsDialog(QWidget *parent,
 	_conditions->setChecked(settings._highlightConditions);
 	_actions->setChecked(settings._highlightActions);
 	_newMacroRegisterHotkeys->setChecked(settings._newMacroRegisterHotkeys);
+	_concurrentRunPhase->setChecked(settings._concurrentRunPhase);
 
 	if (!macro || macro->IsGroup()) {
+		_currentRunExclusive->hide();
 		hotkeyOptions->hide();
 		generalOptions->hide();
 		inputOptions->hide();
@@ -214,6 +230,7 @@ MacroSettingsDialog::MacroSettingsDialog(QWidget *parent,
 	_currentMacroRegisterHotkeys->setChecked(macro->PauseHotkeysEnabled());
 	_currentSkipOnStartup->setChecked(macro->SkipExecOnStart());
 	_currentStopActionsIfNotDone->setChecked(macro->StopActionsIfNotDone());
+	_currentRunExclusive->setChecked(macro->RunExclusive());
 	_currentInputs->SetInputs(macro->GetInputVariables());
 	const bool dockEnabled = macro->DockEnabled();
 	_currentMacroRegisterDock->setChecked(dockEnabled);
@@ -327,6 +344,7 @@ bool MacroSettingsDialog::AskForSettings(QWidget *parent,
 	userInput._highlightActions = dialog._actions->isChecked();
 	userInput._newMacroRegisterHotkeys =
 		dialog._newMacroRegisterHotkeys->isChecked();
+	userInput._concurrentRunPhase = dialog._concurrentRunPhase->isChecked();
 	if (!macro) {
 		return true;
 	}
@@ -336,6 +354,7 @@ bool MacroSettingsDialog::AskForSettings(QWidget *parent,
 	macro->SetSkipExecOnStart(dialog._currentSkipOnStartup->isChecked());
 	macro->SetStopActionsIfNotDone(
 		dialog._currentStopActionsIfNotDone->isChecked());
+	macro->SetRunExclusive(dialog._currentRunExclusive->isChecked());
 	macro->EnableDock(dialog._currentMacroRegisterDock->isChecked());
 	macro->SetDockHasRunButton(
 		dialog._currentMacroDockAddRunButton->isChecked());
@@ -23,6 +23,9 @@ public:
 	bool _highlightConditions = false;
 	bool _highlightActions = false;
 	bool _newMacroRegisterHotkeys = true;
+	// Run actions of different macros on separate execution lanes instead
+	// of one after another on the main thread
+	bool _concurrentRunPhase = false;
 };
 
 // Dialog for configuring global and individual macro specific settings
@@ -48,10 +51,12 @@ private:
 	QCheckBox *_conditions;
 	QCheckBox *_actions;
 	QCheckBox *_newMacroRegisterHotkeys;
+	QCheckBox *_concurrentRunPhase;
 	// Current macro specific settings
 	QCheckBox *_currentMacroRegisterHotkeys;
 	QCheckBox *_currentSkipOnStartup;
 	QCheckBox *_currentStopActionsIfNotDone;
+	QCheckBox *_currentRunExclusive;
 	MacroInputSelection *_currentInputs;
 	QCheckBox *_currentMacroRegisterDock;
 	QCheckBox *_currentMacroDockAddRunButton;
@@ -4,6 +4,7 @@
 #include "macro-action-edit.hpp"
 #include "macro-condition-edit.hpp"
 #include "macro-export-import-dialog.hpp"
+#include "macro-export-stream.hpp"
 #include "macro-settings.hpp"
 #include "macro-segment-copy-paste.hpp"
 #include "macro-tree.hpp"
@@ -20,6 +21,7 @@
 #include <QColor>
 #include <QGraphicsOpacityEffect>
 #include <QMenu>
+#include <QProgressDialog>
 #include <QPropertyAnimation>
 
 namespace advss {
@@ -256,6 +258,70 @@ static void addGroupSubitems(std::vector<std::shared_ptr<Macro>> &macros,
 	macros.insert(it, subitems.begin(), subitems.end());
 }
 
+// Larger selections are only exported to a file, as the export string would
+// become too large to be handled by the export dialog
+static constexpr size_t maxMacrosForTextExport = 100;
+static constexpr size_t macrosPerExportChunk = 25;
+
+static void saveExportHeader(obs_data_t *data)
+{
+	SaveVariables(data);
+	SaveActionQueues(data);
+	obs_data_set_string(data, "version", g_GIT_TAG);
+}
+
+static bool
+exportMacrosToFile(QWidget *parent,
+		   const std::vector<std::shared_ptr<Macro>> &macros)
+{
+	const auto path = MacroExportImportDialog::GetExportFilePath(parent);
+	if (path.isEmpty()) {
+		return true;
+	}
+
+	MacroExportWriter writer(path);
+	if (!writer.IsOpen()) {
+		return false;
+	}
+
+	QProgressDialog progress(parent);
+	progress.setLabelText(
+		obs_module_text("AdvSceneSwitcher.macroTab.export.progress"));
+	progress.setRange(0, (int)macros.size());
+	progress.setWindowModality(Qt::WindowModal);
+
+	OBSDataAutoRelease header = obs_data_create();
+	saveExportHeader(header);
+	bool success = writer.WriteChunk(obs_data_get_json(header));
+
+	for (size_t i = 0; success && i < macros.size();
+	     i += macrosPerExportChunk) {
+		if (progress.wasCanceled()) {
+			writer.Discard();
+			return true;
+		}
+
+		const auto end = std::min(i + macrosPerExportChunk,
+					  macros.size());
+		OBSDataAutoRelease chunk = obs_data_create();
+		OBSDataArrayAutoRelease macroArray = obs_data_array_create();
+		for (size_t j = i; j < end; j++) {
+			OBSDataAutoRelease obj = obs_data_create();
+			macros[j]->Save(obj);
+			obs_data_array_push_back(macroArray, obj);
+		}
+		obs_data_set_array(chunk, "macros", macroArray);
+		success = writer.WriteChunk(obs_data_get_json(chunk));
+		progress.setValue((int)end);
+	}
+
+	if (!success || !writer.Finish()) {
+		writer.Discard();
+		return false;
+	}
+	return true;
+}
+
 void AdvSceneSwitcher::ExportMacros()
 {
 	auto selectedMacros = GetSelectedMacros();
@@ -266,6 +332,14 @@ void AdvSceneSwitcher::ExportMacros()
 		}
 	}
 
+	if (macros.size() > maxMacrosForTextExport) {
+		if (!exportMacrosToFile(this, macros)) {
+			DisplayMessage(obs_module_text(
+				"AdvSceneSwitcher.macroTab.export.file.fail"));
+		}
+		return;
+	}
+
 	OBSDataAutoRelease data = obs_data_create();
 	OBSDataArrayAutoRelease macroArray = obs_data_array_create();
 	for (const auto &macro : macros) {
@@ -274,9 +348,7 @@ void AdvSceneSwitcher::ExportMacros()
 		obs_data_array_push_back(macroArray, obj);
 	}
 	obs_data_set_array(data, "macros", macroArray);
-	SaveVariables(data);
-	SaveActionQueues(data);
-	obs_data_set_string(data, "version", g_GIT_TAG);
+	saveExportHeader(data);
 	auto json = obs_data_get_json(data);
 	QString exportString(json);
 
@@ -399,20 +471,8 @@ bool AdvSceneSwitcher::ResolveMacroImportNameConflict(
 	return true;
 }
 
-void AdvSceneSwitcher::ImportMacros()
+static void importExportHeader(obs_data_t *data)
 {
-	QString json;
-	if (!MacroExportImportDialog::ImportMacros(json)) {
-		return;
-	}
-	OBSDataAutoRelease data =
-		obs_data_create_from_json(json.toStdString().c_str());
-	if (!data) {
-		DisplayMessage(obs_module_text(
-			"AdvSceneSwitcher.macroTab.import.invalid"));
-		ImportMacros();
-		return;
-	}
 	ImportVariables(data);
 	ImportQueues(data);
 
@@ -422,49 +482,184 @@ void AdvSceneSwitcher::ImportMacros()
 		     "importing macros from non matching plugin version \"%s\"",
 		     version);
 	}
+}
 
-	OBSDataArrayAutoRelease array = obs_data_get_array(data, "macros");
-	size_t count = obs_data_array_count(array);
+namespace {
 
-	int groupSize = 0;
+struct MacroImport {
+	std::vector<std::shared_ptr<Macro>> macros;
 	std::shared_ptr<Macro> group;
-	std::vector<std::shared_ptr<Macro>> importedMacros;
+	int groupSize = 0;
+};
 
-	auto lock = LockContext();
+} // namespace
+
+static bool isImportedMacroName(const MacroImport &import,
+				const std::string &name)
+{
+	return std::any_of(import.macros.begin(), import.macros.end(),
+			   [&name](const std::shared_ptr<Macro> &macro) {
+				   return macro->Name() == name;
+			   });
+}
+
+// The imported macros are only added to the macro list once all of them were
+// loaded, so the macros are never run before PostLoad() was called for them
+static void importMacroArray(
+	obs_data_array_t *array, MacroImport &import,
+	const std::function<bool(std::shared_ptr<Macro> &)> &resolveNameConflict)
+{
+	size_t count = obs_data_array_count(array);
 	for (size_t i = 0; i < count; i++) {
 		OBSDataAutoRelease array_obj = obs_data_array_item(array, i);
 		auto macro = std::make_shared<Macro>();
 		macro->Load(array_obj);
 		RunPostLoadSteps();
 
-		if (macroNameExists(macro->Name()) &&
-		    !ResolveMacroImportNameConflict(macro)) {
-			groupSize--;
+		bool skip = false;
+		while (macroNameExists(macro->Name()) ||
+		       isImportedMacroName(import, macro->Name())) {
+			if (!resolveNameConflict(macro)) {
+				skip = true;
+				break;
+			}
+		}
+		if (skip) {
+			import.groupSize--;
 			continue;
 		}
 
-		importedMacros.emplace_back(macro);
-		GetMacros().emplace_back(macro);
-		if (groupSize > 0 && !macro->IsGroup()) {
-			Macro::PrepareMoveToGroup(group, macro);
-			groupSize--;
+		import.macros.emplace_back(macro);
+		if (import.groupSize > 0 && !macro->IsGroup()) {
+			Macro::PrepareMoveToGroup(import.group, macro);
+			import.groupSize--;
 		}
 
 		if (macro->IsGroup()) {
-			group = macro;
-			groupSize = macro->GroupSize();
+			import.group = macro;
+			import.groupSize = macro->GroupSize();
 			// We are not sure if all elements will be added so we
 			// have to reset the group size to zero and add elements
 			// to the group as they come up.
 			macro->ResetGroupSize();
 		}
 	}
+}
 
-	for (const auto &macro : importedMacros) {
+static void finishMacroImport(const MacroImport &import)
+{
+	auto &macros = GetMacros();
+	macros.insert(macros.end(), import.macros.begin(), import.macros.end());
+	for (const auto &macro : import.macros) {
 		macro->PostLoad();
 	}
 	RunPostLoadSteps();
+}
 
+void AdvSceneSwitcher::ImportMacros()
+{
+	QString json, filePath;
+	if (!MacroExportImportDialog::ImportMacros(json, filePath)) {
+		return;
+	}
+	if (!filePath.isEmpty()) {
+		ImportMacrosFromFile(filePath);
+		return;
+	}
+
+	OBSDataAutoRelease data =
+		obs_data_create_from_json(json.toStdString().c_str());
+	if (!data) {
+		DisplayMessage(obs_module_text(
+			"AdvSceneSwitcher.macroTab.import.invalid"));
+		ImportMacros();
+		return;
+	}
+	importExportHeader(data);
+
+	OBSDataArrayAutoRelease array = obs_data_get_array(data, "macros");
+	MacroImport import;
+	auto resolveNameConflict = [this](std::shared_ptr<Macro> &macro) {
+		return ResolveMacroImportNameConflict(macro);
+	};
+
+	auto lock = LockContext();
+	importMacroArray(array, import, resolveNameConflict);
+	finishMacroImport(import);
+
+	ui->macros->Reset(GetMacros(),
+			  GetGlobalMacroSettings()._highlightExecuted);
+}
+
+void AdvSceneSwitcher::ImportMacrosFromFile(const QString &path)
+{
+	MacroImportReader reader(path);
+	QByteArray chunk;
+	OBSDataAutoRelease header;
+	if (reader.ReadChunk(chunk)) {
+		header = obs_data_create_from_json(chunk.constData());
+	}
+	if (!header) {
+		DisplayMessage(obs_module_text(
+			"AdvSceneSwitcher.macroTab.import.invalid"));
+		return;
+	}
+
+	QProgressDialog progress(this);
+	progress.setLabelText(
+		obs_module_text("AdvSceneSwitcher.macroTab.import.progress"));
+	progress.setRange(0, 200);
+	progress.setWindowModality(Qt::WindowModal);
+
+	// Nothing is applied unless the whole file could be read
+	bool invalidChunk = false;
+	std::vector<OBSDataArrayAutoRelease> chunks;
+	while (!progress.wasCanceled() && reader.ReadChunk(chunk)) {
+		OBSDataAutoRelease data =
+			obs_data_create_from_json(chunk.constData());
+		if (!data) {
+			invalidChunk = true;
+			break;
+		}
+		chunks.emplace_back(obs_data_get_array(data, "macros"));
+		progress.setValue(reader.Progress());
+	}
+
+	if (progress.wasCanceled()) {
+		return;
+	}
+
+	if (invalidChunk || reader.Failed()) {
+		progress.reset();
+		DisplayMessage(obs_module_text(
+			"AdvSceneSwitcher.macroTab.import.invalid"));
+		return;
+	}
+
+	// The variables have to be imported before the macros are loaded as
+	// variable selections are resolved on load
+	importExportHeader(header);
+
+	MacroImport import;
+	auto resolveNameConflict = [this](std::shared_ptr<Macro> &macro) {
+		return ResolveMacroImportNameConflict(macro);
+	};
+
+	// The lock is only held while processing a single chunk to keep the
+	// plugin responsive while importing
+	progress.setCancelButton(nullptr);
+	for (size_t i = 0; i < chunks.size(); i++) {
+		{
+			auto lock = LockContext();
+			importMacroArray(chunks[i], import,
+					 resolveNameConflict);
+		}
+		progress.setValue(100 + int((i + 1) * 100 / chunks.size()));
+	}
+	progress.reset();
+
+	auto lock = LockContext();
+	finishMacroImport(import);
 	ui->macros->Reset(GetMacros(),
 			  GetGlobalMacroSettings()._highlightExecuted);
 }
@@ -0,0 +1,221 @@
+#include "macro-trace.hpp"
+#include "log-helper.hpp"
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <unordered_map>
+
+namespace advss {
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct MacroTraceRecord {
+	std::string macro;
+	MacroTraceContext context;
+	Clock::time_point executionStart;
+	Clock::time_point executionEnd;
+};
+
+struct MacroTraceStats {
+	std::array<LatencyHistogram, static_cast<size_t>(MacroTraceStage::COUNT)>
+		histograms;
+	// Used as the thread id in the trace event output so each macro is
+	// displayed in a separate lane
+	int lane = 0;
+};
+
+} // namespace
+
+// Limit the amount of memory used if tracing is left enabled for a long time
+static constexpr size_t maxTraceRecords = 10000;
+
+static std::atomic_bool tracingEnabled = {false};
+
+static std::mutex traceMutex;
+static std::deque<MacroTraceRecord> traceRecords;
+static std::unordered_map<std::string, MacroTraceStats> traceStats;
+static Clock::time_point traceStartTime = Clock::now();
+
+static const char *stageNames[] = {"queueing", "evaluation", "dispatch",
+				   "execution"};
+
+void EnableMacroTracing(bool enable)
+{
+	tracingEnabled = enable;
+}
+
+bool MacroTracingEnabled()
+{
+	return tracingEnabled;
+}
+
+static std::chrono::microseconds toMicroseconds(Clock::duration duration)
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(duration);
+}
+
+void RecordMacroTrace(const std::string &macro,
+		      const MacroTraceContext &context,
+		      Clock::time_point executionStart,
+		      Clock::time_point executionEnd)
+{
+	if (!tracingEnabled) {
+		return;
+	}
+
+	const std::array<Clock::duration,
+			 static_cast<size_t>(MacroTraceStage::COUNT)>
+		durations = {
+			context.evaluationStart - context.event.time,
+			context.evaluationEnd - context.evaluationStart,
+			executionStart - context.evaluationEnd,
+			executionEnd - executionStart,
+		};
+
+	std::lock_guard<std::mutex> lock(traceMutex);
+	auto it = traceStats.find(macro);
+	if (it == traceStats.end()) {
+		MacroTraceStats stats;
+		stats.lane = static_cast<int>(traceStats.size()) + 1;
+		it = traceStats.emplace(macro, stats).first;
+	}
+	for (size_t i = 0; i < durations.size(); ++i) {
+		it->second.histograms[i].Record(toMicroseconds(durations[i]));
+	}
+
+	if (traceRecords.size() >= maxTraceRecords) {
+		traceRecords.pop_front();
+	}
+	traceRecords.push_back({macro, context, executionStart, executionEnd});
+
+	vblog(LOG_INFO,
+	      "trace of macro \"%s\" (%s): queueing %lld us, evaluation %lld us, dispatch %lld us, execution %lld us",
+	      macro.c_str(), context.event.source.c_str(),
+	      (long long)toMicroseconds(durations[0]).count(),
+	      (long long)toMicroseconds(durations[1]).count(),
+	      (long long)toMicroseconds(durations[2]).count(),
+	      (long long)toMicroseconds(durations[3]).count());
+}
+
+std::optional<LatencyHistogram> GetMacroTraceHistogram(const std::string &macro,
+						       MacroTraceStage stage)
+{
+	std::lock_guard<std::mutex> lock(traceMutex);
+	auto it = traceStats.find(macro);
+	if (it == traceStats.end()) {
+		return {};
+	}
+	return it->second.histograms[static_cast<size_t>(stage)];
+}
+
+void ClearMacroTraces()
+{
+	std::lock_guard<std::mutex> lock(traceMutex);
+	traceRecords.clear();
+	traceStats.clear();
+	traceStartTime = Clock::now();
+}
+
+static nlohmann::json histogramToJson(const LatencyHistogram &histogram)
+{
+	auto buckets = nlohmann::json::array();
+	const auto &counts = histogram.Buckets();
+	for (size_t i = 0; i < counts.size(); ++i) {
+		if (counts[i] == 0) {
+			continue;
+		}
+		buckets.push_back(
+			{{"upperBoundUs",
+			  LatencyHistogram::BucketUpperBound(i).count()},
+			 {"count", counts[i]}});
+	}
+
+	return {{"count", histogram.Count()},
+		{"minUs", histogram.Min().count()},
+		{"meanUs", histogram.Mean().count()},
+		{"p50Us", histogram.Percentile(50.0).count()},
+		{"p95Us", histogram.Percentile(95.0).count()},
+		{"p99Us", histogram.Percentile(99.0).count()},
+		{"maxUs", histogram.Max().count()},
+		{"buckets", buckets}};
+}
+
+bool WriteMacroTraces(const std::string &path)
+{
+	auto events = nlohmann::json::array();
+	auto macroStats = nlohmann::json::object();
+	{
+		std::lock_guard<std::mutex> lock(traceMutex);
+		const auto timestamp = [](Clock::time_point time) {
+			return toMicroseconds(time - traceStartTime).count();
+		};
+
+		for (const auto &[macro, stats] : traceStats) {
+			events.push_back({{"name", "thread_name"},
+					  {"ph", "M"},
+					  {"pid", 1},
+					  {"tid", stats.lane},
+					  {"args", {{"name", macro}}}});
+
+			auto stages = nlohmann::json::object();
+			for (size_t i = 0; i < stats.histograms.size(); ++i) {
+				stages[stageNames[i]] =
+					histogramToJson(stats.histograms[i]);
+			}
+			macroStats[macro] = stages;
+		}
+
+		for (const auto &record : traceRecords) {
+			const auto &context = record.context;
+			const std::array<Clock::time_point,
+					 static_cast<size_t>(
+						 MacroTraceStage::COUNT) +
+						 1>
+				boundaries = {
+					context.event.time,
+					context.evaluationStart,
+					context.evaluationEnd,
+					record.executionStart,
+					record.executionEnd,
+				};
+			const int lane = traceStats[record.macro].lane;
+			for (size_t i = 0; i + 1 < boundaries.size(); ++i) {
+				events.push_back(
+					{{"name", stageNames[i]},
+					 {"cat", "macro"},
+					 {"ph", "X"},
+					 {"pid", 1},
+					 {"tid", lane},
+					 {"ts", timestamp(boundaries[i])},
+					 {"dur",
+					  toMicroseconds(boundaries[i + 1] -
+							 boundaries[i])
+						  .count()},
+					 {"args",
+					  {{"macro", record.macro},
+					   {"source", context.event.source}}}});
+			}
+		}
+	}
+
+	const nlohmann::json trace = {{"traceEvents", events},
+				      {"displayTimeUnit", "ms"},
+				      {"otherData", {{"macros", macroStats}}}};
+
+	std::ofstream file(path, std::ios::out | std::ios::trunc);
+	if (!file.is_open()) {
+		blog(LOG_WARNING, "failed to write macro traces to \"%s\"",
+		     path.c_str());
+		return false;
+	}
+	file << trace.dump();
+	return file.good();
+}
+
+} // namespace advss
@@ -0,0 +1,56 @@
+#pragma once
+#include "export-symbol-helper.hpp"
+#include "latency-histogram.hpp"
+
+#include <chrono>
+#include <optional>
+#include <string>
+
+namespace advss {
+
+// Time at which an input event, which might cause a macro to run, reached the
+// plugin (e.g. a MIDI or chat message)
+struct MacroTraceEvent {
+	std::string source;
+	std::chrono::steady_clock::time_point time;
+};
+
+// Timestamps of a macro run triggered by a trace event consumed by one of its
+// conditions, which are passed along from the condition checks to the action
+// execution
+struct MacroTraceContext {
+	MacroTraceEvent event;
+	std::chrono::steady_clock::time_point evaluationStart;
+	std::chrono::steady_clock::time_point evaluationEnd;
+};
+
+enum class MacroTraceStage {
+	// Event arrival until the macro's conditions are checked
+	QUEUEING,
+	// Duration of the condition checks
+	EVALUATION,
+	// End of the condition checks until the actions start to run
+	DISPATCH,
+	// Duration of the action execution
+	EXECUTION,
+	COUNT,
+};
+
+// Tracing is disabled by default, in which case all of the functions below
+// return immediately
+EXPORT void EnableMacroTracing(bool);
+EXPORT bool MacroTracingEnabled();
+
+void RecordMacroTrace(const std::string &macro, const MacroTraceContext &,
+		      std::chrono::steady_clock::time_point executionStart,
+		      std::chrono::steady_clock::time_point executionEnd);
+std::optional<LatencyHistogram> GetMacroTraceHistogram(const std::string &macro,
+						       MacroTraceStage);
+void ClearMacroTraces();
+
+// Writes the recorded traces in the Chrome trace event format, which can be
+// opened using chrome://tracing or https://ui.perfetto.dev
+// The per stage latency histograms of each macro are stored in "otherData"
+bool WriteMacroTraces(const std::string &path);
+
+} // namespace advss
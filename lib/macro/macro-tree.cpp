@@ -439,6 +439,7 @@ void MacroTreeModel::Remove(std::shared_ptr<Macro> item)
 	_macros.erase(std::next(_macros.begin(), macroStartIdx),
 		      std::next(_macros.begin(), macroEndIdx + 1));
 	endRemoveRows();
+	ResetRunPhaseMacros();
 
 	_mt->selectionModel()->clear();
 
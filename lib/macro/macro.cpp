@@ -1,12 +1,16 @@
 #include "macro.hpp"
+#include "lane-executor.hpp"
 #include "macro-action-factory.hpp"
 #include "macro-condition-factory.hpp"
 #include "macro-dock.hpp"
 #include "macro-helpers.hpp"
+#include "macro-settings.hpp"
 #include "plugin-state-helpers.hpp"
 #include "splitter-helpers.hpp"
 #include "sync-helpers.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <limits>
 #undef max
@@ -75,6 +79,15 @@ static void obs_frontend_remove_dock(const char *id)
 namespace advss {
 
 static std::deque<std::shared_ptr<Macro>> macros;
+static std::atomic_bool runPhaseExecutorUsed = {false};
+
+static LaneExecutor &getRunPhaseExecutor()
+{
+	static LaneExecutor executor(std::clamp(
+		std::thread::hardware_concurrency(), 2u, 8u));
+	runPhaseExecutorUsed = true;
+	return executor;
+}
 
 Macro::Macro(const std::string &name, const bool addHotkey)
 {
@@ -125,6 +138,7 @@ void Macro::RemoveGroup(std::shared_ptr<Macro> group)
 	}
 
 	macros.erase(it);
+	ResetRunPhaseMacros();
 }
 
 void Macro::PrepareMoveToGroup(Macro *group, std::shared_ptr<Macro> item)
@@ -157,7 +171,7 @@ void Macro::PrepareMoveToGroup(std::shared_ptr<Macro> group,
 	}
 }
 
-static bool checkCondition(const std::shared_ptr<MacroCondition> &condition)
+static bool checkCondition(MacroCondition *condition)
 {
 	using namespace std::chrono_literals;
 	static constexpr auto perfLogThreshold = 300ms;
@@ -181,41 +195,67 @@ static bool checkCondition(const std::shared_ptr<MacroCondition> &condition)
 	return conditionMatched;
 }
 
+std::optional<MacroTraceEvent> Macro::ConsumeConditionTraceEvents()
+{
+	std::optional<MacroTraceEvent> oldest;
+	for (const auto &slot : _conditionPlan) {
+		auto event = slot.condition->ConsumeTraceEvent();
+		if (event && (!oldest || event->time < oldest->time)) {
+			oldest = std::move(event);
+		}
+	}
+	return oldest;
+}
+
 bool Macro::CeckMatch(bool ignorePause)
 {
+	_traceContext.reset();
 	if (_isGroup) {
 		return false;
 	}
 
-	_matched = false;
-	for (auto &condition : _conditions) {
+	const bool traceEvaluation = MacroTracingEnabled();
+	const auto evaluationStart =
+		traceEvaluation ? std::chrono::steady_clock::now()
+				: std::chrono::steady_clock::time_point{};
+
+	if (_conditionPlanDirty) {
+		CompileConditionPlan();
+	}
+
+	const auto checkSlot =
+		[this, ignorePause](
+			const ConditionPlanSlot &slot) -> std::optional<bool> {
 		if (_paused && !ignorePause) {
 			vblog(LOG_INFO, "Macro %s is paused", _name.c_str());
-			return false;
+			return {};
 		}
 
+		auto condition = slot.condition;
 		bool conditionMatched = checkCondition(condition);
 		conditionMatched =
 			condition->CheckDurationModifier(conditionMatched);
 
-		const auto logicType = condition->GetLogicType();
-		if (logicType == Logic::Type::NONE) {
+		if (slot.op.mode == LogicOp::Mode::SKIP) {
 			vblog(LOG_INFO, "ignoring condition '%s' for '%s'",
 			      condition->GetId().c_str(), _name.c_str());
-			continue;
+			return conditionMatched;
 		}
 		vblog(LOG_INFO, "condition %s returned %d",
 		      condition->GetId().c_str(), conditionMatched);
 
-		const bool isNegativeLogicType =
-			Logic::IsNegationType(logicType);
-		if ((conditionMatched && !isNegativeLogicType) ||
-		    (!conditionMatched && isNegativeLogicType)) {
+		if (conditionMatched != slot.op.negate) {
 			condition->EnableHighlight();
 		}
+		return conditionMatched;
+	};
 
-		_matched = Logic::ApplyConditionLogic(
-			logicType, _matched, conditionMatched, _name.c_str());
+	if (!EvaluateConditionPlan(_conditionPlan, checkSlot, _matched,
+				   _name.c_str())) {
+		// Events consumed before the evaluation was aborted would
+		// otherwise be attributed to a later run
+		ConsumeConditionTraceEvents();
+		return false;
 	}
 
 	vblog(LOG_INFO, "Macro %s returned %d", _name.c_str(), _matched);
@@ -227,6 +267,11 @@ bool Macro::CeckMatch(bool ignorePause)
 
 	_lastMatched = _matched;
 	_lastCheckTime = std::chrono::high_resolution_clock::now();
+	auto trigger = ConsumeConditionTraceEvents();
+	if (trigger && traceEvaluation) {
+		_traceContext = {std::move(*trigger), evaluationStart,
+				 std::chrono::steady_clock::now()};
+	}
 	return _matched;
 }
 
@@ -244,13 +289,7 @@ bool Macro::PerformActions(bool match, bool forceParallel, bool ignorePause)
 		      _name.c_str());
 	}
 
-	std::function<bool(bool)> runFunc =
-		match ? std::bind(&Macro::RunActions, this,
-				  std::placeholders::_1)
-		      : std::bind(&Macro::RunElseActions, this,
-				  std::placeholders::_1);
-	_stop = false;
-	_done = false;
+	auto runFunc = PrepareActionRun(match);
 	bool ret = true;
 	if (_runInParallel || forceParallel) {
 		if (_backgroundThread.joinable()) {
@@ -262,6 +301,85 @@ bool Macro::PerformActions(bool match, bool forceParallel, bool ignorePause)
 		ret = runFunc(ignorePause);
 	}
 
+	UpdateExecutionState();
+	return ret;
+}
+
+bool Macro::PerformActionsSynchronously(bool match, bool ignorePause)
+{
+	if (!_done) {
+		vblog(LOG_INFO, "Macro %s already running", _name.c_str());
+
+		if (!_stopActionsIfNotDone) {
+			return false;
+		}
+
+		Stop();
+		vblog(LOG_INFO, "Stopped macro %s actions to rerun them",
+		      _name.c_str());
+	}
+
+	auto runFunc = PrepareActionRun(match);
+	const bool ret = runFunc(ignorePause);
+	UpdateExecutionState();
+	return ret;
+}
+
+void Macro::QueueActions(bool match)
+{
+	auto &executor = getRunPhaseExecutor();
+	if (!_done || executor.IsBusy(this)) {
+		vblog(LOG_INFO, "Macro %s already running", _name.c_str());
+
+		if (!_stopActionsIfNotDone) {
+			_traceContext.reset();
+			return;
+		}
+
+		Stop();
+		vblog(LOG_INFO, "Stopped macro %s actions to rerun them",
+		      _name.c_str());
+	}
+
+	auto runFunc = PrepareActionRun(match);
+	executor.Submit(
+		this,
+		[this, runFunc]() {
+			if (!runFunc(false)) {
+				blog(LOG_WARNING, "abort macro: %s",
+				     _name.c_str());
+			}
+		},
+		_runExclusive);
+
+	UpdateExecutionState();
+}
+
+std::function<bool(bool)> Macro::PrepareActionRun(bool match)
+{
+	std::function<bool(bool)> runFunc =
+		match ? std::bind(&Macro::RunActions, this,
+				  std::placeholders::_1)
+		      : std::bind(&Macro::RunElseActions, this,
+				  std::placeholders::_1);
+	if (_traceContext) {
+		runFunc = [this, runFunc,
+			   trace = *_traceContext](bool ignore) {
+			const auto start = std::chrono::steady_clock::now();
+			const bool ret = runFunc(ignore);
+			RecordMacroTrace(_name, trace, start,
+					 std::chrono::steady_clock::now());
+			return ret;
+		};
+		_traceContext.reset();
+	}
+	_stop = false;
+	_done = false;
+	return runFunc;
+}
+
+void Macro::UpdateExecutionState()
+{
 	_lastExecutionTime = std::chrono::high_resolution_clock::now();
 	auto group = _parent.lock();
 	if (group) {
@@ -270,7 +388,6 @@ bool Macro::PerformActions(bool match, bool forceParallel, bool ignorePause)
 	if (_runCount != std::numeric_limits<int>::max()) {
 		_runCount++;
 	}
-	return ret;
 }
 
 bool Macro::WasExecutedSince(
@@ -335,14 +452,8 @@ void Macro::ResetTimers()
 	_lastExecutionTime = {};
 }
 
-bool Macro::RunActionsHelper(
-	const std::deque<std::shared_ptr<MacroAction>> &actionsToRun,
-	bool ignorePause)
+bool Macro::RunActionsHelper(const ActionList &actions, bool ignorePause)
 {
-	// Create copy of action list as elements might be removed, inserted, or
-	// reordered while actions are currently being executed.
-	auto actions = actionsToRun;
-
 	bool actionsExecutedSuccessfully = true;
 	for (auto &action : actions) {
 		if (action->Enabled()) {
@@ -369,13 +480,17 @@ bool Macro::RunActionsHelper(
 bool Macro::RunActions(bool ignorePause)
 {
 	vblog(LOG_INFO, "running actions of %s", _name.c_str());
-	return RunActionsHelper(_actions, ignorePause);
+	// Elements might be removed, inserted, or reordered while actions are
+	// currently being executed, so the snapshot has to be kept alive
+	const auto actions = _actionSnapshot.Get();
+	return RunActionsHelper(*actions, ignorePause);
 }
 
 bool Macro::RunElseActions(bool ignorePause)
 {
 	vblog(LOG_INFO, "running else actions of %s", _name.c_str());
-	return RunActionsHelper(_elseActions, ignorePause);
+	const auto actions = _elseActionSnapshot.Get();
+	return RunActionsHelper(*actions, ignorePause);
 }
 
 bool Macro::WasPausedSince(
@@ -426,6 +541,10 @@ void Macro::Stop()
 	if (_backgroundThread.joinable()) {
 		_backgroundThread.join();
 	}
+	if (runPhaseExecutorUsed && getRunPhaseExecutor().Cancel(this)) {
+		// Queued runs which were dropped will never reset this flag
+		_done = true;
+	}
 }
 
 MacroInputVariables Macro::GetInputVariables() const
@@ -438,100 +557,90 @@ void Macro::SetInputVariables(const MacroInputVariables &inputVariables)
 	_inputVariables = inputVariables;
 }
 
-std::vector<TempVariable> Macro::GetTempVars(MacroSegment *filter) const
-{
-	std::vector<TempVariable> res;
+// Indices into Macro::_tempVarsByType
+static constexpr size_t conditionTempVars = 0;
+static constexpr size_t actionTempVars = 1;
+static constexpr size_t elseActionTempVars = 2;
 
-	auto addTempVars = [&res](const std::deque<std::shared_ptr<MacroSegment>>
-					  &segments) {
-		for (const auto &s : segments) {
-			const auto &tempVars = s->_tempVariables;
-			res.insert(res.end(), tempVars.begin(), tempVars.end());
+void Macro::BuildTempVarScopeIndex() const
+{
+	_tempVarScopes.clear();
+	auto addSegments = [this](const auto &segments, size_t type) {
+		auto &vars = _tempVarsByType[type];
+		vars.clear();
+		for (const auto &segment : segments) {
+			TempVarScope scope{type, vars.size(), {}};
+			const auto &tempVars = segment->_tempVariables;
+			for (size_t i = 0; i < tempVars.size(); ++i) {
+				vars.push_back({segment.get(), i});
+				scope.ids.emplace(tempVars[i].ID(), i);
+			}
+			_tempVarScopes.emplace(segment.get(), std::move(scope));
 		}
 	};
 
-	addTempVars({_conditions.begin(), _conditions.end()});
-	addTempVars({_actions.begin(), _actions.end()});
-	addTempVars({_elseActions.begin(), _elseActions.end()});
+	addSegments(_conditions, conditionTempVars);
+	addSegments(_actions, actionTempVars);
+	addSegments(_elseActions, elseActionTempVars);
+}
 
-	if (!filter) {
-		return res;
+std::vector<TempVariable> Macro::GetTempVars(MacroSegment *filter) const
+{
+	std::lock_guard<std::mutex> lock(_tempVarScopeMutex);
+	if (_tempVarScopeDirty.exchange(false)) {
+		BuildTempVarScopeIndex();
 	}
 
-	auto isCondition = [this](const MacroSegment *segment) -> bool {
-		return std::find_if(_conditions.begin(), _conditions.end(),
-				    [segment](
-					    const std::shared_ptr<MacroSegment>
-						    &ptr) {
-					    return ptr.get() == segment;
-				    }) != _conditions.end();
-	};
-	auto isAction = [this](MacroSegment *segment) -> bool {
-		return std::find_if(_actions.begin(), _actions.end(),
-				    [segment](
-					    const std::shared_ptr<MacroSegment>
-						    &ptr) {
-					    return ptr.get() == segment;
-				    }) != _actions.end();
+	std::vector<TempVariable> res;
+	auto addTempVars = [this, &res](size_t type, size_t count) {
+		const auto &vars = _tempVarsByType[type];
+		for (size_t i = 0; i < count && i < vars.size(); ++i) {
+			const auto &tempVars = vars[i].segment->_tempVariables;
+			if (vars[i].index < tempVars.size()) {
+				res.push_back(tempVars[vars[i].index]);
+			}
+		}
 	};
-	auto isElseAction = [this](MacroSegment *segment) -> bool {
-		return std::find_if(_elseActions.begin(), _elseActions.end(),
-				    [segment](
-					    const std::shared_ptr<MacroSegment>
-						    &ptr) {
-					    return ptr.get() == segment;
-				    }) != _elseActions.end();
+	const auto allTempVars = [this](size_t type) {
+		return _tempVarsByType[type].size();
 	};
 
-	const int filterIndex = filter->GetIndex();
-	// Remove all actions and else actions and conditions after filterIndex
-	if (isCondition(filter)) {
-		for (auto it = res.begin(); it != res.end();) {
-			auto segment = it->Segment().lock().get();
-			if (isCondition(segment) &&
-			    segment->GetIndex() >= filterIndex) {
-				it = res.erase(it);
-				continue;
-			}
-			if (isAction(segment) || isElseAction(segment)) {
-				it = res.erase(it);
-				continue;
-			}
-			++it;
-		}
+	if (!filter) {
+		addTempVars(conditionTempVars, allTempVars(conditionTempVars));
+		addTempVars(actionTempVars, allTempVars(actionTempVars));
+		addTempVars(elseActionTempVars,
+			    allTempVars(elseActionTempVars));
 		return res;
 	}
-	// Remove all else actions and actions after filterIndex
-	if (isAction(filter)) {
-		for (auto it = res.begin(); it != res.end();) {
-			auto segment = it->Segment().lock().get();
-			if (isAction(segment) &&
-			    segment->GetIndex() >= filterIndex) {
-				it = res.erase(it);
-				continue;
-			}
-			if (isElseAction(segment)) {
-				it = res.erase(it);
-				continue;
+
+	auto it = _tempVarScopes.find(filter);
+	if (it == _tempVarScopes.end()) {
+		// Segments which are not part of this macro yet are treated
+		// like else actions at their current index
+		const auto index = filter->GetIndex();
+		size_t count = allTempVars(elseActionTempVars);
+		if (index >= 0 && index < (int)_elseActions.size()) {
+			auto elseIt = _tempVarScopes.find(
+				_elseActions[index].get());
+			if (elseIt != _tempVarScopes.end()) {
+				count = elseIt->second.offset;
 			}
-			++it;
 		}
+		addTempVars(conditionTempVars, allTempVars(conditionTempVars));
+		addTempVars(elseActionTempVars, count);
 		return res;
 	}
-	// Remove all actions and elseActions after filterIndex
-	for (auto it = res.begin(); it != res.end();) {
-		auto segment = it->Segment().lock().get();
-		if (isElseAction(segment) &&
-		    segment->GetIndex() >= filterIndex) {
-			it = res.erase(it);
-			continue;
-		}
-		if (isAction(segment)) {
-			it = res.erase(it);
-			continue;
-		}
-		++it;
+
+	// Conditions can only see the temp variables of preceding conditions
+	// while actions and else actions can see those of all conditions and
+	// preceding segments of the same type
+	const auto &scope = it->second;
+	if (scope.type == conditionTempVars) {
+		addTempVars(conditionTempVars, scope.offset);
+		return res;
 	}
+	addTempVars(conditionTempVars, allTempVars(conditionTempVars));
+	addTempVars(scope.type, scope.offset);
 	return res;
 }
 
@@ -541,21 +650,35 @@ std::optional<const TempVariable> Macro::GetTempVar(const MacroSegment *segment,
 	if (!segment) {
 		return {};
 	}
-	return segment->GetTempVar(id);
+
+	std::lock_guard<std::mutex> lock(_tempVarScopeMutex);
+	if (_tempVarScopeDirty.exchange(false)) {
+		BuildTempVarScopeIndex();
+	}
+
+	auto it = _tempVarScopes.find(segment);
+	if (it == _tempVarScopes.end()) {
+		return segment->GetTempVar(id);
+	}
+	auto idIt = it->second.ids.find(id);
+	const auto &tempVars = segment->_tempVariables;
+	if (idIt == it->second.ids.end() || idIt->second >= tempVars.size()) {
+		return segment->GetTempVar(id);
+	}
+	return tempVars[idIt->second];
 }
 
 void Macro::InvalidateTempVarValues() const
 {
-	auto invalidateHelper =
-		[](const std::deque<std::shared_ptr<MacroSegment>> &segments) {
-			for (const auto &s : segments) {
-				s->InvalidateTempVarValues();
-			}
-		};
+	auto invalidateHelper = [](const auto &segments) {
+		for (const auto &s : segments) {
+			s->InvalidateTempVarValues();
+		}
+	};
 
-	invalidateHelper({_conditions.begin(), _conditions.end()});
-	invalidateHelper({_actions.begin(), _actions.end()});
-	invalidateHelper({_elseActions.begin(), _elseActions.end()});
+	invalidateHelper(_conditions);
+	invalidateHelper(_actions);
+	invalidateHelper(_elseActions);
 }
 
 std::deque<std::shared_ptr<MacroCondition>> &Macro::Conditions()
@@ -563,6 +686,23 @@ std::deque<std::shared_ptr<MacroCondition>> &Macro::Conditions()
 	return _conditions;
 }
 
+const std::deque<std::shared_ptr<MacroCondition>> &Macro::Conditions() const
+{
+	return _conditions;
+}
+
+void Macro::CompileConditionPlan()
+{
+	_conditionPlan.clear();
+	_conditionPlan.reserve(_conditions.size());
+	for (const auto &condition : _conditions) {
+		const auto logicType = condition->GetLogicType();
+		_conditionPlan.push_back({condition.get(), logicType,
+					  LogicOp::FromType(logicType)});
+	}
+	_conditionPlanDirty = false;
+}
+
 std::deque<std::shared_ptr<MacroAction>> &Macro::Actions()
 {
 	return _actions;
@@ -573,7 +713,8 @@ std::deque<std::shared_ptr<MacroAction>> &Macro::ElseActions()
 	return _elseActions;
 }
 
-static void updateIndicesHelper(std::deque<std::shared_ptr<MacroSegment>> &list)
+template<typename T>
+static void updateIndicesHelper(const std::deque<std::shared_ptr<T>> &list)
 {
 	int idx = 0;
 	for (auto segment : list) {
@@ -584,23 +725,29 @@ static void updateIndicesHelper(std::deque<std::shared_ptr<MacroSegment>> &list)
 
 void Macro::UpdateActionIndices()
 {
-	std::deque<std::shared_ptr<MacroSegment>> list(_actions.begin(),
-						       _actions.end());
-	updateIndicesHelper(list);
+	_tempVarScopeDirty = true;
+	updateIndicesHelper(_actions);
+	_actionSnapshot.Publish({_actions.begin(), _actions.end()});
 }
 
 void Macro::UpdateElseActionIndices()
 {
-	std::deque<std::shared_ptr<MacroSegment>> list(_elseActions.begin(),
-						       _elseActions.end());
-	updateIndicesHelper(list);
+	_tempVarScopeDirty = true;
+	updateIndicesHelper(_elseActions);
+	_elseActionSnapshot.Publish({_elseActions.begin(), _elseActions.end()});
+}
+
+void Macro::PublishActionSnapshots()
+{
+	_actionSnapshot.Publish({_actions.begin(), _actions.end()});
+	_elseActionSnapshot.Publish({_elseActions.begin(), _elseActions.end()});
 }
 
 void Macro::UpdateConditionIndices()
 {
-	std::deque<std::shared_ptr<MacroSegment>> list(_conditions.begin(),
-						       _conditions.end());
-	updateIndicesHelper(list);
+	_conditionPlanDirty = true;
+	_tempVarScopeDirty = true;
+	updateIndicesHelper(_conditions);
 }
 
 std::shared_ptr<Macro> Macro::Parent() const
@@ -618,6 +765,7 @@ bool Macro::Save(obs_data_t *obj, bool saveForCopy) const
 	obs_data_set_bool(obj, "onChange", _performActionsOnChange);
 	obs_data_set_bool(obj, "skipExecOnStart", _skipExecOnStart);
 	obs_data_set_bool(obj, "stopActionsIfNotDone", _stopActionsIfNotDone);
+	obs_data_set_bool(obj, "runExclusive", _runExclusive);
 
 	obs_data_set_bool(obj, "group", _isGroup);
 	if (_isGroup) {
@@ -681,6 +829,7 @@ bool Macro::Load(obs_data_t *obj)
 	_performActionsOnChange = obs_data_get_bool(obj, "onChange");
 	_skipExecOnStart = obs_data_get_bool(obj, "skipExecOnStart");
 	_stopActionsIfNotDone = obs_data_get_bool(obj, "stopActionsIfNotDone");
+	_runExclusive = obs_data_get_bool(obj, "runExclusive");
 
 	_isGroup = obs_data_get_bool(obj, "group");
 	if (_isGroup) {
@@ -726,6 +875,7 @@ bool Macro::Load(obs_data_t *obj)
 		auto newEntry = MacroConditionFactory::Create(id, this);
 		if (newEntry) {
 			_conditions.emplace_back(newEntry);
+			_conditionPlanDirty = true;
 			auto c = _conditions.back().get();
 			c->Load(arrayObj);
 			c->ValidateLogicSelection(root, Name().c_str());
@@ -1195,6 +1345,7 @@ void SaveMacros(obs_data_t *obj)
 void LoadMacros(obs_data_t *obj)
 {
 	macros.clear();
+	ResetRunPhaseMacros();
 	obs_data_array_t *macroArray = obs_data_get_array(obj, "macros");
 	size_t count = obs_data_array_count(macroArray);
 
@@ -1242,6 +1393,7 @@ void LoadMacros(obs_data_t *obj)
 		}
 		macros.erase(it);
 	}
+	ResetRunPhaseMacros();
 }
 
 std::deque<std::shared_ptr<Macro>> &GetMacros()
@@ -1265,13 +1417,36 @@ bool CheckMacros()
 	return matchFound;
 }
 
+// Snapshot of the macro list used by RunMacros().
+// The macro list is modified in many places, so instead of publishing a new
+// snapshot on every modification it is compared to the macro list at the
+// start of each run phase, which only compares the pointers.
+static Snapshot<std::vector<std::shared_ptr<Macro>>> runPhaseMacroSnapshot;
+
+static auto getRunPhaseMacros()
+{
+	auto snapshot = runPhaseMacroSnapshot.Get();
+	if (!std::equal(snapshot->begin(), snapshot->end(), macros.begin(),
+			macros.end())) {
+		runPhaseMacroSnapshot.Publish({macros.begin(), macros.end()});
+		snapshot = runPhaseMacroSnapshot.Get();
+	}
+	return snapshot;
+}
+
+void ResetRunPhaseMacros()
+{
+	runPhaseMacroSnapshot.Publish({});
+}
+
 bool RunMacros()
 {
-	// Create copy of macro list as elements might be removed, inserted, or
-	// reordered while macros are currently being executed.
+	// Keep a reference to the snapshot of the macro list as elements might
+	// be removed, inserted, or reordered while macros are currently being
+	// executed.
 	// For example, this can happen if a macro is performing a wait action,
 	// as the main lock will be unlocked during this time.
-	auto runPhaseMacros = macros;
+	const auto runPhaseMacros = getRunPhaseMacros();
 
 	// Avoid deadlocks when opening settings window and calling frontend
 	// API functions at the same time.
@@ -1288,17 +1463,33 @@ bool RunMacros()
 		lock->unlock();
 	}
 
-	for (auto &m : runPhaseMacros) {
-		if (!m || !m->ShouldRunActions()) {
+	// Actions queued on the execution lanes do not block the next
+	// condition checks.
+	// During shutdown the actions have to be completed before the settings
+	// are saved, so they are performed directly instead.
+	const bool queueActions = GetGlobalMacroSettings()._concurrentRunPhase &&
+				  !OBSIsShuttingDown();
+
+	for (const auto &m : *runPhaseMacros) {
+		if (!m) {
+			continue;
+		}
+		if (!m->ShouldRunActions()) {
+			m->ResetTraceContext();
 			continue;
 		}
 		if (IsFirstInterval() && m->SkipExecOnStart()) {
 			blog(LOG_INFO,
 			     "skip execution of macro \"%s\" at startup",
 			     m->Name().c_str());
+			m->ResetTraceContext();
 			continue;
 		}
 		vblog(LOG_INFO, "running macro: %s", m->Name().c_str());
+		if (queueActions && !m->RunInParallel()) {
+			m->QueueActions(m->Matched());
+			continue;
+		}
 		if (!m->PerformActions(m->Matched())) {
 			blog(LOG_WARNING, "abort macro: %s", m->Name().c_str());
 		}
@@ -4,16 +4,22 @@
 #include "macro-helpers.hpp"
 #include "macro-input.hpp"
 #include "macro-ref.hpp"
+#include "macro-trace.hpp"
+#include "snapshot.hpp"
 #include "variable-string.hpp"
 #include "temp-variable.hpp"
 
 #include <QString>
 #include <QByteArray>
+#include <array>
+#include <atomic>
 #include <string>
 #include <deque>
 #include <memory>
 #include <map>
+#include <mutex>
 #include <thread>
+#include <unordered_map>
 #include <obs.hpp>
 #include <obs-module-helper.hpp>
 
@@ -29,18 +35,30 @@ public:
 	std::string Name() const { return _name; }
 	void SetName(const std::string &name);
 
+	// If one of the conditions consumed a trace event, the time spent
+	// checking the conditions is recorded and passed on to the next
+	// PerformActions() call
 	bool CeckMatch(bool ignorePause = false);
 	bool Matched() const { return _matched; }
 	int64_t MsSinceLastCheck() const;
 	bool ShouldRunActions() const;
 	bool PerformActions(bool match, bool forceParallel = false,
 			    bool ignorePause = false);
+	// Performs the actions on the calling thread, even if the macro is set
+	// to run in parallel. Returns false if the actions were aborted or the
+	// macro is already running.
+	bool PerformActionsSynchronously(bool match, bool ignorePause = false);
+	// Queues the actions on the execution lane of this macro instead of
+	// performing them on the calling thread
+	void QueueActions(bool match);
 
 	void SetPaused(bool pause = true);
 	bool Paused() const { return _paused; }
 	bool WasPausedSince(
 		const std::chrono::high_resolution_clock::time_point &) const;
 
+	void ResetTraceContext() { _traceContext.reset(); }
+
 	void Stop();
 	bool GetStop() const { return _stop; }
 	void ResetTimers();
@@ -54,6 +72,9 @@ public:
 	void SetStopActionsIfNotDone(bool stopActionsIfNotDone);
 	bool StopActionsIfNotDone() const { return _stopActionsIfNotDone; }
 
+	void SetRunExclusive(bool exclusive) { _runExclusive = exclusive; }
+	bool RunExclusive() const { return _runExclusive; }
+
 	int RunCount() const { return _runCount; };
 	void ResetRunCount() { _runCount = 0; };
 
@@ -70,14 +91,21 @@ public:
 	std::optional<const TempVariable>
 	GetTempVar(const MacroSegment *, const std::string &id) const;
 	void InvalidateTempVarValues() const;
+	// Has to be called if the temp variables of a segment change
+	void InvalidateTempVarScope() { _tempVarScopeDirty = true; }
 
 	// Macro segments
 	std::deque<std::shared_ptr<MacroCondition>> &Conditions();
+	const std::deque<std::shared_ptr<MacroCondition>> &Conditions() const;
+	// Has to be called if the conditions or their logic types change
+	void InvalidateConditionPlan() { _conditionPlanDirty = true; }
 	std::deque<std::shared_ptr<MacroAction>> &Actions();
 	std::deque<std::shared_ptr<MacroAction>> &ElseActions();
 	void UpdateActionIndices();
 	void UpdateElseActionIndices();
 	void UpdateConditionIndices();
+	// Has to be called if actions are replaced without updating the indices
+	void PublishActionSnapshots();
 
 	// Group controls
 	static std::shared_ptr<Macro>
@@ -149,9 +177,16 @@ private:
 	void ClearHotkeys() const;
 	void SetHotkeysDesc() const;
 
-	bool RunActionsHelper(
-		const std::deque<std::shared_ptr<MacroAction>> &actions,
-		bool ignorePause);
+	void CompileConditionPlan();
+	void BuildTempVarScopeIndex() const;
+
+	std::function<bool(bool)> PrepareActionRun(bool match);
+	void UpdateExecutionState();
+	// Returns the oldest trace event consumed by any of the conditions
+	std::optional<MacroTraceEvent> ConsumeConditionTraceEvents();
+
+	using ActionList = std::vector<std::shared_ptr<MacroAction>>;
+	bool RunActionsHelper(const ActionList &actions, bool ignorePause);
 	bool RunActions(bool ignorePause);
 	bool RunElseActions(bool ignorePause);
 
@@ -168,12 +203,50 @@ private:
 	std::chrono::high_resolution_clock::time_point _lastUnpauseTime{};
 	std::chrono::high_resolution_clock::time_point _lastExecutionTime{};
 	std::thread _backgroundThread;
+	std::optional<MacroTraceContext> _traceContext;
 	std::vector<std::thread> _helperThreads;
 
 	std::deque<std::shared_ptr<MacroCondition>> _conditions;
 	std::deque<std::shared_ptr<MacroAction>> _actions;
 	std::deque<std::shared_ptr<MacroAction>> _elseActions;
 
+	// Published whenever the action lists were modified, so running the
+	// actions does not have to copy the lists to be safe against concurrent
+	// modifications
+	Snapshot<ActionList> _actionSnapshot;
+	Snapshot<ActionList> _elseActionSnapshot;
+
+	// Flat copy of the conditions and their resolved logic used by
+	// CeckMatch(), which is rebuilt whenever the conditions were modified
+	struct ConditionPlanSlot {
+		MacroCondition *condition;
+		Logic::Type logicType;
+		LogicOp op;
+	};
+	std::vector<ConditionPlanSlot> _conditionPlan;
+	bool _conditionPlanDirty = true;
+
+	// Index of the temp variables visible from each segment, which is
+	// rebuilt whenever segments or their temp variables were modified.
+	// The temp variables of each segment type are stored in segment order,
+	// so a segment can see the temp variables of the first "offset"
+	// entries of its own type, and actions and else actions additionally
+	// see those of all conditions.
+	struct TempVarLocation {
+		MacroSegment *segment;
+		size_t index;
+	};
+	struct TempVarScope {
+		size_t type;
+		size_t offset;
+		std::unordered_map<std::string, size_t> ids;
+	};
+	mutable std::array<std::vector<TempVarLocation>, 3> _tempVarsByType;
+	mutable std::unordered_map<const MacroSegment *, TempVarScope>
+		_tempVarScopes;
+	mutable std::atomic_bool _tempVarScopeDirty = {true};
+	mutable std::mutex _tempVarScopeMutex;
+
 	std::weak_ptr<Macro> _parent;
 	uint32_t _groupSize = 0;
 	bool _isGroup = false;
@@ -186,6 +259,7 @@ private:
 	bool _performActionsOnChange = true;
 	bool _skipExecOnStart = false;
 	bool _stopActionsIfNotDone = false;
+	bool _runExclusive = false;
 	bool _paused = false;
 	int _runCount = 0;
 	bool _registerHotkeys = true;
@@ -225,6 +299,9 @@ void SaveMacros(obs_data_t *obj);
 std::deque<std::shared_ptr<Macro>> &GetMacros();
 bool CheckMacros();
 bool RunMacros();
+// Releases the references to the macros held for the next RunMacros() call.
+// Has to be called when macros are removed, so they are destroyed right away.
+void ResetRunPhaseMacros();
 void StopAllMacros();
 Macro *GetMacroByName(const char *name);
 Macro *GetMacroByQString(const QString &name);
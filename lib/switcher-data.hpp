@@ -55,6 +55,8 @@ public:
 	obs_module_t *GetModule();
 
 	void SetWaitScene();
+	void WaitForNextInterval(std::unique_lock<std::mutex> &lock,
+				 std::chrono::milliseconds duration);
 	bool SceneChangedDuringWait();
 	bool AnySceneTransitionStarted();
 
@@ -251,6 +253,9 @@ public:
 	std::deque<ScreenRegionSwitch> screenRegionSwitches;
 	bool uninterruptibleSceneSequenceActive = false;
 	std::deque<SceneSequenceSwitch> sceneSequenceSwitches;
+	// Earliest point in time at which a scene sequence step will be due
+	std::optional<std::chrono::high_resolution_clock::time_point>
+		nextSceneSequenceDeadline;
 	std::deque<RandomSwitch> randomSwitches;
 	OBSWeakSource lastRandomScene;
 	FileIOData fileIO;
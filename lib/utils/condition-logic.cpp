@@ -51,6 +51,28 @@ bool Logic::ApplyConditionLogic(Type type, bool currentMatchResult,
 	return currentMatchResult;
 }
 
+LogicOp LogicOp::FromType(Logic::Type type)
+{
+	switch (type) {
+	case Logic::Type::ROOT_NONE:
+		return {Mode::SET, false};
+	case Logic::Type::ROOT_NOT:
+		return {Mode::SET, true};
+	case Logic::Type::NONE:
+		return {Mode::SKIP, false};
+	case Logic::Type::AND:
+		return {Mode::AND, false};
+	case Logic::Type::OR:
+		return {Mode::OR, false};
+	case Logic::Type::AND_NOT:
+		return {Mode::AND, true};
+	case Logic::Type::OR_NOT:
+		return {Mode::OR, true};
+	default:
+		return {Mode::INVALID, false};
+	}
+}
+
 void Logic::PopulateLogicTypeSelection(QComboBox *list, bool isRootCondition)
 {
 	auto compare = isRootCondition
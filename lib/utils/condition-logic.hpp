@@ -1,7 +1,10 @@
 #pragma once
+#include <cstdint>
 #include <map>
 #include <obs-data.h>
+#include <optional>
 #include <string>
+#include <vector>
 
 class QComboBox;
 
@@ -48,4 +51,71 @@ private:
 	static const std::map<Type, const char *> localeMap;
 };
 
+// Pre-resolved form of a Logic::Type used when evaluating a list of
+// conditions, so the logic type does not have to be dispatched on again for
+// every evaluation
+struct LogicOp {
+	enum class Mode : uint8_t {
+		SET,
+		AND,
+		OR,
+		// Condition result is ignored
+		SKIP,
+		// Has to be handled by Logic::ApplyConditionLogic()
+		INVALID,
+	};
+
+	static LogicOp FromType(Logic::Type);
+
+	bool Apply(bool currentMatchResult, bool conditionMatched) const
+	{
+		const bool value = conditionMatched != negate;
+		switch (mode) {
+		case Mode::SET:
+			return value;
+		case Mode::AND:
+			return currentMatchResult && value;
+		case Mode::OR:
+			return currentMatchResult || value;
+		default:
+			return currentMatchResult;
+		}
+	}
+
+	Mode mode = Mode::INVALID;
+	bool negate = false;
+};
+
+// Evaluates a list of pre-resolved conditions.
+// Each entry has to provide the "logicType" and "op" members.
+// The check function returns the result of the entry's condition or an empty
+// optional to abort the evaluation, in which case false is returned.
+// It is also called for entries whose result is ignored, as condition checks
+// might update the state of the condition.
+// The combined result is written to "matched" after every entry.
+template<class Entry, class CheckFunc>
+bool EvaluateConditionPlan(const std::vector<Entry> &plan, CheckFunc &&check,
+			   bool &matched, const char *context)
+{
+	matched = false;
+	for (const auto &entry : plan) {
+		const std::optional<bool> conditionMatched = check(entry);
+		if (!conditionMatched) {
+			return false;
+		}
+		if (entry.op.mode == LogicOp::Mode::SKIP) {
+			continue;
+		}
+		if (entry.op.mode == LogicOp::Mode::INVALID) {
+			matched = Logic::ApplyConditionLogic(entry.logicType,
+							     matched,
+							     *conditionMatched,
+							     context);
+			continue;
+		}
+		matched = entry.op.Apply(matched, *conditionMatched);
+	}
+	return true;
+}
+
 } // namespace advss
@@ -0,0 +1,86 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <unordered_set>
+
+namespace advss {
+
+// Remembers the IDs seen within the given time window to detect duplicate
+// deliveries of the same message.
+// The number of remembered IDs is additionally limited by maxSize, in which
+// case the oldest IDs are forgotten first.
+//
+// Not thread safe - access has to be synchronized by the owner.
+class DuplicateFilter {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	DuplicateFilter(std::chrono::milliseconds window, size_t maxSize);
+
+	// Returns true and remembers the ID if it was not seen in the window
+	bool Insert(const std::string &id,
+		    Clock::time_point now = Clock::now());
+	bool Contains(const std::string &id) const;
+	size_t Size() const { return _ids.size(); }
+	void Clear();
+
+private:
+	struct Entry {
+		Clock::time_point time;
+		std::string id;
+	};
+
+	void Expire(Clock::time_point now);
+
+	const std::chrono::milliseconds _window;
+	const size_t _maxSize;
+	std::unordered_set<std::string> _ids;
+	// Ordered by insertion time
+	std::deque<Entry> _expiryQueue;
+};
+
+inline DuplicateFilter::DuplicateFilter(std::chrono::milliseconds window,
+					size_t maxSize)
+	: _window(window),
+	  _maxSize(std::max<size_t>(maxSize, 1))
+{
+}
+
+inline bool DuplicateFilter::Insert(const std::string &id,
+				    Clock::time_point now)
+{
+	Expire(now);
+	if (!_ids.insert(id).second) {
+		return false;
+	}
+	_expiryQueue.push_back({now, id});
+	while (_expiryQueue.size() > _maxSize) {
+		_ids.erase(_expiryQueue.front().id);
+		_expiryQueue.pop_front();
+	}
+	return true;
+}
+
+inline bool DuplicateFilter::Contains(const std::string &id) const
+{
+	return _ids.find(id) != _ids.end();
+}
+
+inline void DuplicateFilter::Clear()
+{
+	_ids.clear();
+	_expiryQueue.clear();
+}
+
+inline void DuplicateFilter::Expire(Clock::time_point now)
+{
+	while (!_expiryQueue.empty() &&
+	       now - _expiryQueue.front().time > _window) {
+		_ids.erase(_expiryQueue.front().id);
+		_expiryQueue.pop_front();
+	}
+}
+
+} // namespace advss
@@ -0,0 +1,155 @@
+#include "lane-executor.hpp"
+
+#include <algorithm>
+
+namespace advss {
+
+LaneExecutor::LaneExecutor(size_t threadCount)
+{
+	threadCount = std::max<size_t>(threadCount, 1);
+	for (size_t i = 0; i < threadCount; i++) {
+		_threads.emplace_back(&LaneExecutor::Worker, this);
+	}
+}
+
+LaneExecutor::~LaneExecutor()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_cv.notify_all();
+	for (auto &thread : _threads) {
+		if (thread.joinable()) {
+			thread.join();
+		}
+	}
+}
+
+void LaneExecutor::Submit(Lane lane, std::function<void()> &&func,
+			  bool exclusive)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_queue.push_back({lane, exclusive, std::move(func)});
+		_lanes[lane].queued++;
+	}
+	_cv.notify_all();
+}
+
+bool LaneExecutor::IsBusy(Lane lane) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto it = _lanes.find(lane);
+	return it != _lanes.end() &&
+	       (it->second.queued > 0 || it->second.running);
+}
+
+size_t LaneExecutor::RemoveQueuedTasks(Lane lane)
+{
+	auto it = _lanes.find(lane);
+	if (it == _lanes.end()) {
+		return 0;
+	}
+	const size_t removed = it->second.queued;
+	_queue.erase(std::remove_if(_queue.begin(), _queue.end(),
+				    [lane](const Task &task) {
+					    return task.lane == lane;
+				    }),
+		     _queue.end());
+	it->second.queued = 0;
+	if (!it->second.running) {
+		_lanes.erase(it);
+	}
+	return removed;
+}
+
+bool LaneExecutor::Cancel(Lane lane)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	const bool removed = RemoveQueuedTasks(lane) > 0;
+	// Removing queued tasks might allow tasks behind them to start
+	_cv.notify_all();
+	_idleCv.notify_all();
+
+	auto it = _lanes.find(lane);
+	if (it == _lanes.end() ||
+	    it->second.thread == std::this_thread::get_id()) {
+		return removed;
+	}
+	_idleCv.wait(lock, [this, lane]() { return _lanes.count(lane) == 0; });
+	return removed;
+}
+
+void LaneExecutor::WaitUntilIdle()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_idleCv.wait(lock,
+		     [this]() { return _queue.empty() && _activeTasks == 0; });
+}
+
+std::deque<LaneExecutor::Task>::iterator LaneExecutor::FindRunnableTask()
+{
+	if (_exclusiveActive) {
+		return _queue.end();
+	}
+	for (auto it = _queue.begin(); it != _queue.end(); ++it) {
+		if (it->exclusive) {
+			// Tasks queued after an exclusive task have to wait for
+			// it, so it cannot be starved by other lanes
+			return _activeTasks == 0 ? it : _queue.end();
+		}
+		if (!_lanes[it->lane].running) {
+			return it;
+		}
+	}
+	return _queue.end();
+}
+
+void LaneExecutor::Worker()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (true) {
+		auto it = _queue.end();
+		_cv.wait(lock, [this, &it]() {
+			if (_stop) {
+				return true;
+			}
+			it = FindRunnableTask();
+			return it != _queue.end();
+		});
+		if (_stop) {
+			return;
+		}
+
+		auto task = std::move(*it);
+		_queue.erase(it);
+		auto &lane = _lanes[task.lane];
+		lane.queued--;
+		lane.running = true;
+		lane.thread = std::this_thread::get_id();
+		_activeTasks++;
+		_exclusiveActive = task.exclusive;
+
+		lock.unlock();
+		task.func();
+		lock.lock();
+
+		auto laneIt = _lanes.find(task.lane);
+		if (laneIt != _lanes.end()) {
+			laneIt->second.running = false;
+			laneIt->second.thread = {};
+			if (laneIt->second.queued == 0) {
+				_lanes.erase(laneIt);
+			}
+		}
+		_activeTasks--;
+		if (task.exclusive) {
+			_exclusiveActive = false;
+		}
+		_cv.notify_all();
+		_idleCv.notify_all();
+	}
+}
+
+} // namespace advss
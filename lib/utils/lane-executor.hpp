@@ -0,0 +1,70 @@
+#pragma once
+#include "export-symbol-helper.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace advss {
+
+// Runs tasks on a fixed number of worker threads.
+//
+// Each task belongs to a lane. Tasks of the same lane are run in the order
+// they were submitted and never overlap, while tasks of different lanes can
+// run concurrently.
+// Exclusive tasks only start once all running tasks have completed and no
+// other task is started until they are done.
+class LaneExecutor {
+public:
+	using Lane = const void *;
+
+	EXPORT LaneExecutor(size_t threadCount);
+	EXPORT ~LaneExecutor();
+	LaneExecutor(const LaneExecutor &) = delete;
+	LaneExecutor &operator=(const LaneExecutor &) = delete;
+
+	EXPORT void Submit(Lane, std::function<void()> &&,
+			   bool exclusive = false);
+	// Returns true if tasks of the lane are queued or running
+	EXPORT bool IsBusy(Lane) const;
+	// Drops the queued tasks of the lane and waits for the running one to
+	// complete, unless it is called from within that task.
+	// Returns true if queued tasks were dropped.
+	EXPORT bool Cancel(Lane);
+	// Blocks until all queued tasks were processed
+	EXPORT void WaitUntilIdle();
+	size_t ThreadCount() const { return _threads.size(); }
+
+private:
+	struct Task {
+		Lane lane;
+		bool exclusive;
+		std::function<void()> func;
+	};
+
+	struct LaneState {
+		size_t queued = 0;
+		bool running = false;
+		std::thread::id thread;
+	};
+
+	void Worker();
+	std::deque<Task>::iterator FindRunnableTask();
+	size_t RemoveQueuedTasks(Lane);
+
+	std::deque<Task> _queue;
+	std::unordered_map<Lane, LaneState> _lanes;
+	size_t _activeTasks = 0;
+	bool _exclusiveActive = false;
+	mutable std::mutex _mutex;
+	std::condition_variable _cv;
+	std::condition_variable _idleCv;
+	bool _stop = false;
+	std::vector<std::thread> _threads;
+};
+
+} // namespace advss
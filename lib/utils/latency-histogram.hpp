@@ -0,0 +1,110 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+namespace advss {
+
+// Histogram of durations with logarithmically sized buckets.
+//
+// Bucket i counts durations in the range of [2^(i-1), 2^i) microseconds with
+// bucket 0 counting everything below one microsecond, so the memory usage is
+// constant no matter how many durations are recorded.
+class LatencyHistogram {
+public:
+	static constexpr size_t bucketCount = 32;
+
+	void Record(std::chrono::microseconds);
+	void Clear() { *this = {}; }
+
+	uint64_t Count() const { return _count; }
+	std::chrono::microseconds Min() const;
+	std::chrono::microseconds Max() const { return _max; }
+	std::chrono::microseconds Mean() const;
+	// Percentile in the range of [0, 100]
+	// Returns the upper bound of the bucket the percentile falls into
+	std::chrono::microseconds Percentile(double percentile) const;
+
+	const std::array<uint64_t, bucketCount> &Buckets() const
+	{
+		return _buckets;
+	}
+	// Exclusive upper bound of the durations counted in the given bucket
+	static std::chrono::microseconds BucketUpperBound(size_t bucket);
+
+private:
+	static size_t GetBucket(std::chrono::microseconds);
+
+	std::array<uint64_t, bucketCount> _buckets{};
+	uint64_t _count = 0;
+	std::chrono::microseconds _sum{0};
+	std::chrono::microseconds _min{std::chrono::microseconds::max()};
+	std::chrono::microseconds _max{0};
+};
+
+inline size_t LatencyHistogram::GetBucket(std::chrono::microseconds duration)
+{
+	auto value = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+	size_t bucket = 0;
+	while (value > 0 && bucket < bucketCount - 1) {
+		value >>= 1;
+		++bucket;
+	}
+	return bucket;
+}
+
+inline std::chrono::microseconds
+LatencyHistogram::BucketUpperBound(size_t bucket)
+{
+	if (bucket >= bucketCount - 1) {
+		return std::chrono::microseconds::max();
+	}
+	return std::chrono::microseconds(int64_t(1) << bucket);
+}
+
+inline void LatencyHistogram::Record(std::chrono::microseconds duration)
+{
+	duration = std::max(duration, std::chrono::microseconds(0));
+	++_buckets[GetBucket(duration)];
+	++_count;
+	_sum += duration;
+	_min = std::min(_min, duration);
+	_max = std::max(_max, duration);
+}
+
+inline std::chrono::microseconds LatencyHistogram::Min() const
+{
+	return _count == 0 ? std::chrono::microseconds(0) : _min;
+}
+
+inline std::chrono::microseconds LatencyHistogram::Mean() const
+{
+	if (_count == 0) {
+		return std::chrono::microseconds(0);
+	}
+	return _sum / static_cast<int64_t>(_count);
+}
+
+inline std::chrono::microseconds
+LatencyHistogram::Percentile(double percentile) const
+{
+	if (_count == 0) {
+		return std::chrono::microseconds(0);
+	}
+	percentile = std::clamp(percentile, 0.0, 100.0);
+	const auto rank = std::max<uint64_t>(
+		static_cast<uint64_t>(percentile / 100.0 * _count + 0.5), 1);
+	uint64_t seen = 0;
+	for (size_t i = 0; i < bucketCount; ++i) {
+		seen += _buckets[i];
+		if (seen >= rank) {
+			// The recorded maximum is a tighter bound than the bucket
+			return std::min(BucketUpperBound(i), _max);
+		}
+	}
+	return _max;
+}
+
+} // namespace advss
@@ -1,4 +1,5 @@
 #pragma once
+#include <chrono>
 #include <deque>
 #include <mutex>
 #include <optional>
@@ -7,13 +8,22 @@ namespace advss {
 
 template<class T> class MessageBuffer {
 public:
+	using Clock = std::chrono::steady_clock;
+
 	bool Empty();
 	void Clear();
 	void AppendMessage(const T &);
 	std::optional<T> ConsumeMessage();
+	// Also returns the time at which the message was appended
+	std::optional<T> ConsumeMessage(Clock::time_point &arrival);
 
 private:
-	std::deque<T> _buffer;
+	struct Entry {
+		T message;
+		Clock::time_point arrival;
+	};
+
+	std::deque<Entry> _buffer;
 	std::mutex _mutex;
 };
 
@@ -31,17 +41,27 @@ template<class T> inline void MessageBuffer<T>::Clear()
 
 template<class T> inline void MessageBuffer<T>::AppendMessage(const T &message)
 {
+	const auto arrival = Clock::now();
 	std::lock_guard<std::mutex> lock(_mutex);
-	_buffer.emplace_back(message);
+	_buffer.push_back({message, arrival});
 }
 
 template<class T> inline std::optional<T> MessageBuffer<T>::ConsumeMessage()
+{
+	Clock::time_point arrival;
+	return ConsumeMessage(arrival);
+}
+
+template<class T>
+inline std::optional<T>
+MessageBuffer<T>::ConsumeMessage(Clock::time_point &arrival)
 {
 	std::lock_guard<std::mutex> lock(_mutex);
 	if (_buffer.empty()) {
 		return {};
 	}
-	T message = _buffer.at(0);
+	T message = std::move(_buffer.front().message);
+	arrival = _buffer.front().arrival;
 	_buffer.pop_front();
 	return message;
 }
@@ -3,42 +3,69 @@
 
 #include <algorithm>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace advss {
 
-template<class T> class MessageDispatcher {
+// Clients can either receive all messages or register with a routing key.
+// Clients registered with a key only receive messages which are dispatched
+// with the same key, so no copies are made for clients which are not
+// interested in a message.
+template<class T, class Key = std::string> class MessageDispatcher {
 public:
 	[[nodiscard]] std::shared_ptr<MessageBuffer<T>> RegisterClient();
+	[[nodiscard]] std::shared_ptr<MessageBuffer<T>>
+	RegisterClient(const Key &key);
+	// Only delivered to clients registered without a key
 	void DispatchMessage(const T &message);
+	// Delivered to clients registered without a key and to clients
+	// registered with the given key
+	void DispatchMessage(const T &message, const Key &key);
+	// Only delivered to clients registered with the given key
+	void DispatchMessageToKey(const T &message, const Key &key);
 
 private:
-	std::vector<std::weak_ptr<MessageBuffer<T>>> _clients;
+	using ClientList = std::vector<std::weak_ptr<MessageBuffer<T>>>;
+
+	static void RemoveExpiredClients(ClientList &);
+	static void DeliverMessage(const ClientList &, const T &);
+	void RemoveExpiredKeyedClients();
+
+	ClientList _clients;
+	std::unordered_map<Key, ClientList> _keyedClients;
 	std::mutex _mutex;
 };
 
-template<class T>
-inline std::shared_ptr<MessageBuffer<T>> MessageDispatcher<T>::RegisterClient()
+template<class T, class Key>
+inline void MessageDispatcher<T, Key>::RemoveExpiredClients(ClientList &clients)
 {
-	std::lock_guard<std::mutex> lock(_mutex);
-	// Clear expired client buffers
 	auto isExpired = [](const std::weak_ptr<MessageBuffer<T>> &ptr) {
 		return ptr.expired();
 	};
-	_clients.erase(std::remove_if(_clients.begin(), _clients.end(),
-				      isExpired),
-		       _clients.end());
-	// Prepare new buffer for client
-	auto buffer = std::make_shared<MessageBuffer<T>>();
-	_clients.emplace_back(buffer);
-	return buffer;
+	clients.erase(std::remove_if(clients.begin(), clients.end(), isExpired),
+		      clients.end());
 }
 
-template<class T>
-inline void MessageDispatcher<T>::DispatchMessage(const T &message)
+template<class T, class Key>
+inline void MessageDispatcher<T, Key>::RemoveExpiredKeyedClients()
 {
-	std::lock_guard<std::mutex> lock(_mutex);
-	for (auto &client_ : _clients) {
+	for (auto it = _keyedClients.begin(); it != _keyedClients.end();) {
+		RemoveExpiredClients(it->second);
+		if (it->second.empty()) {
+			it = _keyedClients.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+template<class T, class Key>
+inline void MessageDispatcher<T, Key>::DeliverMessage(const ClientList &clients,
+						      const T &message)
+{
+	for (auto &client_ : clients) {
 		auto client = client_.lock();
 		if (!client) {
 			continue;
@@ -47,4 +74,62 @@ inline void MessageDispatcher<T>::DispatchMessage(const T &message)
 	}
 }
 
+template<class T, class Key>
+inline std::shared_ptr<MessageBuffer<T>>
+MessageDispatcher<T, Key>::RegisterClient()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	// Clear expired client buffers
+	RemoveExpiredClients(_clients);
+	RemoveExpiredKeyedClients();
+	// Prepare new buffer for client
+	auto buffer = std::make_shared<MessageBuffer<T>>();
+	_clients.emplace_back(buffer);
+	return buffer;
+}
+
+template<class T, class Key>
+inline std::shared_ptr<MessageBuffer<T>>
+MessageDispatcher<T, Key>::RegisterClient(const Key &key)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	// Clear expired client buffers
+	RemoveExpiredClients(_clients);
+	RemoveExpiredKeyedClients();
+	// Prepare new buffer for client
+	auto buffer = std::make_shared<MessageBuffer<T>>();
+	_keyedClients[key].emplace_back(buffer);
+	return buffer;
+}
+
+template<class T, class Key>
+inline void MessageDispatcher<T, Key>::DispatchMessage(const T &message)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	DeliverMessage(_clients, message);
+}
+
+template<class T, class Key>
+inline void MessageDispatcher<T, Key>::DispatchMessage(const T &message,
+						       const Key &key)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	DeliverMessage(_clients, message);
+	auto it = _keyedClients.find(key);
+	if (it != _keyedClients.end()) {
+		DeliverMessage(it->second, message);
+	}
+}
+
+template<class T, class Key>
+inline void MessageDispatcher<T, Key>::DispatchMessageToKey(const T &message,
+							    const Key &key)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto it = _keyedClients.find(key);
+	if (it != _keyedClients.end()) {
+		DeliverMessage(it->second, message);
+	}
+}
+
 } // namespace advss
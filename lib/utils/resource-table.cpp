@@ -1,10 +1,12 @@
 #include "resource-table.hpp"
+#include "obs-module-helper.hpp"
 #include "plugin-state-helpers.hpp"
 #include "resource-table-hotkey-handler.hpp"
 #include "ui-helpers.hpp"
 
 #include <QGridLayout>
 #include <QHeaderView>
+#include <QSortFilterProxyModel>
 
 namespace advss {
 
@@ -14,10 +16,48 @@ ResourceTable::ResourceTable(QTabWidget *parent, const QString &help,
 			     const QStringList &headers,
 			     const std::function<void()> &openSettings)
 	: QWidget(parent),
-	  _table(new QTableWidget()),
+	  _view(new QTableWidget()),
 	  _add(new QToolButton()),
 	  _remove(new QToolButton()),
 	  _help(new QLabel(help))
+{
+	_table = static_cast<QTableWidget *>(_view);
+	_table->setColumnCount(headers.size());
+	_table->setHorizontalHeaderLabels(headers);
+	SetupLayout(addToolTip, removeToolTip, openSettings);
+}
+
+ResourceTable::ResourceTable(QTabWidget *parent, const QString &help,
+			     const QString &addToolTip,
+			     const QString &removeToolTip,
+			     QAbstractItemModel *model,
+			     const std::function<void()> &openSettings)
+	: QWidget(parent),
+	  _view(new QTableView()),
+	  _add(new QToolButton()),
+	  _remove(new QToolButton()),
+	  _help(new QLabel(help))
+{
+	_view->setModel(model);
+	auto proxyModel = qobject_cast<QSortFilterProxyModel *>(model);
+	if (proxyModel) {
+		_filter = new QLineEdit();
+		_filter->setPlaceholderText(obs_module_text(
+			"AdvSceneSwitcher.resourceTable.filter"));
+		_filter->setClearButtonEnabled(true);
+		QWidget::connect(_filter, &QLineEdit::textChanged, proxyModel,
+				 [proxyModel](const QString &text) {
+					 proxyModel->setFilterFixedString(text);
+				 });
+		_view->setSortingEnabled(true);
+		_view->sortByColumn(0, Qt::AscendingOrder);
+	}
+	SetupLayout(addToolTip, removeToolTip, openSettings);
+}
+
+void ResourceTable::SetupLayout(const QString &addToolTip,
+				const QString &removeToolTip,
+				const std::function<void()> &openSettings)
 {
 	_add->setProperty("themeID",
 			  QVariant(QString::fromUtf8("addIconSmall")));
@@ -30,19 +70,17 @@ ResourceTable::ResourceTable(QTabWidget *parent, const QString &help,
 	_help->setWordWrap(true);
 	_help->setAlignment(Qt::AlignCenter);
 
-	_table->setColumnCount(headers.size());
-	_table->horizontalHeader()->setSectionResizeMode(
+	_view->horizontalHeader()->setSectionResizeMode(
 		QHeaderView::ResizeMode::Interactive);
-	_table->setHorizontalHeaderLabels(headers);
-	_table->verticalHeader()->hide();
-	_table->setCornerButtonEnabled(false);
-	_table->setShowGrid(false);
-	_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
-	_table->setSelectionBehavior(QAbstractItemView::SelectRows);
+	_view->verticalHeader()->hide();
+	_view->setCornerButtonEnabled(false);
+	_view->setShowGrid(false);
+	_view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+	_view->setSelectionBehavior(QAbstractItemView::SelectRows);
 
 	auto helpAndTableLayout = new QGridLayout();
 	helpAndTableLayout->setContentsMargins(0, 0, 0, 0);
-	helpAndTableLayout->addWidget(_table, 0, 0);
+	helpAndTableLayout->addWidget(_view, 0, 0);
 	helpAndTableLayout->addWidget(_help, 0, 0, Qt::AlignCenter);
 
 	auto controlLayout = new QHBoxLayout;
@@ -50,6 +88,9 @@ ResourceTable::ResourceTable(QTabWidget *parent, const QString &help,
 	controlLayout->addWidget(_add);
 	controlLayout->addWidget(_remove);
 	controlLayout->addStretch();
+	if (_filter) {
+		controlLayout->addWidget(_filter);
+	}
 
 	auto layout = new QVBoxLayout();
 	layout->addLayout(helpAndTableLayout);
@@ -58,7 +99,7 @@ ResourceTable::ResourceTable(QTabWidget *parent, const QString &help,
 
 	QWidget::connect(_add, SIGNAL(clicked()), this, SLOT(Add()));
 	QWidget::connect(_remove, SIGNAL(clicked()), this, SLOT(Remove()));
-	QWidget::connect(_table, &QTableWidget::cellDoubleClicked,
+	QWidget::connect(_view, &QTableView::doubleClicked,
 			 [openSettings]() { openSettings(); });
 
 	RegisterHotkeyFunction(this, Qt::Key_F2, openSettings);
@@ -89,10 +130,13 @@ void ResourceTable::HighlightAddButton(bool enable)
 
 void ResourceTable::resizeEvent(QResizeEvent *)
 {
-	const auto columnCount = _table->columnCount();
-	const auto columnSize = (_table->width() - 1) / columnCount;
+	const auto columnCount = _view->model()->columnCount();
+	if (columnCount == 0) {
+		return;
+	}
+	const auto columnSize = (_view->width() - 1) / columnCount;
 	for (int i = 0; i < columnCount; ++i) {
-		_table->horizontalHeader()->resizeSection(i, columnSize);
+		_view->horizontalHeader()->resizeSection(i, columnSize);
 	}
 }
 
@@ -2,11 +2,13 @@
 #include "export-symbol-helper.hpp"
 
 #include <QLabel>
+#include <QLineEdit>
 #include <QString>
 #include <QToolButton>
 #include <QTableWidget>
 
 class QResizeEvent;
+class QSortFilterProxyModel;
 
 namespace advss {
 
@@ -18,9 +20,18 @@ public:
 		      const QString &addToolTip, const QString &removeToolTip,
 		      const QStringList &headers,
 		      const std::function<void()> &openSettings);
+	// Display the contents of the given model instead of managing the
+	// table cells directly.
+	// A filter input is added if a proxy model is used.
+	ResourceTable(QTabWidget *parent, const QString &help,
+		      const QString &addToolTip, const QString &removeToolTip,
+		      QAbstractItemModel *model,
+		      const std::function<void()> &openSettings);
 	virtual ~ResourceTable();
 
+	// Only valid if no model was passed in the constructor
 	QTableWidget *Table() const { return _table; }
+	QTableView *View() const { return _view; }
 	void SetHelpVisible(bool) const;
 	void HighlightAddButton(bool);
 
@@ -32,7 +43,13 @@ protected:
 	void resizeEvent(QResizeEvent *event);
 
 private:
-	QTableWidget *_table;
+	void SetupLayout(const QString &addToolTip,
+			 const QString &removeToolTip,
+			 const std::function<void()> &openSettings);
+
+	QTableView *_view;
+	QTableWidget *_table = nullptr;
+	QLineEdit *_filter = nullptr;
 	QToolButton *_add;
 	QToolButton *_remove;
 	QLabel *_help;
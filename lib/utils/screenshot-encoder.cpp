@@ -0,0 +1,224 @@
+#include "screenshot-encoder.hpp"
+#include "log-helper.hpp"
+
+#include <algorithm>
+#include <string_view>
+#include <QFile>
+
+namespace advss {
+
+ScreenshotEncoder::ScreenshotEncoder(size_t maxQueued, size_t threadCount)
+	: _maxQueued(std::max<size_t>(maxQueued, 1))
+{
+	threadCount = std::max<size_t>(threadCount, 1);
+	for (size_t i = 0; i < threadCount; i++) {
+		_threads.emplace_back(&ScreenshotEncoder::Worker, this);
+	}
+}
+
+ScreenshotEncoder::~ScreenshotEncoder()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_cv.notify_all();
+	for (auto &thread : _threads) {
+		if (thread.joinable()) {
+			thread.join();
+		}
+	}
+}
+
+ScreenshotEncoder &ScreenshotEncoder::Instance()
+{
+	static ScreenshotEncoder encoder;
+	return encoder;
+}
+
+static void replaceAll(std::string &str, std::string_view from,
+		       const std::string &to)
+{
+	size_t pos = 0;
+	while ((pos = str.find(from, pos)) != std::string::npos) {
+		str.replace(pos, from.size(), to);
+		pos += to.size();
+	}
+}
+
+std::string ScreenshotEncoder::FormatPath(const std::string &pathTemplate,
+					  uint64_t counter,
+					  const QDateTime &time)
+{
+	std::string path = pathTemplate;
+	std::string counterString = std::to_string(counter);
+	if (counterString.size() < 6) {
+		counterString.insert(0, 6 - counterString.size(), '0');
+	}
+	replaceAll(path, "{counter}", counterString);
+	replaceAll(path, "{timestamp}",
+		   time.toString("yyyyMMdd-HHmmss-zzz").toStdString());
+	return path;
+}
+
+bool ScreenshotEncoder::Enqueue(QImage &&image,
+				const std::string &pathTemplate,
+				const Settings &settings)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_queue.size() >= _maxQueued) {
+			++_dropped;
+			blog(LOG_WARNING,
+			     "dropped screenshot for \"%s\" - encoder queue is full",
+			     pathTemplate.c_str());
+			return false;
+		}
+		_queue.push_back({std::move(image),
+				  QDateTime::currentDateTime(), pathTemplate,
+				  settings});
+	}
+	_cv.notify_one();
+	return true;
+}
+
+void ScreenshotEncoder::WaitUntilIdle()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_idleCv.wait(lock,
+		     [this]() { return _queue.empty() && _activeJobs == 0; });
+}
+
+size_t ScreenshotEncoder::QueuedCount() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _queue.size();
+}
+
+std::deque<ScreenshotEncoder::Job>::iterator ScreenshotEncoder::NextJob()
+{
+	return std::find_if(_queue.begin(), _queue.end(),
+			    [this](const Job &job) {
+				    return !_history[job.pathTemplate].busy;
+			    });
+}
+
+void ScreenshotEncoder::Worker()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (true) {
+		_cv.wait(lock, [this]() {
+			return _stop || NextJob() != _queue.end();
+		});
+		if (_stop) {
+			return;
+		}
+
+		auto it = NextJob();
+		auto job = std::move(*it);
+		_queue.erase(it);
+		// History entries are never removed, so the reference stays
+		// valid and only this worker accesses the entry while it is
+		// marked as busy
+		auto &history = _history[job.pathTemplate];
+		history.busy = true;
+		++_activeJobs;
+
+		lock.unlock();
+		Process(job, history);
+		lock.lock();
+
+		history.busy = false;
+		--_activeJobs;
+		if (_queue.empty() && _activeJobs == 0) {
+			_idleCv.notify_all();
+		}
+		// Images of the same path template might have been waiting
+		_cv.notify_all();
+	}
+}
+
+static size_t hashImage(const QImage &image)
+{
+	const std::string_view data(
+		reinterpret_cast<const char *>(image.constBits()),
+		static_cast<size_t>(image.sizeInBytes()));
+	return std::hash<std::string_view>{}(data) ^
+	       (static_cast<size_t>(image.width()) << 16) ^
+	       static_cast<size_t>(image.height());
+}
+
+bool ScreenshotEncoder::IsDuplicate(const Job &job, History &history)
+{
+	if (!job.settings.skipDuplicates) {
+		return false;
+	}
+
+	const auto hash = hashImage(job.image);
+	if (history.lastHash == hash) {
+		return true;
+	}
+	history.lastHash = hash;
+	return false;
+}
+
+void ScreenshotEncoder::RotateFiles(const Job &job, const std::string &path,
+				    History &history)
+{
+	if (job.settings.keepCount <= 0) {
+		return;
+	}
+
+	auto &files = history.files;
+	// The same file might be overwritten if the path template contains no
+	// placeholders
+	files.erase(std::remove(files.begin(), files.end(), path), files.end());
+	files.push_back(path);
+	while (files.size() > (size_t)job.settings.keepCount) {
+		QFile::remove(QString::fromStdString(files.front()));
+		files.pop_front();
+	}
+}
+
+static const char *getFormatName(ScreenshotEncoder::Format format)
+{
+	switch (format) {
+	case ScreenshotEncoder::Format::PNG:
+		return "PNG";
+	case ScreenshotEncoder::Format::JPEG:
+		return "JPG";
+	case ScreenshotEncoder::Format::WEBP:
+		return "WEBP";
+	default:
+		return nullptr;
+	}
+}
+
+void ScreenshotEncoder::Process(Job &job, History &history)
+{
+	if (IsDuplicate(job, history)) {
+		++_skipped;
+		vblog(LOG_INFO, "skipped unchanged screenshot for \"%s\"",
+		      job.pathTemplate.c_str());
+		return;
+	}
+
+	const auto path =
+		FormatPath(job.pathTemplate, history.counter + 1, job.time);
+	const int quality = std::clamp(job.settings.quality, -1, 100);
+	if (!job.image.save(QString::fromStdString(path),
+			    getFormatName(job.settings.format), quality)) {
+		++_failed;
+		blog(LOG_WARNING,
+		     "Failed to save screenshot to \"%s\"!\nMaybe unknown format?",
+		     path.c_str());
+		return;
+	}
+
+	++history.counter;
+	++_written;
+	vblog(LOG_INFO, "Wrote screenshot to \"%s\"", path.c_str());
+	RotateFiles(job, path, history);
+}
+
+} // namespace advss
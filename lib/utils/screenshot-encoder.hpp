@@ -0,0 +1,121 @@
+#pragma once
+#include "export-symbol-helper.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <QDateTime>
+#include <QImage>
+
+namespace advss {
+
+// Encodes screenshots and writes them to disk on a pool of worker threads,
+// so capturing a screenshot does not have to wait for the encoder.
+// Images of the same path template are processed one at a time and in the
+// order they were queued.
+//
+// The number of queued images is limited and images are dropped instead of
+// queued if the encoder cannot keep up.
+class ScreenshotEncoder {
+public:
+	enum class Format {
+		// Determined by the file extension
+		AUTO,
+		PNG,
+		JPEG,
+		WEBP,
+	};
+
+	struct Settings {
+		Format format = Format::AUTO;
+		// In the range of [0, 100] or -1 for the format's default.
+		// For PNG lower values result in smaller files, but slower
+		// encoding.
+		int quality = -1;
+		// Skip images identical to the last image saved for the same
+		// path template
+		bool skipDuplicates = false;
+		// Number of most recent files to keep per path template.
+		// Older files are deleted and 0 keeps all files.
+		int keepCount = 0;
+	};
+
+	static constexpr size_t defaultMaxQueued = 8;
+	static constexpr size_t defaultThreadCount = 2;
+
+	EXPORT ScreenshotEncoder(size_t maxQueued = defaultMaxQueued,
+				 size_t threadCount = defaultThreadCount);
+	EXPORT ~ScreenshotEncoder();
+	ScreenshotEncoder(const ScreenshotEncoder &) = delete;
+	ScreenshotEncoder &operator=(const ScreenshotEncoder &) = delete;
+
+	// The "{timestamp}" placeholder of FormatPath() is replaced with the
+	// time the image was queued and "{counter}" only counts images which
+	// were actually written.
+	// Returns false and drops the image if the queue is full.
+	EXPORT bool Enqueue(QImage &&, const std::string &pathTemplate,
+			    const Settings &);
+	// Blocks until all queued images were processed
+	EXPORT void WaitUntilIdle();
+	EXPORT size_t QueuedCount() const;
+	uint64_t WrittenCount() const { return _written; }
+	uint64_t SkippedCount() const { return _skipped; }
+	uint64_t DroppedCount() const { return _dropped; }
+	uint64_t FailedCount() const { return _failed; }
+
+	// Shared instance used for screenshots saved by macros
+	EXPORT static ScreenshotEncoder &Instance();
+
+	// Replaces "{counter}" with the zero padded counter and "{timestamp}"
+	// with the given time
+	EXPORT static std::string FormatPath(const std::string &pathTemplate,
+					     uint64_t counter,
+					     const QDateTime &time);
+
+private:
+	struct Job {
+		QImage image;
+		QDateTime time;
+		std::string pathTemplate;
+		Settings settings;
+	};
+
+	// State kept per path template
+	struct History {
+		uint64_t counter = 0;
+		std::optional<size_t> lastHash;
+		std::deque<std::string> files;
+		// Set while a worker processes an image of this template
+		bool busy = false;
+	};
+
+	void Worker();
+	// Returns the first queued job whose path template is not busy
+	std::deque<Job>::iterator NextJob();
+	void Process(Job &, History &);
+	bool IsDuplicate(const Job &, History &);
+	void RotateFiles(const Job &, const std::string &path, History &);
+
+	const size_t _maxQueued;
+	std::deque<Job> _queue;
+	size_t _activeJobs = 0;
+	std::unordered_map<std::string, History> _history;
+	mutable std::mutex _mutex;
+	std::condition_variable _cv;
+	std::condition_variable _idleCv;
+	bool _stop = false;
+	std::vector<std::thread> _threads;
+
+	std::atomic<uint64_t> _written = 0;
+	std::atomic<uint64_t> _skipped = 0;
+	std::atomic<uint64_t> _dropped = 0;
+	std::atomic<uint64_t> _failed = 0;
+};
+
+} // namespace advss
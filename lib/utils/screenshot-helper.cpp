@@ -7,14 +7,16 @@ namespace advss {
 
 static void ScreenshotTick(void *param, float);
 
-ScreenshotHelper::ScreenshotHelper(obs_source_t *source, const QRect &subarea,
-				   bool blocking, int timeout, bool saveToFile,
-				   std::string path)
+ScreenshotHelper::ScreenshotHelper(
+	obs_source_t *source, const QRect &subarea, bool blocking, int timeout,
+	bool saveToFile, std::string path,
+	const ScreenshotEncoder::Settings &encoderSettings)
 	: weakSource(OBSGetWeakRef(source)),
 	  _subarea(subarea),
 	  _blocking(blocking),
 	  _saveToFile(saveToFile),
-	  _path(path)
+	  _path(path),
+	  _encoderSettings(encoderSettings)
 {
 	std::unique_lock<std::mutex> lock(_mutex);
 	_initDone = true;
@@ -44,9 +46,6 @@ ScreenshotHelper::~ScreenshotHelper()
 		obs_leave_graphics();
 	}
 	obs_remove_tick_callback(ScreenshotTick, this);
-	if (_saveThread.joinable()) {
-		_saveThread.join();
-	}
 }
 
 void ScreenshotHelper::Screenshot()
@@ -148,16 +147,9 @@ void ScreenshotHelper::WriteToFile()
 		return;
 	}
 
-	_saveThread = std::thread([this]() {
-		if (image.save(QString::fromStdString(_path))) {
-			vblog(LOG_INFO, "Wrote screenshot to \"%s\"",
-			      _path.c_str());
-		} else {
-			blog(LOG_WARNING,
-			     "Failed to save screenshot to \"%s\"!\nMaybe unknown format?",
-			     _path.c_str());
-		}
-	});
+	// Encoding is done asynchronously by the encoder's worker threads
+	ScreenshotEncoder::Instance().Enqueue(QImage(image), _path,
+					      _encoderSettings);
 }
 
 #define STAGE_SCREENSHOT 0
@@ -1,4 +1,6 @@
 #pragma once
+#include "screenshot-encoder.hpp"
+
 #include <obs.hpp>
 #include <string>
 #include <QImage>
@@ -15,7 +17,9 @@ public:
 	EXPORT ScreenshotHelper(obs_source_t *source,
 				const QRect &subarea = QRect(),
 				bool blocking = false, int timeout = 1000,
-				bool saveToFile = false, std::string path = "");
+				bool saveToFile = false, std::string path = "",
+				const ScreenshotEncoder::Settings &
+					encoderSettings = {});
 	EXPORT ScreenshotHelper &operator=(const ScreenshotHelper &) = delete;
 	EXPORT ScreenshotHelper(const ScreenshotHelper &) = delete;
 	EXPORT ~ScreenshotHelper();
@@ -42,9 +46,9 @@ private:
 	std::atomic_bool _initDone = false;
 	QRect _subarea = QRect();
 	bool _blocking = false;
-	std::thread _saveThread;
 	bool _saveToFile = false;
 	std::string _path = "";
+	ScreenshotEncoder::Settings _encoderSettings;
 	std::mutex _mutex;
 	std::condition_variable _cv;
 };
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace advss {
+
+// Holds an immutable snapshot of a value, which writers replace as a whole.
+// Readers keep using the snapshot they acquired for as long as they need it,
+// so they neither have to copy the value nor block writers while using it.
+//
+// The version is incremented whenever a new snapshot is published.
+template<typename T> class Snapshot {
+public:
+	using Ptr = std::shared_ptr<const T>;
+
+	Snapshot() : _value(std::make_shared<const T>()) {}
+	Snapshot(const Snapshot &) = delete;
+	Snapshot &operator=(const Snapshot &) = delete;
+
+	Ptr Get() const;
+	uint64_t Version() const;
+	void Publish(T value);
+
+private:
+	mutable std::mutex _mutex;
+	Ptr _value;
+	uint64_t _version = 0;
+};
+
+template<typename T> inline typename Snapshot<T>::Ptr Snapshot<T>::Get() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _value;
+}
+
+template<typename T> inline uint64_t Snapshot<T>::Version() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _version;
+}
+
+template<typename T> inline void Snapshot<T>::Publish(T value)
+{
+	// Create the new snapshot before locking to keep the critical section
+	// short, and release the old one after unlocking, as that might
+	// destroy the last reference to it
+	Ptr snapshot = std::make_shared<const T>(std::move(value));
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_value.swap(snapshot);
+		++_version;
+	}
+}
+
+} // namespace advss
@@ -6,8 +6,9 @@ namespace advss {
 
 VariableLineEdit::VariableLineEdit(QWidget *parent) : QLineEdit(parent)
 {
-	QLineEdit::setToolTip(
-		obs_module_text("AdvSceneSwitcher.tooltip.availableVariables"));
+	UpdateToolTip();
+	QWidget::connect(this, SIGNAL(textChanged(const QString &)), this,
+			 SLOT(UpdateToolTip()));
 
 	QWidget::connect(this, SIGNAL(inputRejected()), this,
 			 SLOT(DisplayValidationMessages()));
@@ -25,9 +26,20 @@ void VariableLineEdit::setText(const StringVariable &string)
 
 void VariableLineEdit::setToolTip(const QString &string)
 {
-	QLineEdit::setToolTip(
-		string + "\n" +
-		obs_module_text("AdvSceneSwitcher.tooltip.availableVariables"));
+	_toolTip = string;
+	UpdateToolTip();
+}
+
+void VariableLineEdit::UpdateToolTip()
+{
+	QString toolTip = _toolTip.isEmpty() ? "" : _toolTip + "\n";
+	toolTip +=
+		obs_module_text("AdvSceneSwitcher.tooltip.availableVariables");
+	const auto warning = GetUnknownVariablesWarning(text().toStdString());
+	if (!warning.isEmpty()) {
+		toolTip += "\n" + warning;
+	}
+	QLineEdit::setToolTip(toolTip);
 }
 
 void VariableLineEdit::DisplayValidationMessages()
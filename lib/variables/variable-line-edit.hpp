@@ -15,8 +15,10 @@ public:
 
 private slots:
 	void DisplayValidationMessages();
+	void UpdateToolTip();
 
 private:
+	QString _toolTip;
 };
 
 } // namespace advss
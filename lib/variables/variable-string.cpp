@@ -1,18 +1,17 @@
 #include "variable-string.hpp"
-#include "utility.hpp"
 
 namespace advss {
 
 void StringVariable::Resolve() const
 {
-	if (GetVariables().empty()) {
+	if (GetVariables().empty() || !_template.HasReferences()) {
 		_resolvedValue = _value;
 		return;
 	}
 	if (_lastResolve == GetLastVariableChangeTime()) {
 		return;
 	}
-	_resolvedValue = SubstitueVariables(_value);
+	_resolvedValue = _template.Resolve();
 	_lastResolve = GetLastVariableChangeTime();
 }
 
@@ -30,18 +29,22 @@ StringVariable::operator QVariant() const
 void StringVariable::operator=(std::string value)
 {
 	_value = value;
+	_template = VariableTemplate(_value);
 	_lastResolve = {};
 }
 
 void StringVariable::operator=(const char *value)
 {
 	_value = value;
+	_template = VariableTemplate(_value);
 	_lastResolve = {};
 }
 
 void StringVariable::Load(obs_data_t *obj, const char *name)
 {
 	_value = obs_data_get_string(obj, name);
+	_template = VariableTemplate(_value);
+	_lastResolve = {};
 	Resolve();
 }
 
@@ -54,6 +57,7 @@ void StringVariable::ResolveVariables()
 {
 	Resolve();
 	_value = _resolvedValue;
+	_template = VariableTemplate(_value);
 }
 
 const char *StringVariable::c_str()
@@ -76,14 +80,7 @@ bool StringVariable::empty() const
 
 std::string SubstitueVariables(std::string str)
 {
-	for (const auto &v : GetVariables()) {
-		const auto &variable = std::dynamic_pointer_cast<Variable>(v);
-		const std::string pattern = "${" + variable->Name() + "}";
-		if (ReplaceAll(str, pattern, variable->Value(false))) {
-			variable->UpdateLastUsed();
-		}
-	}
-	return str;
+	return VariableTemplate(str).Resolve();
 }
 
 } // namespace advss
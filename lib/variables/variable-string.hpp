@@ -1,5 +1,6 @@
 #pragma once
 #include "variable.hpp"
+#include "variable-template.hpp"
 
 #include <string>
 #include <obs-data.h>
@@ -12,8 +13,12 @@ namespace advss {
 class StringVariable {
 public:
 	EXPORT StringVariable() : _value(""){};
-	EXPORT StringVariable(std::string str) : _value(std::move(str)){};
-	EXPORT StringVariable(const char *str) : _value(str){};
+	EXPORT StringVariable(std::string str)
+		: _value(std::move(str)),
+		  _template(_value){};
+	EXPORT StringVariable(const char *str)
+		: _value(str),
+		  _template(_value){};
 	EXPORT operator std::string() const;
 	EXPORT operator QVariant() const;
 	EXPORT void operator=(std::string);
@@ -33,6 +38,8 @@ private:
 	void Resolve() const;
 
 	std::string _value = "";
+	// Compiled from _value whenever it changes
+	VariableTemplate _template;
 	mutable std::string _resolvedValue = "";
 	mutable std::chrono::high_resolution_clock::time_point _lastResolve{};
 };
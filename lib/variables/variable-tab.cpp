@@ -35,7 +35,12 @@ static void setTabVisible(QTabWidget *tabWidget, bool visible)
 
 VariableTable *VariableTable::Create()
 {
-	tabWidget = new VariableTable();
+	auto model = new VariableTableModel();
+	auto proxyModel = new QSortFilterProxyModel();
+	proxyModel->setSourceModel(model);
+	proxyModel->setFilterKeyColumn(-1);
+	proxyModel->setFilterCaseSensitivity(Qt::CaseInsensitive);
+	tabWidget = new VariableTable(model, proxyModel);
 	return tabWidget;
 }
 
@@ -124,93 +129,252 @@ static QString formatLastChangedTooltip(Variable *variable)
 		.arg(QString::fromStdString(variable->GetPreviousValue()));
 }
 
-static QStringList getCellLabels(Variable *variable, bool addName = true)
+enum class Column {
+	NAME,
+	VALUE,
+	SAVE_ACTION,
+	LAST_USED,
+	LAST_CHANGED,
+	COUNT,
+};
+
+static QString getCellText(Variable *variable, Column column)
 {
 	assert(variable);
 
-	auto result = QStringList();
-	if (addName) {
-		result << QString::fromStdString(variable->Name());
+	switch (column) {
+	case Column::NAME:
+		return QString::fromStdString(variable->Name());
+	case Column::VALUE:
+		return QString::fromStdString(variable->Value(false));
+	case Column::SAVE_ACTION:
+		return formatSaveActionText(variable);
+	case Column::LAST_USED:
+		return formatLastUsedText(variable);
+	case Column::LAST_CHANGED:
+		return formatLastChangedText(variable);
+	default:
+		break;
 	}
-	result << QString::fromStdString(variable->Value(false))
-	       << formatSaveActionText(variable) << formatLastUsedText(variable)
-	       << formatLastChangedText(variable);
-	return result;
+	return QString();
+}
+
+VariableTableModel::VariableTableModel(QObject *parent)
+	: QAbstractTableModel(parent)
+{
+	// Changes to variable values are collected for one frame before the
+	// corresponding rows are updated
+	_updateTimer.setSingleShot(true);
+	_updateTimer.setInterval(16);
+	connect(&_updateTimer, &QTimer::timeout, this,
+		&VariableTableModel::UpdateChangedVariables);
+	connect(VariableSignalManager::Instance(),
+		&VariableSignalManager::ValuesChanged, this,
+		&VariableTableModel::ScheduleUpdate, Qt::QueuedConnection);
+
+	for (const auto &variable : GetVariables()) {
+		_variables.emplace_back(
+			std::static_pointer_cast<Variable>(variable));
+	}
+	RebuildRowIndex();
+	ConsumeChangedVariables();
+}
+
+int VariableTableModel::rowCount(const QModelIndex &parent) const
+{
+	return parent.isValid() ? 0 : (int)_variables.size();
+}
+
+int VariableTableModel::columnCount(const QModelIndex &parent) const
+{
+	return parent.isValid() ? 0 : static_cast<int>(Column::COUNT);
+}
+
+QVariant VariableTableModel::data(const QModelIndex &index, int role) const
+{
+	if (role != Qt::DisplayRole && role != Qt::ToolTipRole) {
+		return QVariant();
+	}
+
+	auto variable = GetVariable(index.row());
+	if (!variable) {
+		return QVariant();
+	}
+
+	const auto column = static_cast<Column>(index.column());
+	if (role == Qt::ToolTipRole && column == Column::LAST_CHANGED) {
+		return formatLastChangedTooltip(variable.get());
+	}
+	return getCellText(variable.get(), column);
 }
 
-static void updateVariableStatus(QTableWidget *table)
+QVariant VariableTableModel::headerData(int section,
+					Qt::Orientation orientation,
+					int role) const
 {
-	for (int row = 0; row < table->rowCount(); row++) {
-		auto item = table->item(row, 0);
-		if (!item) {
+	if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+		return QVariant();
+	}
+
+	switch (static_cast<Column>(section)) {
+	case Column::NAME:
+		return obs_module_text(
+			"AdvSceneSwitcher.variableTab.name.header");
+	case Column::VALUE:
+		return obs_module_text(
+			"AdvSceneSwitcher.variableTab.value.header");
+	case Column::SAVE_ACTION:
+		return obs_module_text(
+			"AdvSceneSwitcher.variableTab.saveLoadBehavior.header");
+	case Column::LAST_USED:
+		return obs_module_text(
+			"AdvSceneSwitcher.variableTab.lastUsed.header");
+	case Column::LAST_CHANGED:
+		return obs_module_text(
+			"AdvSceneSwitcher.variableTab.lastChanged.header");
+	default:
+		break;
+	}
+	return QVariant();
+}
+
+std::shared_ptr<Variable> VariableTableModel::GetVariable(int row) const
+{
+	if (row < 0 || row >= (int)_variables.size()) {
+		return {};
+	}
+	return _variables[row].lock();
+}
+
+void VariableTableModel::AddVariable(const QString &name)
+{
+	auto variable = GetWeakVariableByQString(name).lock();
+	if (!variable || _rowIndex.count(variable.get()) != 0) {
+		return;
+	}
+
+	const int row = (int)_variables.size();
+	beginInsertRows(QModelIndex(), row, row);
+	_variables.emplace_back(variable);
+	_rowIndex[variable.get()] = row;
+	endInsertRows();
+}
+
+void VariableTableModel::RemoveVariable(const QString &name)
+{
+	// The variable might already be deleted at this point so also remove
+	// all rows referencing expired variables
+	const auto nameStr = name.toStdString();
+	for (int row = (int)_variables.size() - 1; row >= 0; --row) {
+		auto variable = _variables[row].lock();
+		if (variable && variable->Name() != nameStr) {
 			continue;
 		}
+		beginRemoveRows(QModelIndex(), row, row);
+		_variables.erase(_variables.begin() + row);
+		endRemoveRows();
+	}
+	RebuildRowIndex();
+}
 
-		auto weakVariable = GetWeakVariableByQString(item->text());
-		auto variable = weakVariable.lock();
-		if (!variable) {
+void VariableTableModel::UpdateVariable(const QString &name)
+{
+	auto variable = GetVariableByQString(name);
+	auto it = _rowIndex.find(variable);
+	if (it == _rowIndex.end()) {
+		return;
+	}
+	UpdateRow(it->second);
+}
+
+void VariableTableModel::ScheduleUpdate()
+{
+	if (!_updateTimer.isActive()) {
+		_updateTimer.start();
+	}
+}
+
+void VariableTableModel::UpdateChangedVariables()
+{
+	const auto changedVariables = ConsumeChangedVariables();
+	for (const auto variable : changedVariables) {
+		auto it = _rowIndex.find(variable);
+		if (it == _rowIndex.end()) {
 			continue;
 		}
+		UpdateRow(it->second);
+	}
+}
 
-		UpdateItemTableRow(table, row,
-				   getCellLabels(variable.get(), false));
+void VariableTableModel::UpdateRow(int row)
+{
+	emit dataChanged(index(row, 0),
+			 index(row, static_cast<int>(Column::COUNT) - 1));
+}
 
-		// Special tooltip handling for the "last used" cell
-		const auto lastUsedItem = table->item(row, 4);
-		if (!lastUsedItem) {
+void VariableTableModel::RebuildRowIndex()
+{
+	_rowIndex.clear();
+	for (int row = 0; row < (int)_variables.size(); ++row) {
+		auto variable = _variables[row].lock();
+		if (!variable) {
 			continue;
 		}
-		const auto lastUsedTooltip =
-			formatLastChangedTooltip(variable.get());
-		lastUsedItem->setToolTip(lastUsedTooltip);
+		_rowIndex[variable.get()] = row;
 	}
 }
 
-static void openSettingsDialog()
+static std::vector<std::shared_ptr<Variable>> getSelectedVariables()
 {
+	std::vector<std::shared_ptr<Variable>> result;
 	auto selectedRows =
-		tabWidget->Table()->selectionModel()->selectedRows();
-	if (selectedRows.empty()) {
-		return;
+		tabWidget->View()->selectionModel()->selectedRows();
+	for (const auto &index : selectedRows) {
+		auto sourceIndex = tabWidget->ProxyModel()->mapToSource(index);
+		auto variable =
+			tabWidget->Model()->GetVariable(sourceIndex.row());
+		if (!variable) {
+			continue;
+		}
+		result.emplace_back(variable);
 	}
+	return result;
+}
 
-	auto cell = tabWidget->Table()->item(selectedRows.last().row(), 0);
-	if (!cell) {
+static void openSettingsDialog()
+{
+	auto selectedVariables = getSelectedVariables();
+	if (selectedVariables.empty()) {
 		return;
 	}
 
-	auto weakVariable = GetWeakVariableByQString(cell->text());
-	auto variable = weakVariable.lock();
-	if (!variable) {
+	auto variable = selectedVariables.back();
+	auto oldName = variable->Name();
+	bool accepted = VariableSettingsDialog::AskForSettings(
+		tabWidget->View(), *variable.get());
+	if (!accepted) {
 		return;
 	}
 
-	auto oldName = variable->Name();
-	bool accepted = VariableSettingsDialog::AskForSettings(
-		tabWidget->Table(), *variable.get());
-	if (accepted && oldName != variable->Name()) {
+	if (oldName != variable->Name()) {
 		VariableSignalManager::Instance()->Rename(
 			QString::fromStdString(oldName),
 			QString::fromStdString(variable->Name()));
 	}
+	tabWidget->Model()->UpdateVariable(
+		QString::fromStdString(variable->Name()));
 }
 
 void VariableTable::Remove()
 {
-	auto selectedRows =
-		tabWidget->Table()->selectionModel()->selectedRows();
-	if (selectedRows.empty()) {
+	auto selectedVariables = getSelectedVariables();
+	if (selectedVariables.empty()) {
 		return;
 	}
 
 	QStringList varNames;
-	for (const auto &row : selectedRows) {
-		auto cell = tabWidget->Table()->item(row.row(), 0);
-		if (!cell) {
-			continue;
-		}
-
-		varNames << cell->text();
+	for (const auto &variable : selectedVariables) {
+		varNames << QString::fromStdString(variable->Name());
 	}
 
 	int varNameCount = varNames.size();
@@ -238,31 +402,21 @@ void VariableTable::Remove()
 	}
 }
 
-VariableTable::VariableTable(QTabWidget *parent)
+VariableTable::VariableTable(VariableTableModel *model,
+			     QSortFilterProxyModel *proxyModel,
+			     QTabWidget *parent)
 	: ResourceTable(
 		  parent, obs_module_text("AdvSceneSwitcher.variableTab.help"),
 		  obs_module_text(
 			  "AdvSceneSwitcher.variableTab.variableAddButton.tooltip"),
 		  obs_module_text(
 			  "AdvSceneSwitcher.variableTab.variableRemoveButton.tooltip"),
-		  QStringList()
-			  << obs_module_text(
-				     "AdvSceneSwitcher.variableTab.name.header")
-			  << obs_module_text(
-				     "AdvSceneSwitcher.variableTab.value.header")
-			  << obs_module_text(
-				     "AdvSceneSwitcher.variableTab.saveLoadBehavior.header")
-			  << obs_module_text(
-				     "AdvSceneSwitcher.variableTab.lastUsed.header")
-			  << obs_module_text(
-				     "AdvSceneSwitcher.variableTab.lastChanged.header"),
-		  openSettingsDialog)
+		  proxyModel, openSettingsDialog),
+	  _model(model),
+	  _proxyModel(proxyModel)
 {
-	for (const auto &variable : GetVariables()) {
-		auto v = std::static_pointer_cast<Variable>(variable);
-		AddItemTableRow(Table(), getCellLabels(v.get()));
-	}
-
+	_model->setParent(this);
+	_proxyModel->setParent(this);
 	SetHelpVisible(GetVariables().empty());
 }
 
@@ -274,34 +428,33 @@ static void setupTab(QTabWidget *tab)
 
 	QWidget::connect(VariableSignalManager::Instance(),
 			 &VariableSignalManager::Rename, tab,
-			 [](const QString &oldName, const QString &newName) {
-				 RenameItemTableRow(tabWidget->Table(), oldName,
-						    newName);
+			 [](const QString &, const QString &newName) {
+				 tabWidget->Model()->UpdateVariable(newName);
+			 });
+	QWidget::connect(VariableSignalManager::Instance(),
+			 &VariableSignalManager::Add, tab,
+			 [tab](const QString &name) {
+				 tabWidget->Model()->AddVariable(name);
+				 tabWidget->SetHelpVisible(false);
+				 tabWidget->HighlightAddButton(false);
+				 setTabVisible(tab, true);
 			 });
-	QWidget::connect(
-		VariableSignalManager::Instance(), &VariableSignalManager::Add,
-		tab, [tab](const QString &name) {
-			AddItemTableRow(
-				tabWidget->Table(),
-				getCellLabels(GetVariableByQString(name)));
-			tabWidget->SetHelpVisible(false);
-			tabWidget->HighlightAddButton(false);
-			setTabVisible(tab, true);
-		});
 	QWidget::connect(VariableSignalManager::Instance(),
 			 &VariableSignalManager::Remove, tab,
 			 [](const QString &name) {
-				 RemoveItemTableRow(tabWidget->Table(), name);
-				 if (tabWidget->Table()->rowCount() == 0) {
+				 tabWidget->Model()->RemoveVariable(name);
+				 if (tabWidget->Model()->rowCount() == 0) {
 					 tabWidget->SetHelpVisible(true);
 					 tabWidget->HighlightAddButton(true);
 				 }
 			 });
 
+	// Value changes are pushed by the variables themselves, so only the
+	// time based columns of the visible rows have to be refreshed here
 	auto timer = new QTimer(tabWidget);
 	timer->setInterval(1000);
 	QWidget::connect(timer, &QTimer::timeout,
-			 []() { updateVariableStatus(tabWidget->Table()); });
+			 []() { tabWidget->View()->viewport()->update(); });
 	timer->start();
 }
 
@@ -1,20 +1,68 @@
 #pragma once
 #include "resource-table.hpp"
 
+#include <QAbstractTableModel>
+#include <QSortFilterProxyModel>
+#include <QTimer>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 namespace advss {
 
+class Variable;
+
+class VariableTableModel final : public QAbstractTableModel {
+	Q_OBJECT
+
+public:
+	VariableTableModel(QObject *parent = nullptr);
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	int columnCount(
+		const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index,
+		      int role = Qt::DisplayRole) const override;
+	QVariant headerData(int section, Qt::Orientation orientation,
+			    int role = Qt::DisplayRole) const override;
+
+	std::shared_ptr<Variable> GetVariable(int row) const;
+	void AddVariable(const QString &name);
+	void RemoveVariable(const QString &name);
+	void UpdateVariable(const QString &name);
+
+private slots:
+	void ScheduleUpdate();
+	void UpdateChangedVariables();
+
+private:
+	void UpdateRow(int row);
+	void RebuildRowIndex();
+
+	std::vector<std::weak_ptr<Variable>> _variables;
+	std::unordered_map<const Variable *, int> _rowIndex;
+	QTimer _updateTimer;
+};
+
 class VariableTable final : public ResourceTable {
 	Q_OBJECT
 
 public:
 	static VariableTable *Create();
+	VariableTableModel *Model() const { return _model; }
+	QSortFilterProxyModel *ProxyModel() const { return _proxyModel; }
 
 private slots:
 	void Add();
 	void Remove();
 
 private:
-	VariableTable(QTabWidget *parent = nullptr);
+	VariableTable(VariableTableModel *model,
+		      QSortFilterProxyModel *proxyModel,
+		      QTabWidget *parent = nullptr);
+
+	VariableTableModel *_model;
+	QSortFilterProxyModel *_proxyModel;
 };
 
 } // namespace advss
@@ -0,0 +1,151 @@
+#include "variable-template.hpp"
+#include "obs-module-helper.hpp"
+#include "variable.hpp"
+
+#include <string_view>
+
+namespace advss {
+
+VariableTemplate::VariableTemplate(const std::string &text) : _text(text)
+{
+	Parse();
+}
+
+void VariableTemplate::Parse()
+{
+	static constexpr std::string_view prefix = "${";
+
+	size_t literalBegin = 0;
+	size_t pos = _text.find(prefix);
+	while (pos != std::string::npos) {
+		const size_t nameBegin = pos + prefix.size();
+		const size_t end = _text.find('}', nameBegin);
+		if (end == std::string::npos) {
+			break;
+		}
+
+		// Continue with the innermost reference for text like "${a${b}"
+		const size_t nested = _text.find(prefix, nameBegin);
+		if (nested < end) {
+			pos = nested;
+			continue;
+		}
+
+		AddLiteral(literalBegin, pos - literalBegin);
+		AddReference(pos, end + 1 - pos,
+			     _text.substr(nameBegin, end - nameBegin));
+		literalBegin = end + 1;
+		pos = _text.find(prefix, literalBegin);
+	}
+	AddLiteral(literalBegin, _text.size() - literalBegin);
+}
+
+void VariableTemplate::AddLiteral(size_t begin, size_t length)
+{
+	if (length == 0) {
+		return;
+	}
+	_tokens.push_back({begin, length, -1});
+	_literalLength += length;
+}
+
+void VariableTemplate::AddReference(size_t begin, size_t length,
+				    std::string &&name)
+{
+	int idx = 0;
+	for (; idx < (int)_references.size(); idx++) {
+		if (_references[idx].name == name) {
+			break;
+		}
+	}
+	if (idx == (int)_references.size()) {
+		_references.push_back({std::move(name), {}});
+	}
+	_tokens.push_back({begin, length, idx});
+}
+
+void VariableTemplate::Bind() const
+{
+	const auto version = GetVariableListVersion();
+	if (version == _boundVersion) {
+		return;
+	}
+	for (auto &reference : _references) {
+		reference.variable = GetWeakVariableByName(reference.name);
+	}
+	_boundVersion = version;
+}
+
+std::string VariableTemplate::Resolve() const
+{
+	if (_references.empty()) {
+		return _text;
+	}
+
+	Bind();
+
+	// Look up each referenced variable only once, even if it is used
+	// multiple times
+	std::vector<std::string> values(_references.size());
+	std::vector<bool> known(_references.size(), false);
+	size_t size = _literalLength;
+	for (size_t i = 0; i < _references.size(); i++) {
+		const auto &reference = _references[i];
+		auto variable = reference.variable.lock();
+		if (!variable) {
+			continue;
+		}
+		values[i] = variable->Value(false);
+		variable->UpdateLastUsed();
+		known[i] = true;
+	}
+	for (const auto &token : _tokens) {
+		if (token.reference < 0) {
+			continue;
+		}
+		size += known[token.reference] ? values[token.reference].size()
+					       : token.length;
+	}
+
+	std::string result;
+	result.reserve(size);
+	for (const auto &token : _tokens) {
+		if (token.reference < 0 || !known[token.reference]) {
+			result.append(_text, token.begin, token.length);
+			continue;
+		}
+		result.append(values[token.reference]);
+	}
+	return result;
+}
+
+std::vector<std::string> VariableTemplate::GetUnknownVariables() const
+{
+	Bind();
+
+	std::vector<std::string> result;
+	for (const auto &reference : _references) {
+		if (reference.variable.expired()) {
+			result.emplace_back(reference.name);
+		}
+	}
+	return result;
+}
+
+QString GetUnknownVariablesWarning(const std::string &text)
+{
+	const auto unknown = VariableTemplate(text).GetUnknownVariables();
+	if (unknown.empty()) {
+		return "";
+	}
+
+	QStringList names;
+	for (const auto &name : unknown) {
+		names << QString::fromStdString(name);
+	}
+	return QString(obs_module_text(
+			       "AdvSceneSwitcher.tooltip.unknownVariables"))
+		.arg(names.join(", "));
+}
+
+} // namespace advss
@@ -0,0 +1,62 @@
+#pragma once
+#include "export-symbol-helper.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <QString>
+
+namespace advss {
+
+class Variable;
+
+// Text containing "${name}" variable references, which is split into literal
+// spans and references only once.
+// Resolving the text then only requires a single pass over these tokens
+// instead of searching the text for every existing variable.
+//
+// References to variables which do not exist are kept as is.
+class VariableTemplate {
+public:
+	VariableTemplate() = default;
+	EXPORT VariableTemplate(const std::string &text);
+
+	EXPORT std::string Resolve() const;
+	bool HasReferences() const { return !_references.empty(); }
+	// Returns the names of referenced variables which do not exist
+	EXPORT std::vector<std::string> GetUnknownVariables() const;
+	const std::string &Text() const { return _text; }
+
+private:
+	struct Token {
+		// Span of _text, which is also used for references to unknown
+		// variables
+		size_t begin = 0;
+		size_t length = 0;
+		// Index into _references or -1 for literal spans
+		int reference = -1;
+	};
+
+	struct Reference {
+		std::string name;
+		mutable std::weak_ptr<Variable> variable;
+	};
+
+	void Parse();
+	void AddLiteral(size_t begin, size_t length);
+	void AddReference(size_t begin, size_t length, std::string &&name);
+	void Bind() const;
+
+	std::string _text;
+	std::vector<Token> _tokens;
+	// One entry per referenced variable name
+	std::vector<Reference> _references;
+	size_t _literalLength = 0;
+	mutable uint64_t _boundVersion = 0;
+};
+
+// Returns a warning listing the unknown variables referenced in the text or
+// an empty string if all referenced variables exist
+EXPORT QString GetUnknownVariablesWarning(const std::string &text);
+
+} // namespace advss
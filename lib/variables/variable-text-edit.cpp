@@ -7,8 +7,9 @@ VariableTextEdit::VariableTextEdit(QWidget *parent, const int scrollAt,
 				   const int minLines, const int paddingLines)
 	: ResizingPlainTextEdit(parent, scrollAt, minLines, paddingLines)
 {
-	QPlainTextEdit::setToolTip(
-		obs_module_text("AdvSceneSwitcher.tooltip.availableVariables"));
+	UpdateToolTip();
+	QWidget::connect(this, SIGNAL(textChanged()), this,
+			 SLOT(UpdateToolTip()));
 }
 
 void VariableTextEdit::setPlainText(const QString &string)
@@ -24,9 +25,21 @@ void VariableTextEdit::setPlainText(const StringVariable &string)
 
 void VariableTextEdit::setToolTip(const QString &string)
 {
-	QPlainTextEdit::setToolTip(
-		string + "\n" +
-		obs_module_text("AdvSceneSwitcher.tooltip.availableVariables"));
+	_toolTip = string;
+	UpdateToolTip();
+}
+
+void VariableTextEdit::UpdateToolTip()
+{
+	QString toolTip = _toolTip.isEmpty() ? "" : _toolTip + "\n";
+	toolTip +=
+		obs_module_text("AdvSceneSwitcher.tooltip.availableVariables");
+	const auto warning =
+		GetUnknownVariablesWarning(toPlainText().toStdString());
+	if (!warning.isEmpty()) {
+		toolTip += "\n" + warning;
+	}
+	QPlainTextEdit::setToolTip(toolTip);
 }
 
 } // namespace advss
@@ -14,7 +14,11 @@ public:
 	EXPORT void setPlainText(const StringVariable &);
 	EXPORT void setToolTip(const QString &string);
 
+private slots:
+	void UpdateToolTip();
+
 private:
+	QString _toolTip;
 };
 
 } // namespace advss
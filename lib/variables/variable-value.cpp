@@ -0,0 +1,413 @@
+#include "variable-value.hpp"
+#include "math-helpers.hpp"
+#include "utility.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <nlohmann/json.hpp>
+
+namespace advss {
+
+static std::optional<int64_t> parseInt(const std::string &str)
+{
+	char *end = nullptr;
+	errno = 0;
+	long long value = std::strtoll(str.c_str(), &end, 10);
+	if (end == str.c_str() || *end != '\0' || errno == ERANGE) {
+		return {};
+	}
+	return value;
+}
+
+static std::optional<int64_t> toInt(double value)
+{
+	if (!std::isfinite(value) || std::trunc(value) != value ||
+	    value < (double)std::numeric_limits<int64_t>::min() ||
+	    value >= (double)std::numeric_limits<int64_t>::max()) {
+		return {};
+	}
+	return static_cast<int64_t>(value);
+}
+
+VariableValue VariableValue::FromString(const std::string &value)
+{
+	VariableValue result;
+	result._value = value;
+	return result;
+}
+
+VariableValue VariableValue::FromInt(int64_t value)
+{
+	VariableValue result;
+	result._value = value;
+	return result;
+}
+
+VariableValue VariableValue::FromDouble(double value)
+{
+	VariableValue result;
+	result._value = value;
+	return result;
+}
+
+VariableValue VariableValue::FromBool(bool value)
+{
+	VariableValue result;
+	result._value = value;
+	return result;
+}
+
+VariableValue VariableValue::FromJson(const nlohmann::json &value)
+{
+	VariableValue result;
+	result._value = std::make_shared<const nlohmann::json>(value);
+	return result;
+}
+
+VariableValue VariableValue::FromList(List value)
+{
+	VariableValue result;
+	result._value = std::move(value);
+	return result;
+}
+
+VariableValue VariableValue::FromMap(Map value)
+{
+	VariableValue result;
+	result._value = std::move(value);
+	return result;
+}
+
+static std::string jsonElementToString(const nlohmann::json &json)
+{
+	if (json.is_string()) {
+		return json.get<std::string>();
+	}
+	return json.dump();
+}
+
+const std::string &VariableValue::String() const
+{
+	if (auto value = std::get_if<std::string>(&_value)) {
+		return *value;
+	}
+	if (_string) {
+		return *_string;
+	}
+
+	switch (GetType()) {
+	case Type::INT:
+		_string = std::to_string(std::get<int64_t>(_value));
+		break;
+	case Type::DOUBLE:
+		_string = ToString(std::get<double>(_value));
+		break;
+	case Type::BOOL:
+		_string = std::get<bool>(_value) ? "true" : "false";
+		break;
+	case Type::JSON: {
+		const auto &json = std::get<JsonPtr>(_value);
+		if (!json) {
+			_string = "";
+		} else {
+			_string = jsonElementToString(*json);
+		}
+		break;
+	}
+	case Type::LIST:
+	case Type::MAP:
+		_string = Json()->dump();
+		break;
+	default:
+		_string = "";
+		break;
+	}
+	return *_string;
+}
+
+std::optional<double> VariableValue::Double() const
+{
+	switch (GetType()) {
+	case Type::STRING:
+		if (!_number) {
+			_number = GetDouble(std::get<std::string>(_value));
+		}
+		return *_number;
+	case Type::INT:
+		return static_cast<double>(std::get<int64_t>(_value));
+	case Type::DOUBLE:
+		return std::get<double>(_value);
+	case Type::JSON: {
+		const auto &json = std::get<JsonPtr>(_value);
+		if (!json || !json->is_number()) {
+			return {};
+		}
+		return json->get<double>();
+	}
+	default:
+		return {};
+	}
+}
+
+std::optional<int64_t> VariableValue::Int() const
+{
+	switch (GetType()) {
+	case Type::STRING:
+		return parseInt(std::get<std::string>(_value));
+	case Type::INT:
+		return std::get<int64_t>(_value);
+	case Type::DOUBLE:
+		return toInt(std::get<double>(_value));
+	case Type::JSON: {
+		const auto &json = std::get<JsonPtr>(_value);
+		if (!json || !json->is_number()) {
+			return {};
+		}
+		if (json->is_number_integer()) {
+			return json->get<int64_t>();
+		}
+		return toInt(json->get<double>());
+	}
+	default:
+		return {};
+	}
+}
+
+std::shared_ptr<const nlohmann::json> VariableValue::Json() const
+{
+	if (auto json = std::get_if<JsonPtr>(&_value)) {
+		return *json;
+	}
+	if (_json) {
+		return *_json;
+	}
+
+	switch (GetType()) {
+	case Type::STRING:
+		try {
+			_json = std::make_shared<const nlohmann::json>(
+				nlohmann::json::parse(
+					std::get<std::string>(_value)));
+		} catch (const nlohmann::json::exception &) {
+			_json = nullptr;
+		}
+		break;
+	case Type::INT:
+		_json = std::make_shared<const nlohmann::json>(
+			std::get<int64_t>(_value));
+		break;
+	case Type::DOUBLE:
+		_json = std::make_shared<const nlohmann::json>(
+			std::get<double>(_value));
+		break;
+	case Type::BOOL:
+		_json = std::make_shared<const nlohmann::json>(
+			std::get<bool>(_value));
+		break;
+	case Type::LIST:
+		_json = std::make_shared<const nlohmann::json>(
+			std::get<List>(_value));
+		break;
+	case Type::MAP:
+		_json = std::make_shared<const nlohmann::json>(
+			std::get<Map>(_value));
+		break;
+	default:
+		_json = nullptr;
+		break;
+	}
+	return *_json;
+}
+
+std::optional<size_t> VariableValue::Size() const
+{
+	if (auto list = std::get_if<List>(&_value)) {
+		return list->size();
+	}
+	if (auto map = std::get_if<Map>(&_value)) {
+		return map->size();
+	}
+	auto json = Json();
+	if (!json || !(json->is_array() || json->is_object())) {
+		return {};
+	}
+	return json->size();
+}
+
+std::optional<std::string> VariableValue::At(size_t index) const
+{
+	if (auto list = std::get_if<List>(&_value)) {
+		if (index >= list->size()) {
+			return {};
+		}
+		return (*list)[index];
+	}
+	if (GetType() == Type::MAP) {
+		return {};
+	}
+	auto json = Json();
+	if (!json || !json->is_array() || index >= json->size()) {
+		return {};
+	}
+	return jsonElementToString((*json)[index]);
+}
+
+std::optional<std::string> VariableValue::Find(const std::string &key) const
+{
+	if (auto map = std::get_if<Map>(&_value)) {
+		auto it = map->find(key);
+		if (it == map->end()) {
+			return {};
+		}
+		return it->second;
+	}
+	if (GetType() == Type::LIST) {
+		return {};
+	}
+	auto json = Json();
+	if (!json || !json->is_object()) {
+		return {};
+	}
+	auto it = json->find(key);
+	if (it == json->end()) {
+		return {};
+	}
+	return jsonElementToString(*it);
+}
+
+bool VariableValue::Contains(const std::string &value) const
+{
+	if (auto list = std::get_if<List>(&_value)) {
+		return std::find(list->begin(), list->end(), value) !=
+		       list->end();
+	}
+	if (auto map = std::get_if<Map>(&_value)) {
+		return map->count(value) > 0;
+	}
+	auto json = Json();
+	if (!json) {
+		return false;
+	}
+	if (json->is_object()) {
+		return json->contains(value);
+	}
+	if (!json->is_array()) {
+		return false;
+	}
+	return std::any_of(json->begin(), json->end(),
+			   [&value](const nlohmann::json &element) {
+				   return jsonElementToString(element) == value;
+			   });
+}
+
+std::optional<std::vector<std::string>> VariableValue::Elements() const
+{
+	if (auto list = std::get_if<List>(&_value)) {
+		return std::vector<std::string>(list->begin(), list->end());
+	}
+	if (auto map = std::get_if<Map>(&_value)) {
+		std::vector<std::string> keys;
+		keys.reserve(map->size());
+		for (const auto &[key, _] : *map) {
+			keys.emplace_back(key);
+		}
+		return keys;
+	}
+	auto json = Json();
+	if (!json || !(json->is_array() || json->is_object())) {
+		return {};
+	}
+	std::vector<std::string> elements;
+	elements.reserve(json->size());
+	for (auto it = json->begin(); it != json->end(); ++it) {
+		elements.emplace_back(json->is_object()
+					      ? it.key()
+					      : jsonElementToString(*it));
+	}
+	return elements;
+}
+
+VariableValue::List *VariableValue::EditList()
+{
+	if (GetType() != Type::LIST) {
+		if (GetType() == Type::MAP) {
+			return nullptr;
+		}
+		if (IsEmptyString()) {
+			_value = List();
+		} else {
+			auto json = Json();
+			if (!json || !json->is_array()) {
+				return nullptr;
+			}
+			List list;
+			for (const auto &element : *json) {
+				list.emplace_back(jsonElementToString(element));
+			}
+			_value = std::move(list);
+		}
+	}
+	ClearCache();
+	return &std::get<List>(_value);
+}
+
+VariableValue::Map *VariableValue::EditMap()
+{
+	if (GetType() != Type::MAP) {
+		if (GetType() == Type::LIST) {
+			return nullptr;
+		}
+		if (IsEmptyString()) {
+			_value = Map();
+		} else {
+			auto json = Json();
+			if (!json || !json->is_object()) {
+				return nullptr;
+			}
+			Map map;
+			map.reserve(json->size());
+			for (auto it = json->begin(); it != json->end(); ++it) {
+				map.emplace(it.key(),
+					    jsonElementToString(it.value()));
+			}
+			_value = std::move(map);
+		}
+	}
+	ClearCache();
+	return &std::get<Map>(_value);
+}
+
+bool VariableValue::IsEmptyString() const
+{
+	auto value = std::get_if<std::string>(&_value);
+	return value && value->empty();
+}
+
+void VariableValue::ClearCache()
+{
+	_string.reset();
+	_number.reset();
+	_json.reset();
+}
+
+bool VariableValue::operator==(const VariableValue &other) const
+{
+	if (GetType() != other.GetType()) {
+		return String() == other.String();
+	}
+
+	if (GetType() == Type::JSON) {
+		const auto &json = std::get<JsonPtr>(_value);
+		const auto &otherJson = std::get<JsonPtr>(other._value);
+		if (json == otherJson) {
+			return true;
+		}
+		return json && otherJson && *json == *otherJson;
+	}
+	return _value == other._value;
+}
+
+} // namespace advss
@@ -0,0 +1,95 @@
+#pragma once
+#include "export-symbol-helper.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <nlohmann/json_fwd.hpp>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace advss {
+
+// Holds the value of a variable in its native representation.
+// The string representation of non-string values is only created when it is
+// requested and is cached afterwards, as is the result of interpreting a
+// string value as a number or JSON.
+//
+// Lists and maps are represented as JSON arrays and objects of strings.
+//
+// Not thread safe - access has to be synchronized by the owner.
+class VariableValue {
+public:
+	enum class Type {
+		STRING,
+		INT,
+		DOUBLE,
+		BOOL,
+		JSON,
+		LIST,
+		MAP,
+	};
+
+	using List = std::deque<std::string>;
+	using Map = std::unordered_map<std::string, std::string>;
+
+	VariableValue() = default;
+	EXPORT static VariableValue FromString(const std::string &);
+	EXPORT static VariableValue FromInt(int64_t);
+	EXPORT static VariableValue FromDouble(double);
+	EXPORT static VariableValue FromBool(bool);
+	EXPORT static VariableValue FromJson(const nlohmann::json &);
+	EXPORT static VariableValue FromList(List);
+	EXPORT static VariableValue FromMap(Map);
+
+	Type GetType() const { return static_cast<Type>(_value.index()); }
+	EXPORT const std::string &String() const;
+	EXPORT std::optional<double> Double() const;
+	EXPORT std::optional<int64_t> Int() const;
+	// Returns nullptr if the value cannot be interpreted as JSON
+	EXPORT std::shared_ptr<const nlohmann::json> Json() const;
+
+	// Element access for lists and maps.
+	// JSON arrays and objects are supported as well, but are slower to
+	// access, as the value first has to be interpreted as JSON.
+	EXPORT std::optional<size_t> Size() const;
+	EXPORT std::optional<std::string> At(size_t index) const;
+	EXPORT std::optional<std::string> Find(const std::string &key) const;
+	// Checks the list elements or map keys
+	EXPORT bool Contains(const std::string &) const;
+	// Returns the list elements or map keys
+	EXPORT std::optional<std::vector<std::string>> Elements() const;
+
+	// Convert the value to a list or map, if it is not one already, and
+	// return it for modification.
+	// Only JSON arrays or objects and empty values can be converted.
+	// Returns nullptr if the conversion is not possible.
+	// The returned pointer is invalidated by any other non-const call.
+	EXPORT List *EditList();
+	EXPORT Map *EditMap();
+
+	EXPORT bool operator==(const VariableValue &) const;
+	bool operator!=(const VariableValue &other) const
+	{
+		return !(*this == other);
+	}
+
+private:
+	using JsonPtr = std::shared_ptr<const nlohmann::json>;
+
+	// Order has to match the Type enum
+	std::variant<std::string, int64_t, double, bool, JsonPtr, List, Map>
+		_value;
+
+	bool IsEmptyString() const;
+	void ClearCache();
+
+	mutable std::optional<std::string> _string;
+	mutable std::optional<std::optional<double>> _number;
+	mutable std::optional<JsonPtr> _json;
+};
+
+} // namespace advss
@@ -4,6 +4,8 @@
 #include "ui-helpers.hpp"
 #include "utility.hpp"
 
+#include <atomic>
+#include <limits>
 #include <QGridLayout>
 
 namespace advss {
@@ -14,14 +16,36 @@ static std::deque<std::shared_ptr<Item>> variables;
 // when resolving strings containing variables, etc.
 static std::chrono::high_resolution_clock::time_point lastVariableChange{};
 
+// Incremented whenever variables are added, removed, or renamed, so that
+// references to variables by name know when to look them up again
+static std::atomic<uint64_t> variableListVersion = 1;
+
+static std::mutex changedVariablesMutex;
+static std::unordered_set<const Variable *> changedVariables;
+
+static void markVariableChanged(const Variable *variable)
+{
+	bool notify = false;
+	{
+		std::lock_guard<std::mutex> lock(changedVariablesMutex);
+		notify = changedVariables.empty();
+		changedVariables.insert(variable);
+	}
+	if (notify) {
+		emit VariableSignalManager::Instance()->ValuesChanged();
+	}
+}
+
 Variable::Variable() : Item()
 {
 	lastVariableChange = std::chrono::high_resolution_clock::now();
+	++variableListVersion;
 }
 
 Variable::~Variable()
 {
 	lastVariableChange = std::chrono::high_resolution_clock::now();
+	++variableListVersion;
 }
 
 void Variable::Load(obs_data_t *obj)
@@ -32,12 +56,27 @@ void Variable::Load(obs_data_t *obj)
 	_defaultValue = obs_data_get_string(obj, "defaultValue");
 
 	if (_saveAction == SaveAction::SAVE) {
-		SetValue(obs_data_get_string(obj, "value"));
+		LoadValue(obj);
 	} else if (_saveAction == SaveAction::SET_DEFAULT) {
 		SetValue(_defaultValue);
 	}
 
 	lastVariableChange = std::chrono::high_resolution_clock::now();
+	++variableListVersion;
+}
+
+void Variable::LoadValue(obs_data_t *obj)
+{
+	const std::string value = obs_data_get_string(obj, "value");
+	const auto type = static_cast<VariableValue::Type>(
+		obs_data_get_int(obj, "valueType"));
+	auto collection = VariableValue::FromString(value);
+	if ((type == VariableValue::Type::LIST && collection.EditList()) ||
+	    (type == VariableValue::Type::MAP && collection.EditMap())) {
+		SetValue(std::move(collection));
+		return;
+	}
+	SetValue(value);
 }
 
 void Variable::Save(obs_data_t *obj) const
@@ -46,7 +85,15 @@ void Variable::Save(obs_data_t *obj) const
 	obs_data_set_int(obj, "saveAction", static_cast<int>(_saveAction));
 
 	if (_saveAction == SaveAction::SAVE) {
-		obs_data_set_string(obj, "value", _value.c_str());
+		std::lock_guard<std::mutex> lock(_mutex);
+		// Lists and maps are stored in their compact JSON representation
+		const auto type = _value.GetType();
+		if (type == VariableValue::Type::LIST ||
+		    type == VariableValue::Type::MAP) {
+			obs_data_set_int(obj, "valueType",
+					 static_cast<int>(type));
+		}
+		obs_data_set_string(obj, "value", _value.String().c_str());
 	}
 
 	obs_data_set_string(obj, "defaultValue", _defaultValue.c_str());
@@ -59,33 +106,241 @@ std::string Variable::Value(bool updateLastUsed) const
 		UpdateLastUsed();
 	}
 
-	return _value;
+	return _value.String();
 }
 
 std::optional<double> Variable::DoubleValue() const
 {
-	return GetDouble(Value());
+	std::lock_guard<std::mutex> lock(_mutex);
+	UpdateLastUsed();
+	return _value.Double();
 }
 
 std::optional<int> Variable::IntValue() const
 {
-	return GetInt(Value());
+	std::lock_guard<std::mutex> lock(_mutex);
+	UpdateLastUsed();
+	auto value = _value.Int();
+	if (!value || *value >= std::numeric_limits<int>::max() ||
+	    *value <= std::numeric_limits<int>::min()) {
+		return {};
+	}
+	return static_cast<int>(*value);
+}
+
+std::shared_ptr<const nlohmann::json> Variable::JsonValue() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	UpdateLastUsed();
+	return _value.Json();
+}
+
+VariableValue::Type Variable::GetValueType() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _value.GetType();
+}
+
+std::string Variable::GetPreviousValue() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _previousValue.String();
 }
 
 void Variable::SetValue(const std::string &value)
+{
+	SetValue(VariableValue::FromString(value));
+}
+
+void Variable::SetValue(double value)
+{
+	SetValue(VariableValue::FromDouble(value));
+}
+
+void Variable::SetIntValue(int64_t value)
+{
+	SetValue(VariableValue::FromInt(value));
+}
+
+void Variable::SetBoolValue(bool value)
+{
+	SetValue(VariableValue::FromBool(value));
+}
+
+void Variable::SetJsonValue(const nlohmann::json &value)
+{
+	SetValue(VariableValue::FromJson(value));
+}
+
+void Variable::SetListValue(VariableValue::List value)
+{
+	SetValue(VariableValue::FromList(std::move(value)));
+}
+
+void Variable::SetMapValue(VariableValue::Map value)
+{
+	SetValue(VariableValue::FromMap(std::move(value)));
+}
+
+bool Variable::ListPush(const std::string &value, bool front)
+{
+	return ModifyValue([&value, front](VariableValue &current) {
+		auto list = current.EditList();
+		if (!list) {
+			return false;
+		}
+		if (front) {
+			list->push_front(value);
+		} else {
+			list->push_back(value);
+		}
+		return true;
+	});
+}
+
+std::optional<std::string> Variable::ListPop(bool front)
+{
+	std::optional<std::string> result;
+	ModifyValue([&result, front](VariableValue &current) {
+		auto list = current.EditList();
+		if (!list || list->empty()) {
+			return false;
+		}
+		if (front) {
+			result = std::move(list->front());
+			list->pop_front();
+		} else {
+			result = std::move(list->back());
+			list->pop_back();
+		}
+		return true;
+	});
+	return result;
+}
+
+bool Variable::ListSet(size_t index, const std::string &value)
+{
+	bool success = false;
+	ModifyValue([index, &value, &success](VariableValue &current) {
+		auto list = current.EditList();
+		if (!list || index >= list->size()) {
+			return false;
+		}
+		success = true;
+		if ((*list)[index] == value) {
+			return false;
+		}
+		(*list)[index] = value;
+		return true;
+	});
+	return success;
+}
+
+bool Variable::MapSet(const std::string &key, const std::string &value)
+{
+	bool success = false;
+	ModifyValue([&key, &value, &success](VariableValue &current) {
+		auto map = current.EditMap();
+		if (!map) {
+			return false;
+		}
+		success = true;
+		auto [it, inserted] = map->try_emplace(key, value);
+		if (inserted || it->second == value) {
+			return inserted;
+		}
+		it->second = value;
+		return true;
+	});
+	return success;
+}
+
+bool Variable::MapRemove(const std::string &key)
+{
+	return ModifyValue([&key](VariableValue &current) {
+		auto map = current.EditMap();
+		return map && map->erase(key) > 0;
+	});
+}
+
+std::optional<std::string> Variable::ListGet(size_t index) const
 {
 	std::lock_guard<std::mutex> lock(_mutex);
-	_previousValue = _value;
-	_value = value;
+	UpdateLastUsed();
+	return _value.At(index);
+}
 
+std::optional<std::string> Variable::MapGet(const std::string &key) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
 	UpdateLastUsed();
-	UpdateLastChanged();
-	lastVariableChange = std::chrono::high_resolution_clock::now();
+	return _value.Find(key);
 }
 
-void Variable::SetValue(double value)
+bool Variable::Contains(const std::string &value) const
 {
-	SetValue(ToString(value));
+	std::lock_guard<std::mutex> lock(_mutex);
+	UpdateLastUsed();
+	return _value.Contains(value);
+}
+
+std::optional<size_t> Variable::Size() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	UpdateLastUsed();
+	return _value.Size();
+}
+
+std::optional<std::vector<std::string>> Variable::Elements() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	UpdateLastUsed();
+	return _value.Elements();
+}
+
+bool Variable::ModifyValue(const std::function<bool(VariableValue &)> &modify)
+{
+	bool result = false;
+	bool changed = false;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		const auto type = _value.GetType();
+		result = modify(_value);
+		// Converting the value to a list or map counts as a change, even
+		// if the operation itself did not modify the collection
+		changed = result || type != _value.GetType();
+
+		UpdateLastUsed();
+		if (changed) {
+			_lastChanged = std::chrono::high_resolution_clock::now();
+			++_valueChangeCount;
+			lastVariableChange = _lastChanged;
+		}
+	}
+
+	if (changed) {
+		markVariableChanged(this);
+	}
+	return result;
+}
+
+void Variable::SetValue(VariableValue &&value)
+{
+	bool changed = false;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_previousValue = std::move(_value);
+		_value = std::move(value);
+		changed = _previousValue != _value;
+
+		UpdateLastUsed();
+		UpdateLastChanged();
+		lastVariableChange = std::chrono::high_resolution_clock::now();
+	}
+
+	if (changed) {
+		markVariableChanged(this);
+	}
 }
 
 std::optional<uint64_t> Variable::GetSecondsSinceLastUse() const
@@ -145,7 +400,7 @@ VariableSettingsDialog::VariableSettingsDialog(QWidget *parent,
 	QWidget::connect(_save, SIGNAL(currentIndexChanged(int)), this,
 			 SLOT(SaveActionChanged(int)));
 
-	_value->setPlainText(QString::fromStdString(settings._value));
+	_value->setPlainText(QString::fromStdString(settings.Value(false)));
 	_defaultValue->setPlainText(
 		QString::fromStdString(settings._defaultValue));
 	populateSaveActionSelection(_save);
@@ -200,12 +455,18 @@ bool VariableSettingsDialog::AskForSettings(QWidget *parent, Variable &settings)
 	}
 
 	settings._name = dialog._name->text().toStdString();
-	settings.SetValue(dialog._value->toPlainText().toStdString());
+	// Keep the type of list, map, and other typed values if the user did
+	// not modify them
+	const auto value = dialog._value->toPlainText().toStdString();
+	if (value != settings.Value(false)) {
+		settings.SetValue(value);
+	}
 	settings._defaultValue =
 		dialog._defaultValue->toPlainText().toStdString();
 	settings._saveAction =
 		static_cast<Variable::SaveAction>(dialog._save->currentIndex());
 	lastVariableChange = std::chrono::high_resolution_clock::now();
+	++variableListVersion;
 
 	return true;
 }
@@ -316,6 +577,17 @@ bool VariableSelectionDialog::AskForVariable(std::string &varName)
 
 VariableSignalManager::VariableSignalManager(QObject *parent) : QObject(parent)
 {
+	// Emitted after the list of variables was modified, while the
+	// Variable constructor runs before the variable was added to the list
+	// and renames via the selection widgets bypass the settings dialog
+	connect(this, &VariableSignalManager::Rename, this,
+		[](const QString &, const QString &) {
+			++variableListVersion;
+		});
+	connect(this, &VariableSignalManager::Add, this,
+		[](const QString &) { ++variableListVersion; });
+	connect(this, &VariableSignalManager::Remove, this,
+		[](const QString &) { ++variableListVersion; });
 }
 
 VariableSignalManager *VariableSignalManager::Instance()
@@ -463,4 +735,17 @@ std::chrono::high_resolution_clock::time_point GetLastVariableChangeTime()
 	return lastVariableChange;
 }
 
+uint64_t GetVariableListVersion()
+{
+	return variableListVersion;
+}
+
+std::unordered_set<const Variable *> ConsumeChangedVariables()
+{
+	std::unordered_set<const Variable *> result;
+	std::lock_guard<std::mutex> lock(changedVariablesMutex);
+	result.swap(changedVariables);
+	return result;
+}
+
 } // namespace advss
@@ -2,11 +2,14 @@
 #include "export-symbol-helper.hpp"
 #include "item-selection-helpers.hpp"
 #include "resizing-text-edit.hpp"
+#include "variable-value.hpp"
 
+#include <functional>
 #include <mutex>
 #include <obs-data.h>
 #include <optional>
 #include <string>
+#include <unordered_set>
 #include <QStringList>
 
 namespace advss {
@@ -34,10 +37,36 @@ public:
 	EXPORT std::string Value(bool updateLastUsed = true) const;
 	EXPORT std::optional<double> DoubleValue() const;
 	EXPORT std::optional<int> IntValue() const;
-	std::string GetPreviousValue() const { return _previousValue; };
+	// Returns nullptr if the value cannot be interpreted as JSON
+	EXPORT std::shared_ptr<const nlohmann::json> JsonValue() const;
+	EXPORT VariableValue::Type GetValueType() const;
+	EXPORT std::string GetPreviousValue() const;
 	std::string GetDefaultValue() const { return _defaultValue; }
 	void SetValue(const std::string &value);
 	void SetValue(double value);
+	EXPORT void SetIntValue(int64_t value);
+	EXPORT void SetBoolValue(bool value);
+	EXPORT void SetJsonValue(const nlohmann::json &value);
+	EXPORT void SetListValue(VariableValue::List value);
+	EXPORT void SetMapValue(VariableValue::Map value);
+
+	// List and map operations.
+	// Values which are not a list or map yet are converted if possible.
+	// The value is modified in place to avoid copying the whole collection,
+	// so unlike SetValue() these do not update the previous value.
+	EXPORT bool ListPush(const std::string &value, bool front = false);
+	EXPORT std::optional<std::string> ListPop(bool front = false);
+	EXPORT bool ListSet(size_t index, const std::string &value);
+	EXPORT bool MapSet(const std::string &key, const std::string &value);
+	EXPORT bool MapRemove(const std::string &key);
+	EXPORT std::optional<std::string> ListGet(size_t index) const;
+	EXPORT std::optional<std::string> MapGet(const std::string &key) const;
+	// Checks the list elements or map keys
+	EXPORT bool Contains(const std::string &value) const;
+	EXPORT std::optional<size_t> Size() const;
+	// Returns the list elements or map keys
+	EXPORT std::optional<std::vector<std::string>> Elements() const;
+
 	SaveAction GetSaveAction() const { return _saveAction; }
 	int GetValueChangeCount() const { return _valueChangeCount; }
 	std::optional<uint64_t> GetSecondsSinceLastUse() const;
@@ -46,9 +75,14 @@ public:
 	void UpdateLastChanged();
 
 private:
+	void LoadValue(obs_data_t *obj);
+	void SetValue(VariableValue &&value);
+	// The modification function returns whether the value was changed
+	bool ModifyValue(const std::function<bool(VariableValue &)> &modify);
+
 	SaveAction _saveAction = SaveAction::DONT_SAVE;
-	std::string _value = "";
-	std::string _previousValue = "";
+	VariableValue _value;
+	VariableValue _previousValue;
 	std::string _defaultValue = "";
 	int _valueChangeCount = 0;
 	mutable std::chrono::high_resolution_clock::time_point _lastUsed;
@@ -105,6 +139,9 @@ signals:
 	void Rename(const QString &, const QString &);
 	void Add(const QString &);
 	void Remove(const QString &);
+	// Emitted once after a variable value changed until the changes
+	// are collected using ConsumeChangedVariables()
+	void ValuesChanged();
 };
 
 std::deque<std::shared_ptr<Item>> &GetVariables();
@@ -120,5 +157,12 @@ void LoadVariables(obs_data_t *obj);
 void ImportVariables(obs_data_t *obj);
 
 std::chrono::high_resolution_clock::time_point GetLastVariableChangeTime();
+// Changes whenever variables are added, removed, or renamed
+EXPORT uint64_t GetVariableListVersion();
+
+// Returns the variables whose value changed since the last call.
+// The pointers must only be used for identification as the variables might
+// have been deleted in the meantime.
+std::unordered_set<const Variable *> ConsumeChangedVariables();
 
 } // namespace advss
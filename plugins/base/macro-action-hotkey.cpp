@@ -3,7 +3,7 @@
 #include "selection-helpers.hpp"
 #include "source-helpers.hpp"
 
-#include <thread>
+#include <algorithm>
 #include <obs-interaction.h>
 
 namespace advss {
@@ -204,18 +204,49 @@ keysToOBSKeycombo(const std::vector<HotkeyType> &keys)
 	return combo;
 }
 
-static void InjectKeys(const std::vector<HotkeyType> &keys, int duration)
+// Only accessed from the OBS key press scheduler thread
+static std::vector<HotkeyType> injectedKeys;
+
+static void injectKeyEvents(const std::vector<KeyEvent> &events)
 {
-	auto combo = keysToOBSKeycombo(keys);
-	if (obs_key_combination_is_empty(combo)) {
+	const auto previousKeys = injectedKeys;
+	for (const auto &event : events) {
+		auto it = std::find(injectedKeys.begin(), injectedKeys.end(),
+				    event.key);
+		if (event.pressed && it == injectedKeys.end()) {
+			injectedKeys.push_back(event.key);
+		} else if (!event.pressed && it != injectedKeys.end()) {
+			injectedKeys.erase(it);
+		}
+	}
+	if (previousKeys == injectedKeys) {
 		return;
 	}
-	// I am not sure why this is necessary
-	obs_hotkey_inject_event(combo, false);
 
+	if (!previousKeys.empty()) {
+		auto combo = keysToOBSKeycombo(previousKeys);
+		if (!obs_key_combination_is_empty(combo)) {
+			obs_hotkey_inject_event(combo, false);
+		}
+	}
+	if (injectedKeys.empty()) {
+		return;
+	}
+	auto combo = keysToOBSKeycombo(injectedKeys);
+	if (obs_key_combination_is_empty(combo)) {
+		return;
+	}
+	if (previousKeys.empty()) {
+		// I am not sure why this is necessary
+		obs_hotkey_inject_event(combo, false);
+	}
 	obs_hotkey_inject_event(combo, true);
-	std::this_thread::sleep_for(std::chrono::milliseconds(duration));
-	obs_hotkey_inject_event(combo, false);
+}
+
+static void injectKeySequence(const std::vector<KeySequenceStep> &steps)
+{
+	static KeyPressScheduler scheduler(injectKeyEvents);
+	scheduler.PressSequence(steps);
 }
 
 static void addNamePrefix(std::string &name, obs_hotkey_t *hotkey)
@@ -341,15 +372,23 @@ void MacroActionHotkey::SendCustomHotkey()
 		keys.push_back(_key);
 	}
 
-	if (!keys.empty()) {
-		int dur = _duration.Milliseconds();
-		if (_onlySendToObs || !CanSimulateKeyPresses()) {
-			std::thread t([keys, dur]() { InjectKeys(keys, dur); });
-			t.detach();
-		} else {
-			std::thread t([keys, dur]() { PressKeys(keys, dur); });
-			t.detach();
-		}
+	if (keys.empty()) {
+		return;
+	}
+
+	auto toMilliseconds = [](const Duration &duration) {
+		return std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::duration<double, std::milli>(
+				duration.Milliseconds()));
+	};
+	const KeySequenceStep step{keys, toMilliseconds(_duration),
+				   toMilliseconds(_interval)};
+	const std::vector<KeySequenceStep> steps(std::max(_repetitions, 1),
+						 step);
+	if (_onlySendToObs || !CanSimulateKeyPresses()) {
+		injectKeySequence(steps);
+	} else {
+		PressKeySequence(steps);
 	}
 }
 
@@ -390,6 +429,8 @@ bool MacroActionHotkey::Save(obs_data_t *obj) const
 	obs_data_set_bool(obj, "left_meta", _leftMeta);
 	obs_data_set_bool(obj, "right_meta", _rightMeta);
 	_duration.Save(obj);
+	obs_data_set_int(obj, "repetitions", _repetitions);
+	_interval.Save(obj, "interval");
 	obs_data_set_bool(obj, "onlyOBS", _onlySendToObs);
 	obs_data_set_int(obj, "version", 2);
 	return true;
@@ -421,6 +462,10 @@ bool MacroActionHotkey::Load(obs_data_t *obj)
 	} else {
 		_duration.Load(obj);
 	}
+	if (obs_data_has_user_value(obj, "repetitions")) {
+		_repetitions = obs_data_get_int(obj, "repetitions");
+		_interval.Load(obj, "interval");
+	}
 	_onlySendToObs = obs_data_get_bool(obj, "onlyOBS");
 	return true;
 }
@@ -622,13 +667,18 @@ MacroActionHotkeyEdit::MacroActionHotkeyEdit(
 	  _rightMeta(new QCheckBox(
 		  obs_module_text("AdvSceneSwitcher.action.hotkey.rightMeta"))),
 	  _duration(new DurationSelection(this, false)),
+	  _repetitions(new QSpinBox()),
+	  _interval(new DurationSelection(this, false)),
 	  _onlySendToOBS(new QCheckBox(
 		  obs_module_text("AdvSceneSwitcher.action.hotkey.onlyOBS"))),
 	  _noKeyPressSimulationWarning(new QLabel(
 		  obs_module_text("AdvSceneSwitcher.action.hotkey.disabled"))),
 	  _entryLayout(new QHBoxLayout()),
-	  _keyConfigLayout(new QHBoxLayout())
+	  _keyConfigLayout(new QHBoxLayout()),
+	  _repeatLayout(new QHBoxLayout())
 {
+	_repetitions->setMinimum(1);
+	_repetitions->setMaximum(1000);
 	populateKeySelection(_keys);
 	populateActionSelection(_actionType);
 	populateHotkeyTypeSelection(_hotkeyType);
@@ -659,6 +709,10 @@ MacroActionHotkeyEdit::MacroActionHotkeyEdit(
 			 SLOT(RMetaChanged(int)));
 	QWidget::connect(_duration, SIGNAL(DurationChanged(const Duration &)),
 			 this, SLOT(DurationChanged(const Duration &)));
+	QWidget::connect(_repetitions, SIGNAL(valueChanged(int)), this,
+			 SLOT(RepetitionsChanged(int)));
+	QWidget::connect(_interval, SIGNAL(DurationChanged(const Duration &)),
+			 this, SLOT(IntervalChanged(const Duration &)));
 	QWidget::connect(_onlySendToOBS, SIGNAL(stateChanged(int)), this,
 			 SLOT(OnlySendToOBSChanged(int)));
 
@@ -673,10 +727,16 @@ MacroActionHotkeyEdit::MacroActionHotkeyEdit(
 	_keyConfigLayout->addWidget(_leftMeta);
 	_keyConfigLayout->addWidget(_rightMeta);
 	_keyConfigLayout->addStretch();
+	PlaceWidgets(
+		obs_module_text("AdvSceneSwitcher.action.hotkey.entry.repeat"),
+		_repeatLayout,
+		{{"{{repetitions}}", _repetitions},
+		 {"{{interval}}", _interval}});
 
 	auto mainLayout = new QVBoxLayout;
 	mainLayout->addLayout(_entryLayout);
 	mainLayout->addLayout(_keyConfigLayout);
+	mainLayout->addLayout(_repeatLayout);
 	mainLayout->addWidget(_onlySendToOBS);
 	mainLayout->addWidget(_noKeyPressSimulationWarning);
 	setLayout(mainLayout);
@@ -721,6 +781,9 @@ void MacroActionHotkeyEdit::SetWidgetVisibility()
 	SetLayoutVisible(_keyConfigLayout,
 			 _entryData->_action ==
 				 MacroActionHotkey::Action::CUSTOM);
+	SetLayoutVisible(_repeatLayout,
+			 _entryData->_action ==
+				 MacroActionHotkey::Action::CUSTOM);
 	_duration->setVisible(_entryData->_action ==
 			      MacroActionHotkey::Action::CUSTOM);
 	_keys->setVisible(_entryData->_action ==
@@ -781,6 +844,8 @@ void MacroActionHotkeyEdit::UpdateEntryData()
 	_leftMeta->setChecked(_entryData->_leftMeta);
 	_rightMeta->setChecked(_entryData->_rightMeta);
 	_duration->SetDuration(_entryData->_duration);
+	_repetitions->setValue(_entryData->_repetitions);
+	_interval->SetDuration(_entryData->_interval);
 	_onlySendToOBS->setChecked(_entryData->_onlySendToObs ||
 				   !CanSimulateKeyPresses());
 	SetWidgetVisibility();
@@ -876,6 +941,26 @@ void MacroActionHotkeyEdit::DurationChanged(const Duration &dur)
 	_entryData->_duration = dur;
 }
 
+void MacroActionHotkeyEdit::RepetitionsChanged(int value)
+{
+	if (_loading || !_entryData) {
+		return;
+	}
+
+	auto lock = LockContext();
+	_entryData->_repetitions = value;
+}
+
+void MacroActionHotkeyEdit::IntervalChanged(const Duration &interval)
+{
+	if (_loading || !_entryData) {
+		return;
+	}
+
+	auto lock = LockContext();
+	_entryData->_interval = interval;
+}
+
 void MacroActionHotkeyEdit::OnlySendToOBSChanged(int state)
 {
 	if (_loading || !_entryData) {
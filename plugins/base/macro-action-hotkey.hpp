@@ -40,6 +40,8 @@ public:
 	bool _leftMeta = false;
 	bool _rightMeta = false;
 	Duration _duration = 0.3;
+	int _repetitions = 1;
+	Duration _interval = 0.1;
 #ifdef __APPLE__
 	bool _onlySendToObs = true;
 #else
@@ -84,6 +86,8 @@ private slots:
 	void LMetaChanged(int state);
 	void RMetaChanged(int state);
 	void DurationChanged(const Duration &);
+	void RepetitionsChanged(int);
+	void IntervalChanged(const Duration &);
 	void OnlySendToOBSChanged(int state);
 
 protected:
@@ -100,6 +104,8 @@ protected:
 	QCheckBox *_leftMeta;
 	QCheckBox *_rightMeta;
 	DurationSelection *_duration;
+	QSpinBox *_repetitions;
+	DurationSelection *_interval;
 	QCheckBox *_onlySendToOBS;
 	QLabel *_noKeyPressSimulationWarning;
 
@@ -111,6 +117,7 @@ private:
 
 	QHBoxLayout *_entryLayout;
 	QHBoxLayout *_keyConfigLayout;
+	QHBoxLayout *_repeatLayout;
 	bool _loading = true;
 };
 
@@ -33,7 +33,8 @@ void MacroActionScreenshot::CustomScreenshot(OBSWeakSource &source)
 	}
 	auto s = obs_weak_source_get_source(source);
 	_screenshot.~ScreenshotHelper();
-	new (&_screenshot) ScreenshotHelper(s, QRect(), false, 0, true, _path);
+	new (&_screenshot) ScreenshotHelper(s, QRect(), false, 0, true, _path,
+					    _encoderSettings);
 	obs_source_release(s);
 }
 
@@ -90,6 +91,12 @@ bool MacroActionScreenshot::Save(obs_data_t *obj) const
 	obs_data_set_int(obj, "saveType", static_cast<int>(_saveType));
 	obs_data_set_int(obj, "targetType", static_cast<int>(_targetType));
 	_path.Save(obj, "savePath");
+	obs_data_set_int(obj, "format",
+			 static_cast<int>(_encoderSettings.format));
+	obs_data_set_int(obj, "quality", _encoderSettings.quality);
+	obs_data_set_bool(obj, "skipDuplicates",
+			  _encoderSettings.skipDuplicates);
+	obs_data_set_int(obj, "keepCount", _encoderSettings.keepCount);
 	obs_data_set_int(obj, "version", 1);
 	return true;
 }
@@ -103,6 +110,15 @@ bool MacroActionScreenshot::Load(obs_data_t *obj)
 	_targetType =
 		static_cast<TargetType>(obs_data_get_int(obj, "targetType"));
 	_path.Load(obj, "savePath");
+	_encoderSettings.format = static_cast<ScreenshotEncoder::Format>(
+		obs_data_get_int(obj, "format"));
+	_encoderSettings.quality =
+		obs_data_has_user_value(obj, "quality")
+			? obs_data_get_int(obj, "quality")
+			: -1;
+	_encoderSettings.skipDuplicates =
+		obs_data_get_bool(obj, "skipDuplicates");
+	_encoderSettings.keepCount = obs_data_get_int(obj, "keepCount");
 
 	// TODO: Remove fallback for older versions
 	if (!obs_data_has_user_value(obj, "version")) {
@@ -162,6 +178,15 @@ static void populateTargetTypeSelection(QComboBox *list)
 	list->addItem(obs_module_text("AdvSceneSwitcher.OBSVideoOutput"));
 }
 
+static void populateFormatSelection(QComboBox *list)
+{
+	list->addItem(obs_module_text(
+		"AdvSceneSwitcher.action.screenshot.format.auto"));
+	list->addItem("PNG");
+	list->addItem("JPEG");
+	list->addItem("WebP");
+}
+
 MacroActionScreenshotEdit::MacroActionScreenshotEdit(
 	QWidget *parent, std::shared_ptr<MacroActionScreenshot> entryData)
 	: QWidget(parent),
@@ -170,7 +195,13 @@ MacroActionScreenshotEdit::MacroActionScreenshotEdit(
 	  _sources(new SourceSelectionWidget(this, QStringList(), true)),
 	  _saveType(new QComboBox()),
 	  _targetType(new QComboBox()),
-	  _savePath(new FileSelection(FileSelection::Type::WRITE, this))
+	  _savePath(new FileSelection(FileSelection::Type::WRITE, this)),
+	  _format(new QComboBox()),
+	  _quality(new QSpinBox()),
+	  _skipDuplicates(new QCheckBox(obs_module_text(
+		  "AdvSceneSwitcher.action.screenshot.skipDuplicates"))),
+	  _keepCount(new QSpinBox()),
+	  _encoderLayout(new QHBoxLayout())
 {
 	setToolTip(obs_module_text(
 		"AdvSceneSwitcher.action.screenshot.blackscreenNote"));
@@ -180,6 +211,20 @@ MacroActionScreenshotEdit::MacroActionScreenshotEdit(
 
 	populateSaveTypeSelection(_saveType);
 	populateTargetTypeSelection(_targetType);
+	populateFormatSelection(_format);
+
+	_savePath->setToolTip(obs_module_text(
+		"AdvSceneSwitcher.action.screenshot.path.tooltip"));
+	_quality->setMinimum(-1);
+	_quality->setMaximum(100);
+	_quality->setSpecialValueText(obs_module_text(
+		"AdvSceneSwitcher.action.screenshot.quality.default"));
+	_quality->setToolTip(obs_module_text(
+		"AdvSceneSwitcher.action.screenshot.quality.tooltip"));
+	_keepCount->setMinimum(0);
+	_keepCount->setMaximum(100000);
+	_keepCount->setSpecialValueText(obs_module_text(
+		"AdvSceneSwitcher.action.screenshot.keepCount.all"));
 
 	QWidget::connect(_scenes, SIGNAL(SceneChanged(const SceneSelection &)),
 			 this, SLOT(SceneChanged(const SceneSelection &)));
@@ -192,6 +237,14 @@ MacroActionScreenshotEdit::MacroActionScreenshotEdit(
 			 SLOT(TargetTypeChanged(int)));
 	QWidget::connect(_savePath, SIGNAL(PathChanged(const QString &)), this,
 			 SLOT(PathChanged(const QString &)));
+	QWidget::connect(_format, SIGNAL(currentIndexChanged(int)), this,
+			 SLOT(FormatChanged(int)));
+	QWidget::connect(_quality, SIGNAL(valueChanged(int)), this,
+			 SLOT(QualityChanged(int)));
+	QWidget::connect(_skipDuplicates, SIGNAL(stateChanged(int)), this,
+			 SLOT(SkipDuplicatesChanged(int)));
+	QWidget::connect(_keepCount, SIGNAL(valueChanged(int)), this,
+			 SLOT(KeepCountChanged(int)));
 
 	QHBoxLayout *layout = new QHBoxLayout;
 	std::unordered_map<std::string, QWidget *> widgetPlaceholders = {
@@ -204,9 +257,18 @@ MacroActionScreenshotEdit::MacroActionScreenshotEdit(
 		obs_module_text("AdvSceneSwitcher.action.screenshot.entry"),
 		layout, widgetPlaceholders);
 
+	PlaceWidgets(
+		obs_module_text("AdvSceneSwitcher.action.screenshot.encoder"),
+		_encoderLayout,
+		{{"{{format}}", _format},
+		 {"{{quality}}", _quality},
+		 {"{{keepCount}}", _keepCount}});
+
 	QVBoxLayout *mainLayout = new QVBoxLayout;
 	mainLayout->addLayout(layout);
 	mainLayout->addWidget(_savePath);
+	mainLayout->addLayout(_encoderLayout);
+	mainLayout->addWidget(_skipDuplicates);
 	setLayout(mainLayout);
 
 	_entryData = entryData;
@@ -225,6 +287,11 @@ void MacroActionScreenshotEdit::UpdateEntryData()
 	_saveType->setCurrentIndex(static_cast<int>(_entryData->_saveType));
 	_targetType->setCurrentIndex(static_cast<int>(_entryData->_targetType));
 	_savePath->SetPath(_entryData->_path);
+	const auto &settings = _entryData->_encoderSettings;
+	_format->setCurrentIndex(static_cast<int>(settings.format));
+	_quality->setValue(settings.quality);
+	_skipDuplicates->setChecked(settings.skipDuplicates);
+	_keepCount->setValue(settings.keepCount);
 	SetWidgetVisibility();
 }
 
@@ -270,6 +337,31 @@ void MacroActionScreenshotEdit::PathChanged(const QString &text)
 	_entryData->_path = text.toStdString();
 }
 
+void MacroActionScreenshotEdit::FormatChanged(int index)
+{
+	GUARD_LOADING_AND_LOCK();
+	_entryData->_encoderSettings.format =
+		static_cast<ScreenshotEncoder::Format>(index);
+}
+
+void MacroActionScreenshotEdit::QualityChanged(int value)
+{
+	GUARD_LOADING_AND_LOCK();
+	_entryData->_encoderSettings.quality = value;
+}
+
+void MacroActionScreenshotEdit::SkipDuplicatesChanged(int value)
+{
+	GUARD_LOADING_AND_LOCK();
+	_entryData->_encoderSettings.skipDuplicates = value;
+}
+
+void MacroActionScreenshotEdit::KeepCountChanged(int value)
+{
+	GUARD_LOADING_AND_LOCK();
+	_entryData->_encoderSettings.keepCount = value;
+}
+
 void MacroActionScreenshotEdit::SourceChanged(const SourceSelection &source)
 {
 	if (_loading || !_entryData) {
@@ -287,8 +379,11 @@ void MacroActionScreenshotEdit::SetWidgetVisibility()
 	if (!_entryData) {
 		return;
 	}
-	_savePath->setVisible(_entryData->_saveType ==
-			      MacroActionScreenshot::SaveType::CUSTOM);
+	const bool isCustom = _entryData->_saveType ==
+			      MacroActionScreenshot::SaveType::CUSTOM;
+	_savePath->setVisible(isCustom);
+	SetLayoutVisible(_encoderLayout, isCustom);
+	_skipDuplicates->setVisible(isCustom);
 	_sources->setVisible(_entryData->_targetType ==
 			     MacroActionScreenshot::TargetType::SOURCE);
 	_scenes->setVisible(_entryData->_targetType ==
@@ -5,7 +5,9 @@
 #include "screenshot-helper.hpp"
 #include "source-selection.hpp"
 
+#include <QCheckBox>
 #include <QComboBox>
+#include <QSpinBox>
 
 namespace advss {
 
@@ -37,6 +39,7 @@ public:
 	SceneSelection _scene;
 	SourceSelection _source;
 	StringVariable _path = obs_module_text("AdvSceneSwitcher.enterPath");
+	ScreenshotEncoder::Settings _encoderSettings;
 
 private:
 	void FrontendScreenshot(OBSWeakSource &);
@@ -70,6 +73,10 @@ private slots:
 	void SaveTypeChanged(int index);
 	void TargetTypeChanged(int index);
 	void PathChanged(const QString &text);
+	void FormatChanged(int index);
+	void QualityChanged(int value);
+	void SkipDuplicatesChanged(int value);
+	void KeepCountChanged(int value);
 signals:
 	void HeaderInfoChanged(const QString &);
 
@@ -79,6 +86,11 @@ protected:
 	QComboBox *_saveType;
 	QComboBox *_targetType;
 	FileSelection *_savePath;
+	QComboBox *_format;
+	QSpinBox *_quality;
+	QCheckBox *_skipDuplicates;
+	QSpinBox *_keepCount;
+	QHBoxLayout *_encoderLayout;
 	std::shared_ptr<MacroActionScreenshot> _entryData;
 
 private:
@@ -27,6 +27,12 @@ const static std::map<MacroActionWebsocket::MessageType, std::string>
 		 "AdvSceneSwitcher.action.websocket.type.event"},
 };
 
+bool MacroActionWebsocket::ExpectsResponse() const
+{
+	return _api == API::OBS_WEBSOCKET ||
+	       (_api == API::SCENE_SWITCHER && _type == MessageType::REQUEST);
+}
+
 void MacroActionWebsocket::SendRequest(const std::string &msg)
 {
 	auto connection = _connection.lock();
@@ -34,7 +40,70 @@ void MacroActionWebsocket::SendRequest(const std::string &msg)
 		return;
 	}
 
-	connection->SendMsg(msg);
+	if (!ExpectsResponse() || !_waitForResponse) {
+		connection->SendMsg(msg);
+		return;
+	}
+
+	const auto timeout =
+		std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::duration<double, std::milli>(
+				_timeout.Milliseconds()));
+	auto response = connection->SendRequest(msg, timeout);
+	if (response.wait_for(timeout) != std::future_status::ready) {
+		SetTempVarValues({});
+		return;
+	}
+	SetTempVarValues(response.get());
+}
+
+void MacroActionWebsocket::SetWaitForResponse(bool value)
+{
+	_waitForResponse = value;
+	SetupTempVars();
+}
+
+void MacroActionWebsocket::SetupTempVars()
+{
+	MacroAction::SetupTempVars();
+	if (!_waitForResponse) {
+		return;
+	}
+
+	AddTempvar(
+		"response.result",
+		obs_module_text(
+			"AdvSceneSwitcher.tempVar.websocket.response.result"),
+		obs_module_text(
+			"AdvSceneSwitcher.tempVar.websocket.response.result.description"));
+	AddTempvar(
+		"response.code",
+		obs_module_text(
+			"AdvSceneSwitcher.tempVar.websocket.response.code"),
+		obs_module_text(
+			"AdvSceneSwitcher.tempVar.websocket.response.code.description"));
+	AddTempvar(
+		"response.comment",
+		obs_module_text(
+			"AdvSceneSwitcher.tempVar.websocket.response.comment"),
+		obs_module_text(
+			"AdvSceneSwitcher.tempVar.websocket.response.comment.description"));
+	AddTempvar(
+		"response.data",
+		obs_module_text(
+			"AdvSceneSwitcher.tempVar.websocket.response.data"),
+		obs_module_text(
+			"AdvSceneSwitcher.tempVar.websocket.response.data.description"));
+}
+
+void MacroActionWebsocket::SetTempVarValues(const WSRequestResponse &response)
+{
+	SetTempVarValue("response.result",
+			response.received && response.result ? "true"
+							      : "false");
+	SetTempVarValue("response.code", std::to_string(response.code));
+	SetTempVarValue("response.comment", response.comment);
+	SetTempVarValue("response.data", response.responseData);
 }
 
 bool MacroActionWebsocket::PerformAction()
@@ -94,6 +163,8 @@ bool MacroActionWebsocket::Save(obs_data_t *obj) const
 	_message.Save(obj, "message");
 	obs_data_set_string(obj, "connection",
 			    GetWeakConnectionName(_connection).c_str());
+	obs_data_set_bool(obj, "waitForResponse", _waitForResponse);
+	_timeout.Save(obj, "timeout");
 	return true;
 }
 
@@ -105,6 +176,8 @@ bool MacroActionWebsocket::Load(obs_data_t *obj)
 	_message.Load(obj, "message");
 	_connection =
 		GetWeakConnectionByName(obs_data_get_string(obj, "connection"));
+	SetWaitForResponse(obs_data_get_bool(obj, "waitForResponse"));
+	_timeout.Load(obj, "timeout");
 	return true;
 }
 
@@ -129,6 +202,7 @@ std::shared_ptr<MacroAction> MacroActionWebsocket::Copy() const
 void MacroActionWebsocket::ResolveVariablesToFixedValues()
 {
 	_message.ResolveVariables();
+	_timeout.ResolveVariables();
 }
 
 static inline void populateAPISelection(QComboBox *list)
@@ -153,6 +227,9 @@ MacroActionWebsocketEdit::MacroActionWebsocketEdit(
 	  _message(new VariableTextEdit(this)),
 	  _connection(new WSConnectionSelection(this)),
 	  _editLayout(new QHBoxLayout()),
+	  _waitLayout(new QHBoxLayout()),
+	  _waitForResponse(new QCheckBox()),
+	  _timeout(new DurationSelection(this, true, 0.1)),
 	  _settingsConflict(new QLabel())
 {
 	populateAPISelection(_apiType);
@@ -168,10 +245,21 @@ MacroActionWebsocketEdit::MacroActionWebsocketEdit(
 	QWidget::connect(_connection, SIGNAL(SelectionChanged(const QString &)),
 			 this,
 			 SLOT(ConnectionSelectionChanged(const QString &)));
+	QWidget::connect(_waitForResponse, SIGNAL(stateChanged(int)), this,
+			 SLOT(WaitForResponseChanged(int)));
+	QWidget::connect(_timeout, SIGNAL(DurationChanged(const Duration &)),
+			 this, SLOT(TimeoutChanged(const Duration &)));
+
+	PlaceWidgets(obs_module_text(
+			     "AdvSceneSwitcher.action.websocket.entry.wait"),
+		     _waitLayout,
+		     {{"{{waitForResponse}}", _waitForResponse},
+		      {"{{timeout}}", _timeout}});
 
 	auto mainLayout = new QVBoxLayout;
 	mainLayout->addLayout(_editLayout);
 	mainLayout->addWidget(_message);
+	mainLayout->addLayout(_waitLayout);
 	mainLayout->addWidget(_settingsConflict);
 	setLayout(mainLayout);
 
@@ -228,6 +316,8 @@ void MacroActionWebsocketEdit::SetWidgetVisibility()
 		break;
 	}
 
+	SetLayoutVisible(_waitLayout, _entryData->ExpectsResponse());
+	_timeout->setEnabled(_entryData->WaitForResponse());
 	CheckForSettingsConflict();
 
 	adjustSize();
@@ -297,6 +387,8 @@ void MacroActionWebsocketEdit::UpdateEntryData()
 	_messageType->setCurrentIndex(static_cast<int>(_entryData->_type));
 	_message->setPlainText(_entryData->_message);
 	_connection->SetConnection(_entryData->_connection);
+	_waitForResponse->setChecked(_entryData->WaitForResponse());
+	_timeout->SetDuration(_entryData->_timeout);
 
 	SetWidgetVisibility();
 }
@@ -377,4 +469,27 @@ void MacroActionWebsocketEdit::ConnectionSelectionChanged(
 	emit(HeaderInfoChanged(connection));
 }
 
+void MacroActionWebsocketEdit::WaitForResponseChanged(int value)
+{
+	if (_loading || !_entryData) {
+		return;
+	}
+
+	{
+		auto lock = LockContext();
+		_entryData->SetWaitForResponse(value);
+	}
+	SetWidgetVisibility();
+}
+
+void MacroActionWebsocketEdit::TimeoutChanged(const Duration &timeout)
+{
+	if (_loading || !_entryData) {
+		return;
+	}
+
+	auto lock = LockContext();
+	_entryData->_timeout = timeout;
+}
+
 } // namespace advss
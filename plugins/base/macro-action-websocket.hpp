@@ -1,8 +1,10 @@
 #pragma once
 #include "macro-action-edit.hpp"
 #include "connection-manager.hpp"
+#include "duration-control.hpp"
 #include "variable-text-edit.hpp"
 
+#include <QCheckBox>
 #include <QLineEdit>
 #include <QPushButton>
 #include <QListWidget>
@@ -38,9 +40,18 @@ public:
 	MessageType _type = MessageType::REQUEST;
 	StringVariable _message = obs_module_text("AdvSceneSwitcher.enterText");
 	std::weak_ptr<WSConnection> _connection;
+	Duration _timeout = 1;
+
+	bool ExpectsResponse() const;
+	void SetWaitForResponse(bool);
+	bool WaitForResponse() const { return _waitForResponse; }
 
 private:
 	void SendRequest(const std::string &msg);
+	void SetupTempVars();
+	void SetTempVarValues(const WSRequestResponse &);
+
+	bool _waitForResponse = false;
 
 	static bool _registered;
 	static const std::string id;
@@ -67,6 +78,8 @@ private slots:
 	void MessageTypeChanged(int);
 	void MessageChanged();
 	void ConnectionSelectionChanged(const QString &);
+	void WaitForResponseChanged(int);
+	void TimeoutChanged(const Duration &);
 signals:
 	void HeaderInfoChanged(const QString &);
 
@@ -86,6 +99,9 @@ private:
 	VariableTextEdit *_message;
 	WSConnectionSelection *_connection;
 	QHBoxLayout *_editLayout;
+	QHBoxLayout *_waitLayout;
+	QCheckBox *_waitForResponse;
+	DurationSelection *_timeout;
 	QLabel *_settingsConflict;
 
 	bool _loading = true;
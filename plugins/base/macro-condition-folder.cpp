@@ -44,6 +44,10 @@ bool MacroConditionFolder::CheckCondition()
 	}
 
 	SetTempVarValues();
+	if (ret && _pendingTraceEvent) {
+		TraceTriggerEvent(_pendingTraceEvent->source.c_str(),
+				  _pendingTraceEvent->time);
+	}
 
 	_newFiles.clear();
 	_changedFiles.clear();
@@ -51,6 +55,7 @@ bool MacroConditionFolder::CheckCondition()
 	_newDirs.clear();
 	_removedDirs.clear();
 	_matched = false;
+	_pendingTraceEvent.reset();
 
 	return ret;
 }
@@ -122,6 +127,7 @@ static void reduceSetToPatternMatch(QSet<QString> &set,
 
 void MacroConditionFolder::DirectoryChanged(const QString &path)
 {
+	const auto time = std::chrono::steady_clock::now();
 	std::lock_guard<std::mutex> lock(_mutex);
 	if (MacroIsPaused(GetMacro())) {
 		return;
@@ -171,6 +177,10 @@ void MacroConditionFolder::DirectoryChanged(const QString &path)
 		break;
 	}
 
+	if (_matched) {
+		SetPendingTraceEvent("folder", time);
+	}
+
 	for (const auto &newFile : _newFiles) {
 		_watcher->addPath(path + "/" + newFile);
 	}
@@ -181,6 +191,7 @@ void MacroConditionFolder::DirectoryChanged(const QString &path)
 
 void MacroConditionFolder::FileChanged(const QString &path)
 {
+	const auto time = std::chrono::steady_clock::now();
 	std::lock_guard<std::mutex> lock(_mutex);
 	QFileInfo fileInfo(path);
 	if (!fileInfo.exists()) {
@@ -196,6 +207,16 @@ void MacroConditionFolder::FileChanged(const QString &path)
 	if (_condition == Condition::FILE_CHANGE ||
 	    _condition == Condition::ANY) {
 		_matched = true;
+		SetPendingTraceEvent("file", time);
+	}
+}
+
+void MacroConditionFolder::SetPendingTraceEvent(
+	const char *source, std::chrono::steady_clock::time_point time)
+{
+	// Keep the oldest change, as it experienced the longest delay
+	if (MacroTracingEnabled() && !_pendingTraceEvent) {
+		_pendingTraceEvent = MacroTraceEvent{source, time};
 	}
 }
 
@@ -47,6 +47,8 @@ private:
 	void SetupWatcher();
 	void SetTempVarValues();
 	void SetupTempVars();
+	void SetPendingTraceEvent(const char *source,
+				  std::chrono::steady_clock::time_point);
 
 	StringVariable _folder = obs_module_text("AdvSceneSwitcher.enterPath");
 
@@ -62,6 +64,9 @@ private:
 	QSet<QString> _removedDirs;
 	QSet<QString> _currentFiles;
 	QSet<QString> _currentDirs;
+	// Passed on to TraceTriggerEvent() by the next condition check, as
+	// the changes are detected outside of CheckCondition()
+	std::optional<MacroTraceEvent> _pendingTraceEvent;
 
 	static bool _registered;
 	static const std::string id;
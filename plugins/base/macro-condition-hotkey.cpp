@@ -17,21 +17,35 @@ MacroConditionHotkey::MacroConditionHotkey(Macro *m) : MacroCondition(m)
 {
 	auto name = obs_module_text("AdvSceneSwitcher.condition.hotkey.name") +
 		    std::string(" ") + std::to_string(count);
-	_hotkey = Hotkey::GetHotkey(name, true);
+	SetHotkey(Hotkey::GetHotkey(name, true));
 	count++;
 }
 
+void MacroConditionHotkey::SetHotkey(const std::shared_ptr<Hotkey> &hotkey)
+{
+	_hotkey = hotkey;
+	_keyEvents = _hotkey->RegisterForKeyEvents();
+}
+
 bool MacroConditionHotkey::CheckCondition()
 {
-	const bool keyStateCurrentlyMatches =
-		_checkPressed ? _hotkey->GetPressed() : !_hotkey->GetPressed();
-	const auto lastKeyStateMatch = _checkPressed
-					       ? _hotkey->GetLastPressed()
-					       : _hotkey->GetLastReleased();
-	const bool hotkeySateChangedSinceLastCheck = lastKeyStateMatch >
-						     _lastCheck;
+	// Key state changes are delivered by the hotkey callback, so key
+	// presses shorter than the check interval are not missed
 	const bool macroWasPausedSinceLastCheck =
 		MacroWasPausedSince(GetMacro(), _lastCheck);
+	bool hotkeySateChangedSinceLastCheck = false;
+	std::chrono::steady_clock::time_point arrival;
+	while (auto pressed = _keyEvents->ConsumeMessage(arrival)) {
+		if (*pressed != _checkPressed) {
+			continue;
+		}
+		hotkeySateChangedSinceLastCheck = true;
+		if (!macroWasPausedSinceLastCheck) {
+			TraceTriggerEvent("hotkey", arrival);
+		}
+	}
+	const bool keyStateCurrentlyMatches =
+		_checkPressed ? _hotkey->GetPressed() : !_hotkey->GetPressed();
 	bool ret = keyStateCurrentlyMatches ||
 		   (hotkeySateChangedSinceLastCheck &&
 		    !macroWasPausedSinceLastCheck);
@@ -52,7 +66,7 @@ bool MacroConditionHotkey::Load(obs_data_t *obj)
 	MacroCondition::Load(obj);
 	if (!_hotkey->Load(obj)) {
 		auto description = obs_data_get_string(obj, "desc");
-		_hotkey = Hotkey::GetHotkey(description);
+		SetHotkey(Hotkey::GetHotkey(description));
 		vblog(LOG_WARNING,
 		      "hotkey name conflict for \"%s\" - using previous key bind",
 		      description);
@@ -122,7 +136,7 @@ void MacroConditionHotkeyEdit::NameChanged()
 	// hotkey use its settings instead.
 	if (_entryData->_hotkey.use_count() > 1 ||
 	    !_entryData->_hotkey->UpdateDescription(name)) {
-		_entryData->_hotkey = Hotkey::GetHotkey(name);
+		_entryData->SetHotkey(Hotkey::GetHotkey(name));
 	}
 }
 
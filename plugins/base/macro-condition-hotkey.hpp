@@ -19,10 +19,13 @@ public:
 		return std::make_shared<MacroConditionHotkey>(m);
 	}
 
+	void SetHotkey(const std::shared_ptr<Hotkey> &);
+
 	std::shared_ptr<Hotkey> _hotkey;
 	bool _checkPressed = true;
 
 private:
+	std::shared_ptr<MessageBuffer<bool>> _keyEvents;
 	std::chrono::high_resolution_clock::time_point _lastCheck{};
 
 	static bool _registered;
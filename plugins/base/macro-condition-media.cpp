@@ -86,8 +86,11 @@ bool MacroConditionMedia::CheckTime()
 	return match;
 }
 
-bool MacroConditionMedia::CheckState()
+bool MacroConditionMedia::CheckState(
+	const std::set<OBSStateTracker::MediaEvent> &events)
 {
+	using Event = OBSStateTracker::MediaEvent;
+
 	OBSSourceAutoRelease s =
 		obs_weak_source_get_source(_source.GetSource());
 	obs_media_state currentState = obs_source_media_get_state(s);
@@ -98,13 +101,15 @@ bool MacroConditionMedia::CheckState()
 
 	switch (_state) {
 	case State::OBS_MEDIA_STATE_STOPPED:
-		match = _stopped || currentState == OBS_MEDIA_STATE_STOPPED;
+		match = events.count(Event::STOPPED) ||
+			currentState == OBS_MEDIA_STATE_STOPPED;
 		break;
 	case State::OBS_MEDIA_STATE_ENDED:
-		match = _ended || currentState == OBS_MEDIA_STATE_ENDED;
+		match = events.count(Event::ENDED) ||
+			currentState == OBS_MEDIA_STATE_ENDED;
 		break;
 	case State::PLAYLIST_ENDED:
-		match = CheckPlaylistEnd(currentState);
+		match = CheckPlaylistEnd(currentState, events);
 		break;
 	case State::ANY:
 		match = true;
@@ -124,16 +129,22 @@ bool MacroConditionMedia::CheckState()
 	return match;
 }
 
-bool MacroConditionMedia::CheckPlaylistEnd(const obs_media_state currentState)
+bool MacroConditionMedia::CheckPlaylistEnd(
+	const obs_media_state currentState,
+	const std::set<OBSStateTracker::MediaEvent> &events)
 {
+	using Event = OBSStateTracker::MediaEvent;
+
 	bool consecutiveEndedStates = false;
-	if (_next || currentState != OBS_MEDIA_STATE_ENDED) {
+	if (events.count(Event::NEXT) ||
+	    currentState != OBS_MEDIA_STATE_ENDED) {
 		_previousStateEnded = false;
 	}
 	if (currentState == OBS_MEDIA_STATE_ENDED && _previousStateEnded) {
 		consecutiveEndedStates = true;
 	}
-	_previousStateEnded = _ended || currentState == OBS_MEDIA_STATE_ENDED;
+	_previousStateEnded = events.count(Event::ENDED) ||
+			      currentState == OBS_MEDIA_STATE_ENDED;
 	return consecutiveEndedStates;
 }
 
@@ -143,29 +154,44 @@ bool MacroConditionMedia::CheckMediaMatch()
 		return false;
 	}
 
+	// Always query the events so only events since the last check are
+	// considered once the check type changes
+	const auto events = GetMediaEvents();
+
 	bool matched = false;
 	switch (_checkType) {
 	case CheckType::STATE:
-		matched = CheckState();
+		matched = CheckState(events);
 		break;
 	case CheckType::TIME:
 		matched = CheckTime();
 		break;
 	case CheckType::LEGACY:
-		matched = CheckState() && CheckTime();
+		matched = CheckState(events) && CheckTime();
 		break;
 	default:
 		break;
 	}
-
-	// reset for next check
-	_stopped = false;
-	_ended = false;
-	_next = false;
-
 	return matched;
 }
 
+std::set<OBSStateTracker::MediaEvent> MacroConditionMedia::GetMediaEvents()
+{
+	// The selected source might change without ResetEventTracking() being
+	// called if it is determined by a variable
+	const auto source = _source.GetSource();
+	const bool macroWasPausedSinceLastCheck =
+		MacroWasPausedSince(GetMacro(), _lastCheck);
+	_lastCheck = std::chrono::high_resolution_clock::now();
+	// Events which occurred while the macro was paused are ignored
+	if (source != _trackedSource || macroWasPausedSinceLastCheck) {
+		ResetEventTracking();
+		return {};
+	}
+	return OBSStateTracker::Instance().GetEventsSince(source,
+							  _lastEventId);
+}
+
 void MacroConditionMedia::HandleSceneChange()
 {
 	UpdateMediaSourcesOfSceneList();
@@ -185,7 +211,7 @@ MacroConditionMedia::MacroConditionMedia(const MacroConditionMedia &other)
 	  _time(other._time),
 	  _lastConfigureScene(other._lastConfigureScene)
 {
-	ResetSignalHandler();
+	ResetEventTracking();
 }
 
 MacroConditionMedia &
@@ -201,7 +227,7 @@ MacroConditionMedia::operator=(const MacroConditionMedia &other)
 	_time = other._time;
 	_lastConfigureScene = other._lastConfigureScene;
 
-	ResetSignalHandler();
+	ResetEventTracking();
 
 	return *this;
 }
@@ -305,7 +331,7 @@ bool MacroConditionMedia::Load(obs_data_t *obj)
 	_time.Load(obj);
 
 	if (_sourceType == SourceType::SOURCE) {
-		ResetSignalHandler();
+		ResetEventTracking();
 	}
 
 	UpdateMediaSourcesOfSceneList();
@@ -357,45 +383,11 @@ bool MacroConditionMedia::IsUsingLegacyCheck() const
 	       _timeRestriction != Time::TIME_RESTRICTION_NONE;
 }
 
-void MacroConditionMedia::ResetSignalHandler()
-{
-	_signals.clear();
-	OBSSourceAutoRelease mediasource =
-		obs_weak_source_get_source(_source.GetSource());
-	signal_handler_t *sh = obs_source_get_signal_handler(mediasource);
-	_signals.emplace_back(sh, "media_stopped", MediaStopped, this);
-	_signals.emplace_back(sh, "media_ended", MediaEnded, this);
-	_signals.emplace_back(sh, "media_next", MediaNext, this);
-}
-
-void MacroConditionMedia::MediaStopped(void *data, calldata_t *)
+void MacroConditionMedia::ResetEventTracking()
 {
-	MacroConditionMedia *media = static_cast<MacroConditionMedia *>(data);
-	const auto macro = media->GetMacro();
-	if (MacroIsPaused(macro)) {
-		return;
-	}
-	media->_stopped = true;
-}
-
-void MacroConditionMedia::MediaEnded(void *data, calldata_t *)
-{
-	MacroConditionMedia *media = static_cast<MacroConditionMedia *>(data);
-	const auto macro = media->GetMacro();
-	if (MacroIsPaused(macro)) {
-		return;
-	}
-	media->_ended = true;
-}
-
-void MacroConditionMedia::MediaNext(void *data, calldata_t *)
-{
-	MacroConditionMedia *media = static_cast<MacroConditionMedia *>(data);
-	const auto macro = media->GetMacro();
-	if (MacroIsPaused(macro)) {
-		return;
-	}
-	media->_next = true;
+	_trackedSource = _source.GetSource();
+	_lastEventId =
+		OBSStateTracker::Instance().GetLatestEventId(_trackedSource);
 }
 
 static void populateSateSelection(QComboBox *list, bool addLegacyEntries)
@@ -526,7 +518,7 @@ void MacroConditionMediaEdit::SourceTypeChanged(int idx)
 		_entryData->_sourceGroup.clear();
 	}
 
-	_entryData->ResetSignalHandler();
+	_entryData->ResetEventTracking();
 	emit HeaderInfoChanged(
 		QString::fromStdString(_entryData->GetShortDesc()));
 
@@ -547,7 +539,7 @@ void MacroConditionMediaEdit::SourceChanged(const SourceSelection &source)
 	_entryData->_sourceGroup.clear();
 	_entryData->_sourceType = MacroConditionMedia::SourceType::SOURCE;
 	_entryData->_source = source;
-	_entryData->ResetSignalHandler();
+	_entryData->ResetEventTracking();
 	emit HeaderInfoChanged(
 		QString::fromStdString(_entryData->GetShortDesc()));
 	SetWidgetVisibility();
@@ -1,6 +1,7 @@
 #pragma once
 #include "macro-condition-edit.hpp"
 #include "duration-control.hpp"
+#include "obs-state-tracker.hpp"
 #include "scene-selection.hpp"
 #include "source-selection.hpp"
 
@@ -26,11 +27,8 @@ public:
 	{
 		return std::make_shared<MacroConditionMedia>(m);
 	}
-	void ResetSignalHandler();
+	void ResetEventTracking();
 	void UpdateMediaSourcesOfSceneList();
-	static void MediaStopped(void *data, calldata_t *);
-	static void MediaEnded(void *data, calldata_t *);
-	static void MediaNext(void *data, calldata_t *);
 
 	enum class SourceType { SOURCE, ANY, ALL };
 	SourceType _sourceType = SourceType::SOURCE;
@@ -74,16 +72,17 @@ public:
 private:
 	bool IsUsingLegacyCheck() const;
 	bool CheckTime();
-	bool CheckState();
-	bool CheckPlaylistEnd(const obs_media_state);
+	bool CheckState(const std::set<OBSStateTracker::MediaEvent> &);
+	bool CheckPlaylistEnd(const obs_media_state,
+			      const std::set<OBSStateTracker::MediaEvent> &);
 	bool CheckMediaMatch();
+	std::set<OBSStateTracker::MediaEvent> GetMediaEvents();
 	void HandleSceneChange();
 
-	std::vector<OBSSignal> _signals;
-
-	bool _stopped = false;
-	bool _ended = false;
-	bool _next = false;
+	// Source and id of the last media event seen by this condition
+	OBSWeakSource _trackedSource;
+	uint64_t _lastEventId = 0;
+	std::chrono::high_resolution_clock::time_point _lastCheck{};
 
 	// Workaround to enable use of "ended" to specify end of VLC playlist
 	bool _previousStateEnded = false;
@@ -1,18 +1,18 @@
 #pragma once
 #include "macro-condition-edit.hpp"
+#include "duration-control.hpp"
+#include "obs-stats-sampler.hpp"
 #include "variable-spinbox.hpp"
 
 #include <obs.hpp>
 #include <QWidget>
 #include <QComboBox>
-#include <util/platform.h>
 
 namespace advss {
 
 class MacroConditionStats : public MacroCondition {
 public:
 	MacroConditionStats(Macro *m);
-	~MacroConditionStats();
 	bool CheckCondition();
 	bool Save(obs_data_t *obj) const;
 	bool Load(obs_data_t *obj);
@@ -49,38 +49,13 @@ public:
 	};
 	Condition _condition = Condition::ABOVE;
 
+	using Aggregation = OBSStatsSampler::Aggregation;
+	Aggregation _aggregation = Aggregation::CURRENT;
+	Duration _window = 10.0;
+	DoubleVariable _percentile = 95.0;
+
 private:
-	bool CheckFPS() const;
-	bool CheckCPU() const;
-	bool CheckMemory() const;
-	bool CheckAvgFrametime() const;
-	bool CheckRenderLag();
-	bool CheckEncodeLag();
-	bool CheckStreamDroppedFrames();
-	bool CheckStreamBitrate();
-	bool CheckStreamMBSent() const;
-	bool CheckRecordingDroppedFrames();
-	bool CheckRecordingBitrate();
-	bool CheckRecordingMBSent() const;
-	bool CheckDiskUsage() const;
-
-	os_cpu_usage_info_t *_cpu_info = nullptr;
-	uint32_t _first_encoded = 0xFFFFFFFF;
-	uint32_t _first_skipped = 0xFFFFFFFF;
-	uint32_t _first_rendered = 0xFFFFFFFF;
-	uint32_t _first_lagged = 0xFFFFFFFF;
-	struct OutputInfo {
-		void Update(obs_output_t *output);
-
-		uint64_t lastBytesSent = 0;
-		uint64_t lastBytesSentTime = 0;
-		int first_total = 0;
-		int first_dropped = 0;
-		double dropped_relative = 0.0;
-		long double kbps = 0.0l;
-	};
-	OutputInfo _streamInfo;
-	OutputInfo _recordingInfo;
+	std::shared_ptr<OBSStatsSampler> _sampler;
 
 	static bool _registered;
 	static const std::string id;
@@ -106,6 +81,9 @@ private slots:
 	void ValueChanged(const NumberVariable<double> &value);
 	void StatsTypeChanged(int type);
 	void ConditionChanged(int cond);
+	void AggregationChanged(int);
+	void WindowChanged(const Duration &);
+	void PercentileChanged(const NumberVariable<double> &);
 
 signals:
 	void HeaderInfoChanged(const QString &);
@@ -116,6 +94,9 @@ private:
 	QComboBox *_stats;
 	QComboBox *_condition;
 	VariableDoubleSpinBox *_value;
+	QComboBox *_aggregation;
+	DurationSelection *_window;
+	VariableDoubleSpinBox *_percentile;
 
 	std::shared_ptr<MacroConditionStats> _entryData;
 	bool _loading = true;
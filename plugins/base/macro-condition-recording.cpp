@@ -1,9 +1,6 @@
 #include "macro-condition-recording.hpp"
 #include "layout-helpers.hpp"
 
-#include <obs-frontend-api.h>
-#include <thread>
-
 namespace advss {
 
 const std::string MacroConditionRecord::id = "recording";
@@ -25,24 +22,40 @@ const static std::map<MacroConditionRecord::Condition, std::string>
 		 "AdvSceneSwitcher.condition.record.state.duration"},
 };
 
-static bool SetupRecordingTimer();
-static bool recordingTimerIsSetup = SetupRecordingTimer();
-static int currentRecordingDurationInSeconds = 0;
+MacroConditionRecord::MacroConditionRecord(Macro *m)
+	: MacroCondition(m),
+	  _lastEventId(OBSStateTracker::Instance().GetLatestEventId(
+		  OBSStateTracker::Output::RECORDING))
+{
+}
 
 bool MacroConditionRecord::CheckCondition()
 {
+	using Output = OBSStateTracker::Output;
+	using Event = OBSStateTracker::OutputEvent;
+
+	auto &tracker = OBSStateTracker::Instance();
+	const auto events =
+		tracker.GetEventsSince(Output::RECORDING, _lastEventId);
+
 	switch (_condition) {
 	case Condition::STOP:
-		return !obs_frontend_recording_active();
+		return !tracker.IsActive(Output::RECORDING) ||
+		       events.count(Event::STOPPED);
 	case Condition::PAUSE:
-		return obs_frontend_recording_paused();
+		return tracker.IsPaused(Output::RECORDING) ||
+		       events.count(Event::PAUSED);
 	case Condition::START:
-		return obs_frontend_recording_active();
-	case Condition::DURATION:
-		SetTempVarValue(
-			"durationSeconds",
-			std::to_string(currentRecordingDurationInSeconds));
-		return currentRecordingDurationInSeconds > _duration.Seconds();
+		return tracker.IsActive(Output::RECORDING) ||
+		       events.count(Event::STARTED);
+	case Condition::DURATION: {
+		const auto seconds =
+			std::chrono::duration_cast<std::chrono::seconds>(
+				tracker.GetActiveDuration(Output::RECORDING))
+				.count();
+		SetTempVarValue("durationSeconds", std::to_string(seconds));
+		return seconds > _duration.Seconds();
+	}
 	default:
 		break;
 	}
@@ -160,45 +173,4 @@ void MacroConditionRecordEdit::SetWidgetVisibility()
 			      MacroConditionRecord::Condition::DURATION);
 }
 
-bool SetupRecordingTimer()
-{
-	static std::atomic_bool recordingStopped = {true};
-	static std::atomic_bool recordingPaused = {false};
-	static auto handleRecordingEvents = [](enum obs_frontend_event event,
-					       void *) {
-		switch (event) {
-		case OBS_FRONTEND_EVENT_RECORDING_STOPPED:
-			recordingStopped = true;
-			break;
-		case OBS_FRONTEND_EVENT_RECORDING_STARTED:
-			recordingStopped = false;
-			break;
-		case OBS_FRONTEND_EVENT_RECORDING_PAUSED:
-			recordingPaused = true;
-			break;
-		case OBS_FRONTEND_EVENT_RECORDING_UNPAUSED:
-			recordingPaused = false;
-			break;
-		default:
-			break;
-		};
-	};
-	obs_frontend_add_event_callback(handleRecordingEvents, nullptr);
-	std::thread thread([]() {
-		while (true) {
-			std::this_thread::sleep_for(std::chrono::seconds(1));
-			if (recordingStopped) {
-				currentRecordingDurationInSeconds = 0;
-				continue;
-			}
-			if (recordingPaused) {
-				continue;
-			}
-			++currentRecordingDurationInSeconds;
-		}
-	});
-	thread.detach();
-	return true;
-}
-
 } // namespace advss
@@ -1,5 +1,6 @@
 #pragma once
 #include "macro-condition-edit.hpp"
+#include "obs-state-tracker.hpp"
 
 #include <QWidget>
 #include <QComboBox>
@@ -8,7 +9,7 @@ namespace advss {
 
 class MacroConditionRecord : public MacroCondition {
 public:
-	MacroConditionRecord(Macro *m) : MacroCondition(m) {}
+	MacroConditionRecord(Macro *m);
 	bool CheckCondition();
 	bool Save(obs_data_t *obj) const;
 	bool Load(obs_data_t *obj);
@@ -33,6 +34,7 @@ private:
 	void SetupTempVars();
 
 	Condition _condition = Condition::STOP;
+	uint64_t _lastEventId = 0;
 	static bool _registered;
 	static const std::string id;
 };
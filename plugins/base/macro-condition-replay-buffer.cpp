@@ -1,8 +1,6 @@
 #include "macro-condition-replay-buffer.hpp"
 #include "layout-helpers.hpp"
 
-#include <obs-frontend-api.h>
-
 namespace advss {
 
 const std::string MacroConditionReplayBuffer::id = "replay_buffer";
@@ -22,49 +20,31 @@ const static std::map<MacroConditionReplayBuffer::Condition, std::string>
 		 "AdvSceneSwitcher.condition.replay.state.saved"},
 };
 
-static std::chrono::high_resolution_clock::time_point replayBufferSaveTime{};
-static bool setupReplayBufferEventHandler();
-static bool replayBufferEventHandlerIsSetup = setupReplayBufferEventHandler();
-
-static bool setupReplayBufferEventHandler()
+MacroConditionReplayBuffer::MacroConditionReplayBuffer(Macro *m)
+	: MacroCondition(m),
+	  _lastEventId(OBSStateTracker::Instance().GetLatestEventId(
+		  OBSStateTracker::Output::REPLAY_BUFFER))
 {
-	static auto handleReplayBufferEvent = [](enum obs_frontend_event event,
-						 void *) {
-		switch (event) {
-		case OBS_FRONTEND_EVENT_REPLAY_BUFFER_SAVED:
-			replayBufferSaveTime =
-				std::chrono::high_resolution_clock::now();
-			break;
-		default:
-			break;
-		};
-	};
-	obs_frontend_add_event_callback(handleReplayBufferEvent, nullptr);
-	return true;
 }
 
-bool MacroConditionReplayBuffer::ReplayBufferWasSaved()
+bool MacroConditionReplayBuffer::CheckCondition()
 {
-	if (!_saveTimeInitialized) {
-		_saveTime = replayBufferSaveTime;
-		_saveTimeInitialized = true;
-		return false;
-	}
+	using Output = OBSStateTracker::Output;
+	using Event = OBSStateTracker::OutputEvent;
 
-	bool newSaveOccurred = _saveTime != replayBufferSaveTime;
-	_saveTime = replayBufferSaveTime;
-	return newSaveOccurred;
-}
+	auto &tracker = OBSStateTracker::Instance();
+	const auto events =
+		tracker.GetEventsSince(Output::REPLAY_BUFFER, _lastEventId);
 
-bool MacroConditionReplayBuffer::CheckCondition()
-{
 	switch (_state) {
 	case Condition::STOP:
-		return !obs_frontend_replay_buffer_active();
+		return !tracker.IsActive(Output::REPLAY_BUFFER) ||
+		       events.count(Event::STOPPED);
 	case Condition::START:
-		return obs_frontend_replay_buffer_active();
+		return tracker.IsActive(Output::REPLAY_BUFFER) ||
+		       events.count(Event::STARTED);
 	case Condition::SAVE:
-		return ReplayBufferWasSaved();
+		return events.count(Event::SAVED);
 	default:
 		break;
 	}
@@ -1,5 +1,6 @@
 #pragma once
 #include "macro-condition-edit.hpp"
+#include "obs-state-tracker.hpp"
 
 #include <QWidget>
 #include <QComboBox>
@@ -8,7 +9,7 @@ namespace advss {
 
 class MacroConditionReplayBuffer : public MacroCondition {
 public:
-	MacroConditionReplayBuffer(Macro *m) : MacroCondition(m) {}
+	MacroConditionReplayBuffer(Macro *m);
 	bool CheckCondition();
 	bool Save(obs_data_t *obj) const;
 	bool Load(obs_data_t *obj);
@@ -27,10 +28,7 @@ public:
 	Condition _state = Condition::STOP;
 
 private:
-	bool ReplayBufferWasSaved();
-
-	bool _saveTimeInitialized = false;
-	std::chrono::high_resolution_clock::time_point _saveTime = {};
+	uint64_t _lastEventId = 0;
 	static bool _registered;
 	static const std::string id;
 };
@@ -2,8 +2,6 @@
 #include "profile-helpers.hpp"
 #include "layout-helpers.hpp"
 
-#include <obs-frontend-api.h>
-
 namespace advss {
 
 const std::string MacroConditionStream::id = "streaming";
@@ -27,30 +25,11 @@ const static std::map<MacroConditionStream::Condition, std::string>
 		 "AdvSceneSwitcher.condition.stream.state.keyFrameInterval"},
 };
 
-static bool setupStreamingEventHandler();
-static bool steamingEventHandlerIsSetup = setupStreamingEventHandler();
-static std::chrono::high_resolution_clock::time_point streamStartTime{};
-static std::chrono::high_resolution_clock::time_point streamStopTime{};
-
-bool setupStreamingEventHandler()
+MacroConditionStream::MacroConditionStream(Macro *m)
+	: MacroCondition(m),
+	  _lastEventId(OBSStateTracker::Instance().GetLatestEventId(
+		  OBSStateTracker::Output::STREAMING))
 {
-	static auto handleStreamingEvents = [](enum obs_frontend_event event,
-					       void *) {
-		switch (event) {
-		case OBS_FRONTEND_EVENT_STREAMING_STARTING:
-			streamStartTime =
-				std::chrono::high_resolution_clock::now();
-			break;
-		case OBS_FRONTEND_EVENT_STREAMING_STOPPING:
-			streamStopTime =
-				std::chrono::high_resolution_clock::now();
-			break;
-		default:
-			break;
-		};
-	};
-	obs_frontend_add_event_callback(handleStreamingEvents, nullptr);
-	return true;
 }
 
 int MacroConditionStream::GetKeyFrameInterval() const
@@ -66,26 +45,54 @@ int MacroConditionStream::GetKeyFrameInterval() const
 	return ret;
 }
 
-bool MacroConditionStream::CheckCondition()
+// The duration includes the time it took to connect, as it is measured from
+// the time the stream was starting
+static int64_t getStreamDurationSeconds(const OBSStateTracker &tracker)
 {
-	bool match = false;
+	using Output = OBSStateTracker::Output;
 
-	bool streamStarting = streamStartTime != _lastStreamStartingTime;
-	bool streamStopping = streamStopTime != _lastStreamStoppingTime;
+	if (!tracker.IsActive(Output::STREAMING)) {
+		return 0;
+	}
+	const auto starting = tracker.GetLastEventTime(
+		Output::STREAMING, OBSStateTracker::OutputEvent::STARTING);
+	// Streams started before the tracker was set up have no such event
+	if (!starting) {
+		return std::chrono::duration_cast<std::chrono::seconds>(
+			       tracker.GetActiveDuration(Output::STREAMING))
+			.count();
+	}
+	return std::chrono::duration_cast<std::chrono::seconds>(
+		       OBSStateTracker::Clock::now() - *starting)
+		.count();
+}
+
+bool MacroConditionStream::CheckCondition()
+{
+	using Output = OBSStateTracker::Output;
+	using Event = OBSStateTracker::OutputEvent;
+
+	auto &tracker = OBSStateTracker::Instance();
+	// Also consider transitions between two checks, which would otherwise
+	// be missed
+	const auto events =
+		tracker.GetEventsSince(Output::STREAMING, _lastEventId);
+	const bool active = tracker.IsActive(Output::STREAMING);
 	const int keyFrameInterval = GetKeyFrameInterval();
 
+	bool match = false;
 	switch (_condition) {
 	case Condition::STOP:
-		match = !obs_frontend_streaming_active();
+		match = !active || events.count(Event::STOPPED);
 		break;
 	case Condition::START:
-		match = obs_frontend_streaming_active();
+		match = active || events.count(Event::STARTED);
 		break;
 	case Condition::STARTING:
-		match = streamStarting;
+		match = events.count(Event::STARTING);
 		break;
 	case Condition::STOPPING:
-		match = streamStopping;
+		match = events.count(Event::STOPPING);
 		break;
 	case Condition::KEYFRAME_INTERVAL:
 		match = keyFrameInterval == _keyFrameInterval;
@@ -94,19 +101,8 @@ bool MacroConditionStream::CheckCondition()
 		break;
 	}
 
-	if (streamStarting) {
-		_lastStreamStartingTime = streamStartTime;
-	}
-	if (streamStopping) {
-		_lastStreamStoppingTime = streamStopTime;
-	}
-
-	const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
-		std::chrono::high_resolution_clock::now() - streamStartTime);
-	const auto streamDurationSeconds =
-		obs_frontend_streaming_active() ? seconds.count() : 0;
 	SetTempVarValue("durationSeconds",
-			std::to_string(streamDurationSeconds));
+			std::to_string(getStreamDurationSeconds(tracker)));
 	SetTempVarValue("keyframeInterval", std::to_string(keyFrameInterval));
 
 	return match;
@@ -1,5 +1,6 @@
 #pragma once
 #include "macro-condition-edit.hpp"
+#include "obs-state-tracker.hpp"
 #include "variable-spinbox.hpp"
 
 #include <QWidget>
@@ -9,7 +10,7 @@ namespace advss {
 
 class MacroConditionStream : public MacroCondition {
 public:
-	MacroConditionStream(Macro *m) : MacroCondition(m) {}
+	MacroConditionStream(Macro *m);
 	bool CheckCondition();
 	bool Save(obs_data_t *obj) const;
 	bool Load(obs_data_t *obj);
@@ -33,8 +34,7 @@ private:
 	void SetupTempVars();
 	int GetKeyFrameInterval() const;
 
-	std::chrono::high_resolution_clock::time_point _lastStreamStartingTime{};
-	std::chrono::high_resolution_clock::time_point _lastStreamStoppingTime{};
+	uint64_t _lastEventId = 0;
 
 	static bool _registered;
 	static const std::string id;
@@ -1,8 +1,6 @@
 #include "macro-condition-virtual-cam.hpp"
 #include "layout-helpers.hpp"
 
-#include <obs-frontend-api.h>
-
 namespace advss {
 
 const std::string MacroConditionVCam::id = "virtual_cam";
@@ -19,22 +17,35 @@ const static std::map<VCamState, std::string> VCamStates = {
 	 "AdvSceneSwitcher.condition.virtualCamera.state.start"},
 };
 
+MacroConditionVCam::MacroConditionVCam(Macro *m)
+	: MacroCondition(m),
+	  _lastEventId(OBSStateTracker::Instance().GetLatestEventId(
+		  OBSStateTracker::Output::VIRTUAL_CAM))
+{
+}
+
 bool MacroConditionVCam::CheckCondition()
 {
-	bool stateMatch = false;
 #if LIBOBS_API_VER >= MAKE_SEMANTIC_VERSION(27, 0, 0)
+	using Output = OBSStateTracker::Output;
+	using Event = OBSStateTracker::OutputEvent;
+
+	auto &tracker = OBSStateTracker::Instance();
+	const auto events =
+		tracker.GetEventsSince(Output::VIRTUAL_CAM, _lastEventId);
+
 	switch (_state) {
 	case VCamState::STOP:
-		stateMatch = !obs_frontend_virtualcam_active();
-		break;
+		return !tracker.IsActive(Output::VIRTUAL_CAM) ||
+		       events.count(Event::STOPPED);
 	case VCamState::START:
-		stateMatch = obs_frontend_virtualcam_active();
-		break;
+		return tracker.IsActive(Output::VIRTUAL_CAM) ||
+		       events.count(Event::STARTED);
 	default:
 		break;
 	}
 #endif
-	return stateMatch;
+	return false;
 }
 
 bool MacroConditionVCam::Save(obs_data_t *obj) const
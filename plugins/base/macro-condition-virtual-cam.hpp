@@ -1,5 +1,6 @@
 #pragma once
 #include "macro-condition-edit.hpp"
+#include "obs-state-tracker.hpp"
 
 #include <QWidget>
 #include <QComboBox>
@@ -13,7 +14,7 @@ enum class VCamState {
 
 class MacroConditionVCam : public MacroCondition {
 public:
-	MacroConditionVCam(Macro *m) : MacroCondition(m) {}
+	MacroConditionVCam(Macro *m);
 	bool CheckCondition();
 	bool Save(obs_data_t *obj) const;
 	bool Load(obs_data_t *obj);
@@ -26,6 +27,8 @@ public:
 	VCamState _state = VCamState::STOP;
 
 private:
+	uint64_t _lastEventId = 0;
+
 	static bool _registered;
 	static const std::string id;
 };
@@ -19,6 +19,8 @@ const static std::map<MacroConditionWebsocket::Type, std::string>
 		 "AdvSceneSwitcher.condition.websocket.type.request"},
 		{MacroConditionWebsocket::Type::EVENT,
 		 "AdvSceneSwitcher.condition.websocket.type.event"},
+		{MacroConditionWebsocket::Type::RESPONSE,
+		 "AdvSceneSwitcher.condition.websocket.type.response"},
 };
 
 MacroConditionWebsocket::MacroConditionWebsocket(Macro *m)
@@ -42,7 +44,8 @@ bool MacroConditionWebsocket::CheckCondition()
 	}
 
 	while (!_messageBuffer->Empty()) {
-		auto message = _messageBuffer->ConsumeMessage();
+		std::chrono::steady_clock::time_point arrival;
+		auto message = _messageBuffer->ConsumeMessage(arrival);
 		if (!message) {
 			continue;
 		}
@@ -51,6 +54,7 @@ bool MacroConditionWebsocket::CheckCondition()
 				continue;
 			}
 
+			TraceTriggerEvent("websocket", arrival);
 			SetTempVarValue("message", *message);
 			SetVariableValue(*message);
 			if (_clearBufferOnMatch) {
@@ -62,6 +66,7 @@ bool MacroConditionWebsocket::CheckCondition()
 				continue;
 			}
 
+			TraceTriggerEvent("websocket", arrival);
 			SetTempVarValue("message", *message);
 			SetVariableValue(*message);
 			if (_clearBufferOnMatch) {
@@ -125,12 +130,7 @@ void MacroConditionWebsocket::SetType(Type type)
 		_messageBuffer = RegisterForWebsocketMessages();
 		return;
 	}
-
-	auto connection = _connection.lock();
-	if (!connection) {
-		return;
-	}
-	_messageBuffer = connection->RegisterForEvents();
+	RegisterForConnectionMessages();
 }
 
 void MacroConditionWebsocket::SetConnection(const std::string &connectionName)
@@ -140,12 +140,18 @@ void MacroConditionWebsocket::SetConnection(const std::string &connectionName)
 		// This should not really happen, but let's be safe
 		return;
 	}
+	RegisterForConnectionMessages();
+}
 
+void MacroConditionWebsocket::RegisterForConnectionMessages()
+{
 	auto connection = _connection.lock();
 	if (!connection) {
 		return;
 	}
-	_messageBuffer = connection->RegisterForEvents();
+	_messageBuffer = _type == Type::RESPONSE
+				 ? connection->RegisterForResponses()
+				 : connection->RegisterForEvents();
 }
 
 std::weak_ptr<WSConnection> MacroConditionWebsocket::GetConnection() const
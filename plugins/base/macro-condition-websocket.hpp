@@ -25,6 +25,7 @@ public:
 	enum class Type {
 		REQUEST,
 		EVENT,
+		RESPONSE,
 	};
 
 	void SetType(Type);
@@ -37,6 +38,7 @@ public:
 
 private:
 	void SetupTempVars();
+	void RegisterForConnectionMessages();
 
 	Type _type = Type::REQUEST;
 	std::weak_ptr<WSConnection> _connection;
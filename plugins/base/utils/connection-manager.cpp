@@ -157,6 +157,20 @@ void WSConnection::SendMsg(const std::string &msg)
 	}
 }
 
+std::future<WSRequestResponse>
+WSConnection::SendRequest(const std::string &msg,
+			  std::chrono::milliseconds timeout)
+{
+	if (!_useOBSWSProtocol ||
+	    _client.GetStatus() != WSClientConnection::Status::AUTHENTICATED) {
+		SendMsg(msg);
+		std::promise<WSRequestResponse> promise;
+		promise.set_value({});
+		return promise.get_future();
+	}
+	return _client.QueueRequest(msg, timeout);
+}
+
 void WSConnection::Load(obs_data_t *obj)
 {
 	Item::Load(obj);
@@ -205,6 +219,11 @@ WebsocketMessageBuffer WSConnection::RegisterForEvents()
 	return _client.RegisterForEvents();
 }
 
+WebsocketMessageBuffer WSConnection::RegisterForResponses()
+{
+	return _client.RegisterForResponses();
+}
+
 void WSConnection::UseOBSWebsocketProtocol(bool useOBSWSProtocol)
 {
 	_useOBSWSProtocol = useOBSWSProtocol;
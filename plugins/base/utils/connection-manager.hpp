@@ -38,10 +38,14 @@ public:
 
 	void Reconnect();
 	void SendMsg(const std::string &msg);
+	// Only supported when using the obs-websocket protocol
+	std::future<WSRequestResponse>
+	SendRequest(const std::string &msg, std::chrono::milliseconds timeout);
 	void Load(obs_data_t *obj);
 	void Save(obs_data_t *obj) const;
 	std::string GetName() const { return _name; }
 	WebsocketMessageBuffer RegisterForEvents();
+	WebsocketMessageBuffer RegisterForResponses();
 	bool IsUsingOBSProtocol() const { return _useOBSWSProtocol; }
 	std::string GetURI() const;
 	uint64_t GetPort() const { return _port; }
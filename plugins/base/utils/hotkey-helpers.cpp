@@ -2,38 +2,75 @@
 #include "obs-module-helper.hpp"
 #include "plugin-state-helpers.hpp"
 
+#include <algorithm>
+
 namespace advss {
 
-std::vector<std::weak_ptr<Hotkey>> Hotkey::_registeredHotkeys = {};
+std::unordered_map<std::string, std::vector<std::weak_ptr<Hotkey>>>
+	Hotkey::_registeredHotkeys = {};
+std::vector<std::weak_ptr<Hotkey>> Hotkey::_pendingRegistrations = {};
+bool Hotkey::_bulkLoadActive = false;
+size_t Hotkey::_cleanupThreshold = 64;
 uint32_t Hotkey::_hotkeyCounter = 0;
 
 static bool setup()
 {
-	AddLoadStep([](obs_data_t *) { Hotkey::ClearAllHotkeys(); });
+	AddLoadStep([](obs_data_t *) {
+		Hotkey::ClearAllHotkeys();
+		Hotkey::BeginBulkLoad();
+		AddPostLoadStep(Hotkey::EndBulkLoad);
+	});
 	return true;
 }
 static bool setupDone = setup();
 
-std::shared_ptr<Hotkey> Hotkey::GetHotkey(const std::string &description,
-					  bool ignoreExistingHotkeys)
+static KeyPressScheduler &getKeyPressScheduler()
 {
-	// Clean up expired hotkeys
-	auto it = _registeredHotkeys.begin();
-	while (it != _registeredHotkeys.end()) {
-		if (it->expired()) {
-			it = _registeredHotkeys.erase(it);
-		} else {
-			it++;
-		}
+#ifdef _WIN32
+	// When instantly releasing the key presses OBS might miss them
+	static KeyPressScheduler scheduler(SendKeyEvents,
+					   std::chrono::milliseconds(100),
+					   std::chrono::milliseconds(100));
+#else
+	static KeyPressScheduler scheduler(SendKeyEvents);
+#endif
+	return scheduler;
+}
+
+void PressKeys(const std::vector<HotkeyType> keys, int duration)
+{
+	if (!CanSimulateKeyPresses()) {
+		return;
+	}
+	getKeyPressScheduler().Press(keys, std::chrono::milliseconds(duration));
+}
+
+void PressKeySequence(const std::vector<KeySequenceStep> &steps)
+{
+	if (!CanSimulateKeyPresses()) {
+		return;
 	}
+	getKeyPressScheduler().PressSequence(steps);
+}
 
+void Hotkey::RemoveExpiredEntries(std::vector<std::weak_ptr<Hotkey>> &hotkeys)
+{
+	hotkeys.erase(std::remove_if(hotkeys.begin(), hotkeys.end(),
+				     [](const std::weak_ptr<Hotkey> &hotkey) {
+					     return hotkey.expired();
+				     }),
+		      hotkeys.end());
+}
+
+std::shared_ptr<Hotkey> Hotkey::GetHotkey(const std::string &description,
+					  bool ignoreExistingHotkeys)
+{
 	// Check for existing hotkey with same description
-	for (const auto &h : _registeredHotkeys) {
-		auto hotkey = h.lock();
-		if (!hotkey) {
-			continue;
-		}
-		if (hotkey->_description == description) {
+	auto it = _registeredHotkeys.find(description);
+	if (it != _registeredHotkeys.end()) {
+		RemoveExpiredEntries(it->second);
+		if (!it->second.empty()) {
+			auto hotkey = it->second.front().lock();
 			hotkey->_ignoreExistingHotkeys = ignoreExistingHotkeys;
 			return hotkey;
 		}
@@ -41,22 +78,97 @@ std::shared_ptr<Hotkey> Hotkey::GetHotkey(const std::string &description,
 
 	// Create new hotkey
 	auto hotkey = std::make_shared<Hotkey>(description);
-	_registeredHotkeys.emplace_back(hotkey);
 	hotkey->_ignoreExistingHotkeys = ignoreExistingHotkeys;
+	hotkey->AddToIndex();
+	if (_bulkLoadActive) {
+		_pendingRegistrations.emplace_back(hotkey);
+	} else {
+		hotkey->Register();
+	}
 	return hotkey;
 }
 
-Hotkey::Hotkey(const std::string &description) : _description(description)
+void Hotkey::BeginBulkLoad()
+{
+	_bulkLoadActive = true;
+}
+
+void Hotkey::EndBulkLoad()
+{
+	_bulkLoadActive = false;
+	for (const auto &weakHotkey : _pendingRegistrations) {
+		auto hotkey = weakHotkey.lock();
+		if (!hotkey || hotkey->_hotkeyID != OBS_INVALID_HOTKEY_ID) {
+			continue;
+		}
+		hotkey->Register();
+	}
+	_pendingRegistrations.clear();
+}
+
+Hotkey::Hotkey(const std::string &description)
+	: _name(GetNameFromDescription(description)),
+	  _description(description)
 {
-	_hotkeyID = obs_hotkey_register_frontend(
-		GetNameFromDescription(description).c_str(),
-		_description.c_str(), Callback, this);
 	_hotkeyCounter++;
 }
 
+void Hotkey::Register()
+{
+	_hotkeyID = obs_hotkey_register_frontend(
+		_name.c_str(), _description.c_str(), Callback, this);
+	if (_pendingKeyBindings) {
+		obs_hotkey_load(_hotkeyID, _pendingKeyBindings);
+		_pendingKeyBindings = nullptr;
+	}
+}
+
+void Hotkey::AddToIndex()
+{
+	// Expired entries are usually only removed when looking up their
+	// description, so check all entries once in a while
+	if (_registeredHotkeys.size() > _cleanupThreshold) {
+		for (auto it = _registeredHotkeys.begin();
+		     it != _registeredHotkeys.end();) {
+			RemoveExpiredEntries(it->second);
+			if (it->second.empty()) {
+				it = _registeredHotkeys.erase(it);
+			} else {
+				++it;
+			}
+		}
+		_cleanupThreshold =
+			std::max<size_t>(64, _registeredHotkeys.size() * 2);
+	}
+	_registeredHotkeys[_description].emplace_back(weak_from_this());
+}
+
+void Hotkey::RemoveFromIndex()
+{
+	auto it = _registeredHotkeys.find(_description);
+	if (it == _registeredHotkeys.end()) {
+		return;
+	}
+	auto &hotkeys = it->second;
+	hotkeys.erase(std::remove_if(hotkeys.begin(), hotkeys.end(),
+				     [this](const std::weak_ptr<Hotkey> &h) {
+					     auto hotkey = h.lock();
+					     return !hotkey ||
+						    hotkey.get() == this;
+				     }),
+		      hotkeys.end());
+	if (hotkeys.empty()) {
+		_registeredHotkeys.erase(it);
+	}
+}
+
 bool Hotkey::Save(obs_data_t *obj) const
 {
 	obs_data_set_string(obj, "desc", _description.c_str());
+	if (_hotkeyID == OBS_INVALID_HOTKEY_ID) {
+		obs_data_set_array(obj, "keyBind", _pendingKeyBindings);
+		return true;
+	}
 	obs_data_array_t *hotkeyData = obs_hotkey_save(_hotkeyID);
 	obs_data_set_array(obj, "keyBind", hotkeyData);
 	obs_data_array_release(hotkeyData);
@@ -69,18 +181,28 @@ bool Hotkey::Load(obs_data_t *obj)
 	if (!DescriptionAvailable(description)) {
 		return false;
 	}
+	RemoveFromIndex();
 	_description = description;
+	AddToIndex();
+	_ignoreExistingHotkeys = false;
+
 	obs_data_array_t *hotkeyData = obs_data_get_array(obj, "keyBind");
+	if (_hotkeyID == OBS_INVALID_HOTKEY_ID) {
+		// Will be restored during registration
+		_pendingKeyBindings = hotkeyData;
+		return true;
+	}
 	obs_hotkey_load(_hotkeyID, hotkeyData);
 	obs_data_array_release(hotkeyData);
 	obs_hotkey_set_description(_hotkeyID, _description.c_str());
-	_ignoreExistingHotkeys = false;
 	return true;
 }
 
 Hotkey::~Hotkey()
 {
-	obs_hotkey_unregister(_hotkeyID);
+	if (_hotkeyID != OBS_INVALID_HOTKEY_ID) {
+		obs_hotkey_unregister(_hotkeyID);
+	}
 }
 
 bool Hotkey::UpdateDescription(const std::string &descritpion)
@@ -88,22 +210,28 @@ bool Hotkey::UpdateDescription(const std::string &descritpion)
 	if (!DescriptionAvailable(descritpion)) {
 		return false;
 	}
+	RemoveFromIndex();
 	_description = descritpion;
-	obs_hotkey_set_name(_hotkeyID,
-			    GetNameFromDescription(descritpion).c_str());
+	_name = GetNameFromDescription(descritpion);
+	AddToIndex();
+	if (_hotkeyID == OBS_INVALID_HOTKEY_ID) {
+		return true;
+	}
+	obs_hotkey_set_name(_hotkeyID, _name.c_str());
 	obs_hotkey_set_description(_hotkeyID, descritpion.c_str());
 	return true;
 }
 
 bool Hotkey::DescriptionAvailable(const std::string &descritpion)
 {
-	for (const auto &hotkey : _registeredHotkeys) {
+	auto it = _registeredHotkeys.find(descritpion);
+	if (it == _registeredHotkeys.end()) {
+		return true;
+	}
+	RemoveExpiredEntries(it->second);
+	for (const auto &hotkey : it->second) {
 		auto h = hotkey.lock();
-		if (!h) {
-			continue;
-		}
-		if (!h->_ignoreExistingHotkeys &&
-		    h->_description == descritpion) {
+		if (h && !h->_ignoreExistingHotkeys) {
 			return false;
 		}
 	}
@@ -112,15 +240,17 @@ bool Hotkey::DescriptionAvailable(const std::string &descritpion)
 
 void Hotkey::Callback(void *data, obs_hotkey_id, obs_hotkey_t *, bool pressed)
 {
+	// The hotkey is passed directly as callback data and the key state
+	// change is only delivered to the conditions using this hotkey, so no
+	// lookup is required
 	auto hotkey = static_cast<Hotkey *>(data);
-	if (pressed) {
-		hotkey->_lastPressed =
-			std::chrono::high_resolution_clock::now();
-	} else {
-		hotkey->_lastReleased =
-			std::chrono::high_resolution_clock::now();
-	}
 	hotkey->_pressed = pressed;
+	hotkey->_keyEventDispatcher.DispatchMessage(pressed);
+}
+
+std::shared_ptr<MessageBuffer<bool>> Hotkey::RegisterForKeyEvents()
+{
+	return _keyEventDispatcher.RegisterClient();
 }
 
 std::string Hotkey::GetNameFromDescription(const std::string &description)
@@ -131,6 +261,7 @@ std::string Hotkey::GetNameFromDescription(const std::string &description)
 void Hotkey::ClearAllHotkeys()
 {
 	_registeredHotkeys.clear();
+	_cleanupThreshold = 64;
 }
 
 } // namespace advss
@@ -1,5 +1,6 @@
 #include "json-helpers.hpp"
 
+#include <cctype>
 #include <QJsonDocument>
 
 namespace advss {
@@ -37,4 +38,72 @@ bool MatchJson(const std::string &json1, const std::string &json2,
 	return j1 == j2;
 }
 
+static size_t skipJsonString(const std::string &json, size_t pos)
+{
+	// pos is expected to point to the opening quote
+	for (++pos; pos < json.size(); ++pos) {
+		if (json[pos] == '\\') {
+			++pos;
+		} else if (json[pos] == '"') {
+			return pos + 1;
+		}
+	}
+	return std::string::npos;
+}
+
+static size_t skipJsonWhitespace(const std::string &json, size_t pos)
+{
+	while (pos < json.size() && std::isspace((unsigned char)json[pos])) {
+		++pos;
+	}
+	return pos;
+}
+
+std::optional<int> PeekJsonIntValue(const std::string &json,
+				    const std::string &key)
+{
+	const std::string quotedKey = "\"" + key + "\"";
+	int depth = 0;
+	size_t pos = 0;
+	while (pos < json.size()) {
+		const char c = json[pos];
+		if (c == '"') {
+			const size_t end = skipJsonString(json, pos);
+			if (end == std::string::npos) {
+				return {};
+			}
+			const bool isKey =
+				depth == 1 && end - pos == quotedKey.size() &&
+				json.compare(pos, quotedKey.size(),
+					     quotedKey) == 0;
+			pos = skipJsonWhitespace(json, end);
+			if (!isKey || pos >= json.size() || json[pos] != ':') {
+				continue;
+			}
+			pos = skipJsonWhitespace(json, pos + 1);
+			size_t numberEnd = pos;
+			if (numberEnd < json.size() && json[numberEnd] == '-') {
+				++numberEnd;
+			}
+			while (numberEnd < json.size() &&
+			       std::isdigit((unsigned char)json[numberEnd])) {
+				++numberEnd;
+			}
+			try {
+				return std::stoi(
+					json.substr(pos, numberEnd - pos));
+			} catch (const std::exception &) {
+				return {};
+			}
+		}
+		if (c == '{' || c == '[') {
+			++depth;
+		} else if (c == '}' || c == ']') {
+			--depth;
+		}
+		++pos;
+	}
+	return {};
+}
+
 } // namespace advss
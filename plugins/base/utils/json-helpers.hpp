@@ -1,4 +1,5 @@
 #pragma once
+#include <optional>
 #include <QString>
 #include <string>
 #include <regex-config.hpp>
@@ -9,5 +10,9 @@ QString FormatJsonString(std::string);
 QString FormatJsonString(QString);
 bool MatchJson(const std::string &json1, const std::string &json2,
 	       const RegexConfig &regex);
+// Only scans the top level of the given JSON object for the given key without
+// fully parsing the document
+std::optional<int> PeekJsonIntValue(const std::string &json,
+				    const std::string &key);
 
 } // namespace advss
@@ -0,0 +1,144 @@
+#include "key-press-scheduler.hpp"
+
+#include <algorithm>
+
+namespace advss {
+
+KeyPressScheduler::KeyPressScheduler(Sink sink,
+				     std::chrono::milliseconds repeatInterval,
+				     std::chrono::milliseconds minHold)
+	: _sink(std::move(sink)),
+	  _repeatInterval(repeatInterval),
+	  _minHold(minHold)
+{
+	_thread = std::thread(&KeyPressScheduler::Run, this);
+}
+
+KeyPressScheduler::~KeyPressScheduler()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_cv.notify_all();
+	if (_thread.joinable()) {
+		_thread.join();
+	}
+
+	// Make sure no keys are left pressed
+	std::vector<KeyEvent> batch;
+	for (const auto &[key, state] : _keyStates) {
+		if (state.pressCount > 0) {
+			batch.push_back({key, false});
+		}
+	}
+	if (!batch.empty()) {
+		_sink(batch);
+	}
+}
+
+void KeyPressScheduler::Press(const std::vector<HotkeyType> &keys,
+			      std::chrono::milliseconds duration)
+{
+	PressSequence({{keys, duration, {}}});
+}
+
+void KeyPressScheduler::PressSequence(const std::vector<KeySequenceStep> &steps)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	auto time = Clock::now();
+	for (const auto &step : steps) {
+		for (const auto key : step.keys) {
+			_events.emplace(time,
+					ScheduledEvent{key, EventType::PRESS});
+		}
+		time += std::max(step.hold, _minHold);
+		for (const auto key : step.keys) {
+			_events.emplace(
+				time, ScheduledEvent{key, EventType::RELEASE});
+		}
+		time += step.pause;
+	}
+	lock.unlock();
+	_cv.notify_all();
+}
+
+bool KeyPressScheduler::IsPressed(HotkeyType key) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto it = _keyStates.find(key);
+	return it != _keyStates.end() && it->second.pressCount > 0;
+}
+
+void KeyPressScheduler::Process(const ScheduledEvent &event,
+				Clock::time_point now,
+				std::vector<KeyEvent> &batch)
+{
+	auto &state = _keyStates[event.key];
+	switch (event.type) {
+	case EventType::PRESS:
+		if (++state.pressCount > 1) {
+			return;
+		}
+		++state.generation;
+		batch.push_back({event.key, true});
+		break;
+	case EventType::RELEASE:
+		if (state.pressCount == 0 || --state.pressCount > 0) {
+			return;
+		}
+		batch.push_back({event.key, false});
+		return;
+	case EventType::REPEAT:
+		if (state.pressCount == 0 ||
+		    state.generation != event.generation) {
+			return;
+		}
+		batch.push_back({event.key, true});
+		break;
+	default:
+		return;
+	}
+
+	if (_repeatInterval.count() > 0) {
+		_events.emplace(now + _repeatInterval,
+				ScheduledEvent{event.key, EventType::REPEAT,
+					       state.generation});
+	}
+}
+
+void KeyPressScheduler::Run()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (!_stop) {
+		if (_events.empty()) {
+			_cv.wait(lock);
+			continue;
+		}
+
+		const auto next = _events.begin()->first;
+		if (_cv.wait_until(lock, next) != std::cv_status::timeout &&
+		    Clock::now() < next) {
+			// Woken up early, possibly due to an earlier event
+			continue;
+		}
+
+		std::vector<KeyEvent> batch;
+		const auto now = Clock::now();
+		while (!_events.empty() && _events.begin()->first <= now) {
+			auto event = _events.begin()->second;
+			_events.erase(_events.begin());
+			Process(event, now, batch);
+		}
+
+		if (batch.empty()) {
+			continue;
+		}
+
+		lock.unlock();
+		_sink(batch);
+		lock.lock();
+	}
+}
+
+} // namespace advss
@@ -0,0 +1,86 @@
+#pragma once
+#include "hotkey-type.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace advss {
+
+struct KeyEvent {
+	HotkeyType key;
+	bool pressed;
+};
+
+struct KeySequenceStep {
+	std::vector<HotkeyType> keys;
+	// How long the keys are held down
+	std::chrono::milliseconds hold{0};
+	// Delay between releasing the keys and the start of the next step
+	std::chrono::milliseconds pause{0};
+};
+
+// Injects key press and release events from a single thread in the order of
+// their timestamps.
+// Overlapping presses of the same key are reference counted, so the key is
+// only released once the last press holding it ends.
+// All events which are due at the same time are passed to the sink as a
+// single batch.
+class KeyPressScheduler {
+public:
+	using Clock = std::chrono::steady_clock;
+	using Sink = std::function<void(const std::vector<KeyEvent> &)>;
+
+	// If repeatInterval is set, press events for keys which are still held
+	// down are sent again in the given interval.
+	// Key presses are held down for at least minHold.
+	KeyPressScheduler(Sink sink,
+			  std::chrono::milliseconds repeatInterval = {},
+			  std::chrono::milliseconds minHold = {});
+	~KeyPressScheduler();
+
+	void Press(const std::vector<HotkeyType> &keys,
+		   std::chrono::milliseconds duration);
+	void PressSequence(const std::vector<KeySequenceStep> &steps);
+	bool IsPressed(HotkeyType key) const;
+
+private:
+	enum class EventType {
+		PRESS,
+		RELEASE,
+		REPEAT,
+	};
+	struct ScheduledEvent {
+		HotkeyType key;
+		EventType type;
+		uint64_t generation = 0;
+	};
+	struct KeyState {
+		int pressCount = 0;
+		uint64_t generation = 0;
+	};
+
+	void Run();
+	void Process(const ScheduledEvent &, Clock::time_point now,
+		     std::vector<KeyEvent> &batch);
+
+	Sink _sink;
+	const std::chrono::milliseconds _repeatInterval;
+	const std::chrono::milliseconds _minHold;
+
+	// Events with identical timestamps keep their insertion order
+	std::multimap<Clock::time_point, ScheduledEvent> _events;
+	std::unordered_map<HotkeyType, KeyState> _keyStates;
+	mutable std::mutex _mutex;
+	std::condition_variable _cv;
+	std::atomic_bool _stop = {false};
+	std::thread _thread;
+};
+
+} // namespace advss
@@ -1,7 +1,6 @@
 #include "hotkey-helpers.hpp"
 #include "plugin-state-helpers.hpp"
 
-#include <thread>
 #include <unordered_map>
 
 // Qt includes must happen before X11 includes
@@ -188,7 +187,7 @@ static const std::unordered_map<HotkeyType, long> keyTable = {
 	{HotkeyType::Key_NumpadEnter, XK_KP_Enter},
 };
 
-void PressKeys(const std::vector<HotkeyType> keys, int duration)
+void SendKeyEvents(const std::vector<KeyEvent> &events)
 {
 	if (!canSimulateKeyPresses) {
 		return;
@@ -199,30 +198,15 @@ void PressKeys(const std::vector<HotkeyType> keys, int duration)
 		return;
 	}
 
-	// Press keys
-	for (auto &key : keys) {
-		auto it = keyTable.find(key);
+	for (const auto &event : events) {
+		auto it = keyTable.find(event.key);
 		if (it == keyTable.end()) {
 			continue;
 		}
-		pressFunc(display, XKeysymToKeycode(display, it->second), true,
-			  CurrentTime);
+		pressFunc(display, XKeysymToKeycode(display, it->second),
+			  event.pressed, CurrentTime);
 	}
 	XFlush(display);
-
-	std::this_thread::sleep_for(std::chrono::milliseconds(duration));
-
-	// Release keys
-	for (auto &key : keys) {
-		auto it = keyTable.find(key);
-		if (it == keyTable.end()) {
-			continue;
-		}
-		pressFunc(display, XKeysymToKeycode(display, it->second), false,
-			  CurrentTime);
-	}
-
-	XFlush(display);
 }
 
 } // namespace advss
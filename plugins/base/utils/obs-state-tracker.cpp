@@ -0,0 +1,386 @@
+#include "obs-state-tracker.hpp"
+#include "plugin-state-helpers.hpp"
+
+#include <atomic>
+
+namespace advss {
+
+static bool setup()
+{
+	// Make sure no frontend events are missed
+	auto &tracker = OBSStateTracker::Instance();
+	AddPluginCleanupStep([&tracker]() { tracker.ClearMediaSources(); });
+	return true;
+}
+
+static bool trackerIsSetup = setup();
+
+OBSStateTracker &OBSStateTracker::Instance()
+{
+	static OBSStateTracker tracker;
+	return tracker;
+}
+
+OBSStateTracker::OBSStateTracker()
+{
+	SyncOutputStates();
+	obs_frontend_add_event_callback(HandleFrontendEvent, this);
+}
+
+void OBSStateTracker::HandleFrontendEvent(enum obs_frontend_event event,
+					  void *data)
+{
+	auto tracker = static_cast<OBSStateTracker *>(data);
+	switch (event) {
+	case OBS_FRONTEND_EVENT_STREAMING_STARTING:
+		tracker->LogOutputEvent(Output::STREAMING,
+					OutputEvent::STARTING);
+		break;
+	case OBS_FRONTEND_EVENT_STREAMING_STARTED:
+		tracker->LogOutputEvent(Output::STREAMING,
+					OutputEvent::STARTED);
+		break;
+	case OBS_FRONTEND_EVENT_STREAMING_STOPPING:
+		tracker->LogOutputEvent(Output::STREAMING,
+					OutputEvent::STOPPING);
+		break;
+	case OBS_FRONTEND_EVENT_STREAMING_STOPPED:
+		tracker->LogOutputEvent(Output::STREAMING,
+					OutputEvent::STOPPED);
+		break;
+	case OBS_FRONTEND_EVENT_RECORDING_STARTING:
+		tracker->LogOutputEvent(Output::RECORDING,
+					OutputEvent::STARTING);
+		break;
+	case OBS_FRONTEND_EVENT_RECORDING_STARTED:
+		tracker->LogOutputEvent(Output::RECORDING,
+					OutputEvent::STARTED);
+		break;
+	case OBS_FRONTEND_EVENT_RECORDING_STOPPING:
+		tracker->LogOutputEvent(Output::RECORDING,
+					OutputEvent::STOPPING);
+		break;
+	case OBS_FRONTEND_EVENT_RECORDING_STOPPED:
+		tracker->LogOutputEvent(Output::RECORDING,
+					OutputEvent::STOPPED);
+		break;
+	case OBS_FRONTEND_EVENT_RECORDING_PAUSED:
+		tracker->LogOutputEvent(Output::RECORDING, OutputEvent::PAUSED);
+		break;
+	case OBS_FRONTEND_EVENT_RECORDING_UNPAUSED:
+		tracker->LogOutputEvent(Output::RECORDING,
+					OutputEvent::UNPAUSED);
+		break;
+	case OBS_FRONTEND_EVENT_REPLAY_BUFFER_STARTING:
+		tracker->LogOutputEvent(Output::REPLAY_BUFFER,
+					OutputEvent::STARTING);
+		break;
+	case OBS_FRONTEND_EVENT_REPLAY_BUFFER_STARTED:
+		tracker->LogOutputEvent(Output::REPLAY_BUFFER,
+					OutputEvent::STARTED);
+		break;
+	case OBS_FRONTEND_EVENT_REPLAY_BUFFER_STOPPING:
+		tracker->LogOutputEvent(Output::REPLAY_BUFFER,
+					OutputEvent::STOPPING);
+		break;
+	case OBS_FRONTEND_EVENT_REPLAY_BUFFER_STOPPED:
+		tracker->LogOutputEvent(Output::REPLAY_BUFFER,
+					OutputEvent::STOPPED);
+		break;
+	case OBS_FRONTEND_EVENT_REPLAY_BUFFER_SAVED:
+		tracker->LogOutputEvent(Output::REPLAY_BUFFER,
+					OutputEvent::SAVED);
+		break;
+#if LIBOBS_API_VER >= MAKE_SEMANTIC_VERSION(27, 0, 0)
+	case OBS_FRONTEND_EVENT_VIRTUALCAM_STARTED:
+		tracker->LogOutputEvent(Output::VIRTUAL_CAM,
+					OutputEvent::STARTED);
+		break;
+	case OBS_FRONTEND_EVENT_VIRTUALCAM_STOPPED:
+		tracker->LogOutputEvent(Output::VIRTUAL_CAM,
+					OutputEvent::STOPPED);
+		break;
+#endif
+	case OBS_FRONTEND_EVENT_FINISHED_LOADING:
+		tracker->SyncOutputStates();
+		break;
+	default:
+		break;
+	};
+}
+
+void OBSStateTracker::LogOutputEvent(Output output, OutputEvent event)
+{
+	const auto now = Clock::now();
+	std::lock_guard<std::mutex> lock(_outputMutex);
+	auto &state = _outputs[static_cast<size_t>(output)];
+	state.log.Add(event, now);
+
+	switch (event) {
+	case OutputEvent::STARTED:
+		state.active = true;
+		state.paused = false;
+		state.activeSince = now;
+		state.pausedDuration = {};
+		break;
+	case OutputEvent::STOPPED:
+		state.active = false;
+		state.paused = false;
+		break;
+	case OutputEvent::PAUSED:
+		if (!state.paused) {
+			state.paused = true;
+			state.pausedSince = now;
+		}
+		break;
+	case OutputEvent::UNPAUSED:
+		if (state.paused) {
+			state.paused = false;
+			state.pausedDuration += now - state.pausedSince;
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+// Outputs might have been active before the tracker was set up
+void OBSStateTracker::SyncOutputStates()
+{
+	const auto now = Clock::now();
+	const std::array<bool, static_cast<size_t>(Output::COUNT)> active = {
+		obs_frontend_streaming_active(),
+		obs_frontend_recording_active(),
+		obs_frontend_replay_buffer_active(),
+#if LIBOBS_API_VER >= MAKE_SEMANTIC_VERSION(27, 0, 0)
+		obs_frontend_virtualcam_active(),
+#else
+		false,
+#endif
+	};
+	const bool recordingPaused = obs_frontend_recording_paused();
+
+	std::lock_guard<std::mutex> lock(_outputMutex);
+	for (size_t i = 0; i < _outputs.size(); i++) {
+		auto &state = _outputs[i];
+		if (state.active == active[i]) {
+			continue;
+		}
+		state.active = active[i];
+		state.activeSince = now;
+		state.pausedDuration = {};
+		state.paused = false;
+	}
+	auto &recording = _outputs[static_cast<size_t>(Output::RECORDING)];
+	if (recording.active && recordingPaused && !recording.paused) {
+		recording.paused = true;
+		recording.pausedSince = now;
+	}
+}
+
+bool OBSStateTracker::IsActive(Output output) const
+{
+	std::lock_guard<std::mutex> lock(_outputMutex);
+	return _outputs[static_cast<size_t>(output)].active;
+}
+
+bool OBSStateTracker::IsPaused(Output output) const
+{
+	std::lock_guard<std::mutex> lock(_outputMutex);
+	return _outputs[static_cast<size_t>(output)].paused;
+}
+
+std::chrono::milliseconds
+OBSStateTracker::GetActiveDuration(Output output, Clock::time_point now) const
+{
+	std::lock_guard<std::mutex> lock(_outputMutex);
+	const auto &state = _outputs[static_cast<size_t>(output)];
+	if (!state.active) {
+		return {};
+	}
+	auto duration = now - state.activeSince - state.pausedDuration;
+	if (state.paused) {
+		duration -= now - state.pausedSince;
+	}
+	return std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+}
+
+uint64_t OBSStateTracker::GetLatestEventId(Output output) const
+{
+	std::lock_guard<std::mutex> lock(_outputMutex);
+	return _outputs[static_cast<size_t>(output)].log.LatestId();
+}
+
+std::optional<OBSStateTracker::Clock::time_point>
+OBSStateTracker::GetLastEventTime(Output output, OutputEvent event) const
+{
+	std::lock_guard<std::mutex> lock(_outputMutex);
+	const auto entry =
+		_outputs[static_cast<size_t>(output)].log.LastOccurrence(event);
+	if (!entry) {
+		return {};
+	}
+	return entry->time;
+}
+
+std::set<OBSStateTracker::OutputEvent>
+OBSStateTracker::GetEventsSince(Output output, uint64_t &lastSeenId) const
+{
+	std::lock_guard<std::mutex> lock(_outputMutex);
+	const auto &log = _outputs[static_cast<size_t>(output)].log;
+	auto events = log.GetEventTypesSince(lastSeenId);
+	lastSeenId = log.LatestId();
+	return events;
+}
+
+struct OBSStateTracker::MediaSourceState {
+	MediaSourceState(obs_weak_source_t *);
+	~MediaSourceState();
+	void Connect(signal_handler_t *);
+	void Disconnect();
+	template<MediaEvent event>
+	static void HandleSignal(void *data, calldata_t *);
+	static void HandleDestroy(void *data, calldata_t *);
+
+	struct Signal {
+		const char *name;
+		signal_callback_t callback;
+	};
+	static const std::array<Signal, 8> signals;
+
+	// Keeps the key of the source map valid
+	OBSWeakSource source;
+	// Reset once the source was destroyed
+	std::atomic<signal_handler_t *> handler{nullptr};
+	std::mutex mutex;
+	StateEventLog<MediaEvent> log;
+};
+
+const std::array<OBSStateTracker::MediaSourceState::Signal, 8>
+	OBSStateTracker::MediaSourceState::signals = {{
+		{"media_started", HandleSignal<MediaEvent::STARTED>},
+		{"media_play", HandleSignal<MediaEvent::PLAY>},
+		{"media_pause", HandleSignal<MediaEvent::PAUSE>},
+		{"media_restart", HandleSignal<MediaEvent::RESTART>},
+		{"media_stopped", HandleSignal<MediaEvent::STOPPED>},
+		{"media_next", HandleSignal<MediaEvent::NEXT>},
+		{"media_previous", HandleSignal<MediaEvent::PREVIOUS>},
+		{"media_ended", HandleSignal<MediaEvent::ENDED>},
+	}};
+
+OBSStateTracker::MediaSourceState::MediaSourceState(obs_weak_source_t *weak)
+	: source(weak)
+{
+}
+
+OBSStateTracker::MediaSourceState::~MediaSourceState()
+{
+	Disconnect();
+}
+
+void OBSStateTracker::MediaSourceState::Connect(signal_handler_t *sh)
+{
+	if (!sh) {
+		return;
+	}
+	for (const auto &signal : signals) {
+		signal_handler_connect(sh, signal.name, signal.callback, this);
+	}
+	signal_handler_connect(sh, "destroy", HandleDestroy, this);
+	handler = sh;
+}
+
+void OBSStateTracker::MediaSourceState::Disconnect()
+{
+	auto sh = handler.exchange(nullptr);
+	if (!sh) {
+		return;
+	}
+	for (const auto &signal : signals) {
+		signal_handler_disconnect(sh, signal.name, signal.callback,
+					  this);
+	}
+	signal_handler_disconnect(sh, "destroy", HandleDestroy, this);
+}
+
+template<OBSStateTracker::MediaEvent event>
+void OBSStateTracker::MediaSourceState::HandleSignal(void *data, calldata_t *)
+{
+	auto state = static_cast<MediaSourceState *>(data);
+	std::lock_guard<std::mutex> lock(state->mutex);
+	state->log.Add(event);
+}
+
+// The signal handler of the source is destroyed along with the source, so
+// the signals have to be disconnected now instead of when the state is removed
+void OBSStateTracker::MediaSourceState::HandleDestroy(void *data,
+						      calldata_t *)
+{
+	static_cast<MediaSourceState *>(data)->Disconnect();
+}
+
+std::shared_ptr<OBSStateTracker::MediaSourceState>
+OBSStateTracker::GetMediaSource(obs_weak_source_t *weak)
+{
+	if (!weak) {
+		return {};
+	}
+	auto it = _mediaSources.find(weak);
+	if (it != _mediaSources.end()) {
+		return it->second;
+	}
+
+	OBSSourceAutoRelease source = obs_weak_source_get_source(weak);
+	if (!source) {
+		return {};
+	}
+	RemoveDestroyedMediaSources();
+	auto state = std::make_shared<MediaSourceState>(weak);
+	state->Connect(obs_source_get_signal_handler(source));
+	_mediaSources.emplace(weak, state);
+	return state;
+}
+
+void OBSStateTracker::RemoveDestroyedMediaSources()
+{
+	for (auto it = _mediaSources.begin(); it != _mediaSources.end();) {
+		if (!it->second->handler) {
+			it = _mediaSources.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+uint64_t OBSStateTracker::GetLatestEventId(obs_weak_source_t *weak)
+{
+	std::lock_guard<std::mutex> lock(_mediaMutex);
+	auto state = GetMediaSource(weak);
+	if (!state) {
+		return 0;
+	}
+	std::lock_guard<std::mutex> stateLock(state->mutex);
+	return state->log.LatestId();
+}
+
+std::set<OBSStateTracker::MediaEvent>
+OBSStateTracker::GetEventsSince(obs_weak_source_t *weak, uint64_t &lastSeenId)
+{
+	std::lock_guard<std::mutex> lock(_mediaMutex);
+	auto state = GetMediaSource(weak);
+	if (!state) {
+		return {};
+	}
+	std::lock_guard<std::mutex> stateLock(state->mutex);
+	auto events = state->log.GetEventTypesSince(lastSeenId);
+	lastSeenId = state->log.LatestId();
+	return events;
+}
+
+void OBSStateTracker::ClearMediaSources()
+{
+	std::lock_guard<std::mutex> lock(_mediaMutex);
+	_mediaSources.clear();
+}
+
+} // namespace advss
@@ -0,0 +1,105 @@
+#pragma once
+#include "state-event-log.hpp"
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <obs.hpp>
+#include <obs-frontend-api.h>
+#include <optional>
+#include <set>
+#include <unordered_map>
+
+namespace advss {
+
+// Subscribes once to the frontend events of the outputs and the signals of
+// media sources and keeps a log of state changes for each of them.
+//
+// Conditions can then read the current state and check for state changes
+// since their last check from memory instead of polling OBS, without missing
+// transitions which happened between two checks.
+class OBSStateTracker {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	enum class Output {
+		STREAMING,
+		RECORDING,
+		REPLAY_BUFFER,
+		VIRTUAL_CAM,
+		COUNT,
+	};
+
+	enum class OutputEvent {
+		STARTING,
+		STARTED,
+		STOPPING,
+		STOPPED,
+		PAUSED,
+		UNPAUSED,
+		SAVED,
+	};
+
+	enum class MediaEvent {
+		STARTED,
+		PLAY,
+		PAUSE,
+		RESTART,
+		STOPPED,
+		NEXT,
+		PREVIOUS,
+		ENDED,
+	};
+
+	static OBSStateTracker &Instance();
+
+	bool IsActive(Output) const;
+	bool IsPaused(Output) const;
+	// Time the output was active excluding the time it was paused
+	std::chrono::milliseconds
+	GetActiveDuration(Output, Clock::time_point now = Clock::now()) const;
+	uint64_t GetLatestEventId(Output) const;
+	std::optional<Clock::time_point> GetLastEventTime(Output,
+							  OutputEvent) const;
+	// Returns the types of events which occurred after the event with the
+	// given id and updates the id to the latest event of the output
+	std::set<OutputEvent> GetEventsSince(Output,
+					     uint64_t &lastSeenId) const;
+
+	// Media sources are tracked starting with the first request for them
+	uint64_t GetLatestEventId(obs_weak_source_t *);
+	// Same as above for the media signals of the given source
+	std::set<MediaEvent> GetEventsSince(obs_weak_source_t *,
+					    uint64_t &lastSeenId);
+	void ClearMediaSources();
+
+private:
+	OBSStateTracker();
+
+	struct OutputState {
+		StateEventLog<OutputEvent> log;
+		bool active = false;
+		bool paused = false;
+		Clock::time_point activeSince;
+		Clock::time_point pausedSince;
+		Clock::duration pausedDuration{};
+	};
+
+	struct MediaSourceState;
+
+	static void HandleFrontendEvent(enum obs_frontend_event, void *);
+	void LogOutputEvent(Output, OutputEvent);
+	void SyncOutputStates();
+	std::shared_ptr<MediaSourceState> GetMediaSource(obs_weak_source_t *);
+	void RemoveDestroyedMediaSources();
+
+	std::array<OutputState, static_cast<size_t>(Output::COUNT)> _outputs;
+	mutable std::mutex _outputMutex;
+
+	std::unordered_map<obs_weak_source_t *,
+			   std::shared_ptr<MediaSourceState>>
+		_mediaSources;
+	std::mutex _mediaMutex;
+};
+
+} // namespace advss
@@ -0,0 +1,216 @@
+#include "obs-stats-sampler.hpp"
+
+#include <obs-frontend-api.h>
+#include <util/config-file.h>
+
+namespace advss {
+
+static std::mutex instanceMutex;
+static std::weak_ptr<OBSStatsSampler> instance;
+
+std::shared_ptr<OBSStatsSampler> OBSStatsSampler::Get()
+{
+	std::lock_guard<std::mutex> lock(instanceMutex);
+	auto sampler = instance.lock();
+	if (sampler) {
+		return sampler;
+	}
+	sampler = std::shared_ptr<OBSStatsSampler>(new OBSStatsSampler());
+	instance = sampler;
+	return sampler;
+}
+
+OBSStatsSampler::OBSStatsSampler() : _cpuInfo(os_cpu_usage_info_start())
+{
+	for (auto &samples : _samples) {
+		samples = SampleWindow(sampleCount);
+	}
+	// Make sure there is a value available right away
+	Sample();
+	_thread = std::thread(&OBSStatsSampler::Run, this);
+}
+
+OBSStatsSampler::~OBSStatsSampler()
+{
+	{
+		std::lock_guard<std::mutex> lock(_cvMutex);
+		_stop = true;
+	}
+	_cv.notify_all();
+	if (_thread.joinable()) {
+		_thread.join();
+	}
+	os_cpu_usage_info_destroy(_cpuInfo);
+}
+
+std::optional<double>
+OBSStatsSampler::GetValue(Metric metric, Aggregation aggregation,
+			  std::chrono::milliseconds window,
+			  double percentile) const
+{
+	if (metric >= Metric::COUNT) {
+		return {};
+	}
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	const auto &samples = _samples[static_cast<size_t>(metric)];
+	switch (aggregation) {
+	case Aggregation::CURRENT:
+		return samples.Latest();
+	case Aggregation::AVERAGE:
+		return samples.Average(window);
+	case Aggregation::MIN:
+		return samples.Min(window);
+	case Aggregation::MAX:
+		return samples.Max(window);
+	case Aggregation::PERCENTILE:
+		return samples.Percentile(window, percentile);
+	default:
+		break;
+	}
+	return {};
+}
+
+void OBSStatsSampler::Run()
+{
+	std::unique_lock<std::mutex> lock(_cvMutex);
+	while (!_stop) {
+		_cv.wait_for(lock, sampleInterval,
+			     [this]() { return !!_stop; });
+		if (_stop) {
+			break;
+		}
+		lock.unlock();
+		Sample();
+		lock.lock();
+	}
+}
+
+void OBSStatsSampler::OutputInfo::Update(obs_output_t *output)
+{
+	uint64_t totalBytes = output ? obs_output_get_total_bytes(output) : 0;
+	uint64_t curTime = os_gettime_ns();
+	uint64_t bytesSent = totalBytes;
+
+	if (bytesSent < lastBytesSent) {
+		bytesSent = 0;
+	}
+	if (bytesSent == 0) {
+		lastBytesSent = 0;
+	}
+
+	uint64_t bitsBetween = (bytesSent - lastBytesSent) * 8;
+	double timePassed =
+		(double)(curTime - lastBytesSentTime) / 1000000000.0;
+	kbps = timePassed < 0.01 ? 0.0
+				 : (double)bitsBetween / timePassed / 1000.0;
+
+	int total = output ? obs_output_get_total_frames(output) : 0;
+	int dropped = output ? obs_output_get_frames_dropped(output) : 0;
+
+	if (total < firstTotal || dropped < firstDropped) {
+		firstTotal = 0;
+		firstDropped = 0;
+	}
+
+	total -= firstTotal;
+	dropped -= firstDropped;
+
+	droppedRelative =
+		total ? (double)dropped / (double)total * 100.0 : 0.0;
+	mbSent = (double)totalBytes / (1024.0 * 1024.0);
+
+	lastBytesSent = bytesSent;
+	lastBytesSentTime = curTime;
+}
+
+static double getRelative(uint32_t total, uint32_t part, uint32_t &firstTotal,
+			  uint32_t &firstPart)
+{
+	if (total < firstTotal || part < firstPart) {
+		firstTotal = total;
+		firstPart = part;
+	}
+	total -= firstTotal;
+	part -= firstPart;
+	return total ? (double)part / (double)total * 100.0 : 0.0;
+}
+
+// Based on OBSBasic::GetCurrentOutputPath()
+static const char *getCurrentOutputPath()
+{
+	const char *path = nullptr;
+	auto config = obs_frontend_get_profile_config();
+	if (!config) {
+		return path;
+	}
+
+	const char *mode = config_get_string(config, "Output", "Mode");
+
+	if (strcmp(mode, "Advanced") == 0) {
+		const char *advanced_mode =
+			config_get_string(config, "AdvOut", "RecType");
+
+		if (strcmp(advanced_mode, "FFmpeg") == 0) {
+			path = config_get_string(config, "AdvOut",
+						 "FFFilePath");
+		} else {
+			path = config_get_string(config, "AdvOut",
+						 "RecFilePath");
+		}
+	} else {
+		path = config_get_string(config, "SimpleOutput", "FilePath");
+	}
+
+	return path;
+}
+
+void OBSStatsSampler::Sample()
+{
+	// Query everything before taking the lock to keep the time readers
+	// might be blocked as short as possible
+	std::array<double, static_cast<size_t>(Metric::COUNT)> values;
+	auto value = [&values](Metric metric) -> double & {
+		return values[static_cast<size_t>(metric)];
+	};
+
+	value(Metric::FPS) = obs_get_active_fps();
+	value(Metric::CPU_USAGE) = os_cpu_usage_info_query(_cpuInfo);
+	value(Metric::DISK_SPACE) =
+		(double)(os_get_free_disk_space(getCurrentOutputPath()) /
+			 (1024ULL * 1024ULL));
+	value(Metric::MEM_USAGE) =
+		(double)os_get_proc_resident_size() / (1024.0 * 1024.0);
+	value(Metric::AVG_FRAMETIME) =
+		(double)obs_get_average_frame_time_ns() / 1000000.0;
+	value(Metric::RENDER_LAG) =
+		getRelative(obs_get_total_frames(), obs_get_lagged_frames(),
+			    _firstRendered, _firstLagged);
+	video_t *video = obs_get_video();
+	value(Metric::ENCODE_LAG) =
+		getRelative(video_output_get_total_frames(video),
+			    video_output_get_skipped_frames(video),
+			    _firstEncoded, _firstSkipped);
+
+	OBSOutputAutoRelease streamOutput = obs_frontend_get_streaming_output();
+	_streamInfo.Update(streamOutput);
+	value(Metric::STREAM_DROPPED_FRAMES) = _streamInfo.droppedRelative;
+	value(Metric::STREAM_BITRATE) = _streamInfo.kbps;
+	value(Metric::STREAM_MB_SENT) = _streamInfo.mbSent;
+
+	OBSOutputAutoRelease recordingOutput =
+		obs_frontend_get_recording_output();
+	_recordingInfo.Update(recordingOutput);
+	value(Metric::RECORDING_DROPPED_FRAMES) =
+		_recordingInfo.droppedRelative;
+	value(Metric::RECORDING_BITRATE) = _recordingInfo.kbps;
+	value(Metric::RECORDING_MB_SENT) = _recordingInfo.mbSent;
+
+	const auto now = SampleWindow::Clock::now();
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (size_t i = 0; i < values.size(); ++i) {
+		_samples[i].Add(values[i], now);
+	}
+}
+
+} // namespace advss
@@ -0,0 +1,95 @@
+#pragma once
+#include "sample-window.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <obs.hpp>
+#include <optional>
+#include <thread>
+#include <util/platform.h>
+
+namespace advss {
+
+// Reads all OBS and system statistics once per sample interval and stores them
+// in ring buffers, so conditions can share the results instead of querying
+// the same counters individually
+class OBSStatsSampler {
+public:
+	enum class Metric {
+		FPS,
+		CPU_USAGE,
+		DISK_SPACE,
+		MEM_USAGE,
+		AVG_FRAMETIME,
+		RENDER_LAG,
+		ENCODE_LAG,
+		STREAM_DROPPED_FRAMES,
+		STREAM_BITRATE,
+		STREAM_MB_SENT,
+		RECORDING_DROPPED_FRAMES,
+		RECORDING_BITRATE,
+		RECORDING_MB_SENT,
+		COUNT,
+	};
+
+	enum class Aggregation {
+		CURRENT,
+		AVERAGE,
+		MIN,
+		MAX,
+		PERCENTILE,
+	};
+
+	// The sampler is only running as long as at least one user holds a
+	// reference to it
+	static std::shared_ptr<OBSStatsSampler> Get();
+	~OBSStatsSampler();
+
+	std::optional<double>
+	GetValue(Metric, Aggregation = Aggregation::CURRENT,
+		 std::chrono::milliseconds window = {},
+		 double percentile = 50.0) const;
+
+	static constexpr std::chrono::milliseconds sampleInterval{500};
+	// Ten minutes worth of samples
+	static constexpr size_t sampleCount = 1200;
+
+private:
+	OBSStatsSampler();
+	void Run();
+	void Sample();
+
+	struct OutputInfo {
+		void Update(obs_output_t *output);
+
+		uint64_t lastBytesSent = 0;
+		uint64_t lastBytesSentTime = 0;
+		int firstTotal = 0;
+		int firstDropped = 0;
+		double droppedRelative = 0.0;
+		double kbps = 0.0;
+		double mbSent = 0.0;
+	};
+
+	os_cpu_usage_info_t *_cpuInfo = nullptr;
+	uint32_t _firstEncoded = 0xFFFFFFFF;
+	uint32_t _firstSkipped = 0xFFFFFFFF;
+	uint32_t _firstRendered = 0xFFFFFFFF;
+	uint32_t _firstLagged = 0xFFFFFFFF;
+	OutputInfo _streamInfo;
+	OutputInfo _recordingInfo;
+
+	std::array<SampleWindow, static_cast<size_t>(Metric::COUNT)> _samples;
+	mutable std::mutex _mutex;
+
+	std::thread _thread;
+	std::atomic_bool _stop = {false};
+	std::mutex _cvMutex;
+	std::condition_variable _cv;
+};
+
+} // namespace advss
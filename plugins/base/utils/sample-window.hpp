@@ -0,0 +1,160 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <optional>
+#include <vector>
+
+namespace advss {
+
+// Fixed size ring buffer of timestamped samples which supports aggregate
+// queries over the samples that were recorded within a given time window
+class SampleWindow {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	SampleWindow(size_t capacity = 1);
+
+	void Add(double value, Clock::time_point time = Clock::now());
+	void Clear();
+	size_t Size() const { return _size; }
+	size_t Capacity() const { return _samples.size(); }
+
+	std::optional<double> Latest() const;
+	std::optional<double>
+	Average(std::chrono::milliseconds window,
+		Clock::time_point now = Clock::now()) const;
+	std::optional<double> Min(std::chrono::milliseconds window,
+				  Clock::time_point now = Clock::now()) const;
+	std::optional<double> Max(std::chrono::milliseconds window,
+				  Clock::time_point now = Clock::now()) const;
+	// Percentile in the range of [0, 100]
+	std::optional<double>
+	Percentile(std::chrono::milliseconds window, double percentile,
+		   Clock::time_point now = Clock::now()) const;
+
+private:
+	struct Sample {
+		Clock::time_point time;
+		double value = 0.0;
+	};
+
+	// Iterates from newest to oldest sample as long as the samples are
+	// within the given window
+	template<class F>
+	void ForEachInWindow(std::chrono::milliseconds window,
+			     Clock::time_point now, F &&func) const;
+
+	std::vector<Sample> _samples;
+	size_t _next = 0;
+	size_t _size = 0;
+};
+
+inline SampleWindow::SampleWindow(size_t capacity)
+	: _samples(std::max<size_t>(capacity, 1))
+{
+}
+
+inline void SampleWindow::Add(double value, Clock::time_point time)
+{
+	_samples[_next] = {time, value};
+	_next = (_next + 1) % _samples.size();
+	if (_size < _samples.size()) {
+		++_size;
+	}
+}
+
+inline void SampleWindow::Clear()
+{
+	_next = 0;
+	_size = 0;
+}
+
+inline std::optional<double> SampleWindow::Latest() const
+{
+	if (_size == 0) {
+		return {};
+	}
+	return _samples[(_next + _samples.size() - 1) % _samples.size()].value;
+}
+
+template<class F>
+inline void SampleWindow::ForEachInWindow(std::chrono::milliseconds window,
+					  Clock::time_point now, F &&func) const
+{
+	const auto cutoff = now - window;
+	for (size_t i = 1; i <= _size; ++i) {
+		const auto &sample =
+			_samples[(_next + _samples.size() - i) %
+				 _samples.size()];
+		// Always consider the latest sample even if the window is
+		// shorter than the sample interval
+		if (i > 1 && sample.time < cutoff) {
+			return;
+		}
+		func(sample.value);
+	}
+}
+
+inline std::optional<double>
+SampleWindow::Average(std::chrono::milliseconds window,
+		      Clock::time_point now) const
+{
+	double sum = 0.0;
+	size_t count = 0;
+	ForEachInWindow(window, now, [&](double value) {
+		sum += value;
+		++count;
+	});
+	if (count == 0) {
+		return {};
+	}
+	return sum / (double)count;
+}
+
+inline std::optional<double> SampleWindow::Min(std::chrono::milliseconds window,
+					       Clock::time_point now) const
+{
+	std::optional<double> result;
+	ForEachInWindow(window, now, [&](double value) {
+		if (!result || value < *result) {
+			result = value;
+		}
+	});
+	return result;
+}
+
+inline std::optional<double> SampleWindow::Max(std::chrono::milliseconds window,
+					       Clock::time_point now) const
+{
+	std::optional<double> result;
+	ForEachInWindow(window, now, [&](double value) {
+		if (!result || value > *result) {
+			result = value;
+		}
+	});
+	return result;
+}
+
+inline std::optional<double>
+SampleWindow::Percentile(std::chrono::milliseconds window, double percentile,
+			 Clock::time_point now) const
+{
+	std::vector<double> values;
+	values.reserve(_size);
+	ForEachInWindow(window, now,
+			[&](double value) { values.push_back(value); });
+	if (values.empty()) {
+		return {};
+	}
+
+	percentile = std::clamp(percentile, 0.0, 100.0);
+	// Nearest-rank method
+	auto rank = (size_t)std::ceil(percentile / 100.0 *
+				      (double)values.size());
+	auto idx = rank == 0 ? 0 : rank - 1;
+	std::nth_element(values.begin(), values.begin() + idx, values.end());
+	return values[idx];
+}
+
+} // namespace advss
@@ -0,0 +1,145 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace advss {
+
+// Ring buffer of timestamped state change events of a single object.
+//
+// Each event is assigned an increasing id, so users can remember the id of the
+// latest event they have seen and later check which events happened since
+// then, even if the object changed its state multiple times in between.
+// The last occurrence of each event type is kept independently of the ring
+// buffer, so these checks also work if older entries were already overwritten.
+//
+// Not thread-safe.
+template<class Event> class StateEventLog {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct Entry {
+		Event event;
+		Clock::time_point time;
+		// Ids start at 1, so 0 refers to "before the first event"
+		uint64_t id = 0;
+	};
+
+	StateEventLog(size_t capacity = 32);
+
+	uint64_t Add(Event, Clock::time_point time = Clock::now());
+	void Clear();
+	size_t Size() const { return _size; }
+
+	std::optional<Entry> Latest() const;
+	uint64_t LatestId() const { return _nextId - 1; }
+	std::optional<Entry> LastOccurrence(Event) const;
+	bool OccurredSince(Event, uint64_t id) const;
+	bool OccurredSince(Event, Clock::time_point) const;
+	// Returns the types of all events which happened after the event with
+	// the given id
+	std::set<Event> GetEventTypesSince(uint64_t id) const;
+	// Returns the events still stored in the ring buffer which happened
+	// after the event with the given id ordered from oldest to newest
+	std::vector<Entry> GetSince(uint64_t id) const;
+
+private:
+	std::vector<Entry> _entries;
+	size_t _next = 0;
+	size_t _size = 0;
+	uint64_t _nextId = 1;
+	std::map<Event, Entry> _lastOccurrence;
+};
+
+template<class Event>
+inline StateEventLog<Event>::StateEventLog(size_t capacity)
+	: _entries(std::max<size_t>(capacity, 1))
+{
+}
+
+template<class Event>
+inline uint64_t StateEventLog<Event>::Add(Event event, Clock::time_point time)
+{
+	const Entry entry{event, time, _nextId++};
+	_entries[_next] = entry;
+	_next = (_next + 1) % _entries.size();
+	_size = std::min(_size + 1, _entries.size());
+	_lastOccurrence.insert_or_assign(event, entry);
+	return entry.id;
+}
+
+template<class Event> inline void StateEventLog<Event>::Clear()
+{
+	_next = 0;
+	_size = 0;
+	_lastOccurrence.clear();
+}
+
+template<class Event>
+inline std::optional<typename StateEventLog<Event>::Entry>
+StateEventLog<Event>::Latest() const
+{
+	if (_size == 0) {
+		return {};
+	}
+	return _entries[(_next + _entries.size() - 1) % _entries.size()];
+}
+
+template<class Event>
+inline std::optional<typename StateEventLog<Event>::Entry>
+StateEventLog<Event>::LastOccurrence(Event event) const
+{
+	auto it = _lastOccurrence.find(event);
+	if (it == _lastOccurrence.end()) {
+		return {};
+	}
+	return it->second;
+}
+
+template<class Event>
+inline bool StateEventLog<Event>::OccurredSince(Event event, uint64_t id) const
+{
+	const auto entry = LastOccurrence(event);
+	return entry && entry->id > id;
+}
+
+template<class Event>
+inline bool StateEventLog<Event>::OccurredSince(Event event,
+						Clock::time_point time) const
+{
+	const auto entry = LastOccurrence(event);
+	return entry && entry->time > time;
+}
+
+template<class Event>
+inline std::set<Event> StateEventLog<Event>::GetEventTypesSince(uint64_t id) const
+{
+	std::set<Event> result;
+	for (const auto &[event, entry] : _lastOccurrence) {
+		if (entry.id > id) {
+			result.insert(event);
+		}
+	}
+	return result;
+}
+
+template<class Event>
+inline std::vector<typename StateEventLog<Event>::Entry>
+StateEventLog<Event>::GetSince(uint64_t id) const
+{
+	std::vector<Entry> result;
+	const size_t first = (_next + _entries.size() - _size) % _entries.size();
+	for (size_t i = 0; i < _size; i++) {
+		const auto &entry = _entries[(first + i) % _entries.size()];
+		if (entry.id > id) {
+			result.emplace_back(entry);
+		}
+	}
+	return result;
+}
+
+} // namespace advss
@@ -1,5 +1,6 @@
 #include "websocket-helpers.hpp"
 #include "connection-manager.hpp"
+#include "json-helpers.hpp"
 #include "log-helper.hpp"
 #include "plugin-state-helpers.hpp"
 #include "sync-helpers.hpp"
@@ -21,6 +22,9 @@ constexpr char VendorRequest[] = "AdvancedSceneSwitcherMessage";
 constexpr char VendorEvent[] = "AdvancedSceneSwitcherEvent";
 obs_websocket_vendor vendor;
 
+// Requests queued within this time window will be sent as a single batch
+constexpr long requestBatchWindowMs = 5;
+
 static WebsocketMessageDispatcher websocketMessageDispatcher;
 static void registerWebsocketVendor();
 
@@ -170,6 +174,8 @@ void WSClientConnection::Disconnect()
 {
 	std::lock_guard<std::mutex> lock(_connectMtx);
 	_disconnect = true;
+	// Pending request timers would keep the io thread running
+	ExpirePendingRequests(true);
 	websocketpp::lib::error_code ec;
 	_client.close(_connection, websocketpp::close::status::normal,
 		      "Client stopping", ec);
@@ -224,11 +230,229 @@ void WSClientConnection::SendRequest(const std::string &msg)
 	Send(msg);
 }
 
+static std::future<WSRequestResponse> failedRequest(const char *comment)
+{
+	std::promise<WSRequestResponse> promise;
+	WSRequestResponse response;
+	response.comment = comment;
+	promise.set_value(response);
+	return promise.get_future();
+}
+
+std::future<WSRequestResponse>
+WSClientConnection::QueueRequest(const std::string &requestType,
+				 obs_data_t *requestData,
+				 std::chrono::milliseconds timeout)
+{
+	if (_status != Status::AUTHENTICATED) {
+		return failedRequest("not connected");
+	}
+
+	OBSDataAutoRelease request = obs_data_create();
+	obs_data_set_string(request, "requestType", requestType.c_str());
+	if (requestData) {
+		obs_data_set_obj(request, "requestData", requestData);
+	}
+
+	std::lock_guard<std::mutex> lock(_requestMtx);
+	const auto id = std::to_string(++_lastRequestId);
+	obs_data_set_string(request, "requestId", id.c_str());
+	auto &pending = _pendingRequests[id];
+	pending.deadline = std::chrono::steady_clock::now() + timeout;
+	auto future = pending.promise.get_future();
+	_queuedRequests.emplace_back(std::move(request));
+
+	// Make sure the request times out even if no further messages are
+	// sent or received on this connection
+	ScheduleRequestExpiry();
+
+	if (!_flushScheduled) {
+		_flushScheduled = true;
+		_flushTimer = _client.set_timer(
+			requestBatchWindowMs,
+			[this](const websocketpp::lib::error_code &ec) {
+				if (ec) {
+					return;
+				}
+				FlushRequestBatch();
+			});
+	}
+	return future;
+}
+
+std::future<WSRequestResponse>
+WSClientConnection::QueueRequest(const std::string &msg,
+				 std::chrono::milliseconds timeout)
+{
+	// Avoid parsing anything that is not a request
+	if (PeekJsonIntValue(msg, "op").value_or(-1) != 6) {
+		Send(msg);
+		return failedRequest("not a request message");
+	}
+
+	OBSDataAutoRelease json = obs_data_create_from_json(msg.c_str());
+	OBSDataAutoRelease data = obs_data_get_obj(json, "d");
+	if (!data) {
+		Send(msg);
+		return failedRequest("not a request message");
+	}
+	OBSDataAutoRelease requestData = obs_data_get_obj(data, "requestData");
+	return QueueRequest(obs_data_get_string(data, "requestType"),
+			    requestData, timeout);
+}
+
+void WSClientConnection::FlushRequestBatch()
+{
+	std::vector<OBSDataAutoRelease> requests;
+	{
+		std::lock_guard<std::mutex> lock(_requestMtx);
+		requests.swap(_queuedRequests);
+		_flushScheduled = false;
+		_flushTimer.reset();
+	}
+	ExpirePendingRequests();
+	if (requests.empty()) {
+		return;
+	}
+
+	OBSDataAutoRelease msg = obs_data_create();
+	if (requests.size() == 1) {
+		obs_data_set_int(msg, "op", 6);
+		obs_data_set_obj(msg, "d", requests.front());
+		Send(obs_data_get_json(msg));
+		return;
+	}
+
+	OBSDataAutoRelease data = obs_data_create();
+	obs_data_set_string(data, "requestId",
+			    obs_data_get_string(requests.front(), "requestId"));
+	obs_data_set_bool(data, "haltOnFailure", false);
+	obs_data_set_int(data, "executionType", 0); // SerialRealtime
+	OBSDataArrayAutoRelease array = obs_data_array_create();
+	for (const auto &request : requests) {
+		obs_data_array_push_back(array, request);
+	}
+	obs_data_set_array(data, "requests", array);
+	obs_data_set_int(msg, "op", 8);
+	obs_data_set_obj(msg, "d", data);
+	Send(obs_data_get_json(msg));
+}
+
+void WSClientConnection::ExpirePendingRequests(bool expireAll)
+{
+	std::lock_guard<std::mutex> lock(_requestMtx);
+	const auto now = std::chrono::steady_clock::now();
+	for (auto it = _pendingRequests.begin();
+	     it != _pendingRequests.end();) {
+		if (!expireAll && it->second.deadline > now) {
+			++it;
+			continue;
+		}
+		WSRequestResponse response;
+		response.comment = expireAll ? "connection closed" : "timeout";
+		it->second.promise.set_value(response);
+		it = _pendingRequests.erase(it);
+	}
+	if (expireAll) {
+		_queuedRequests.clear();
+		CancelRequestTimers();
+		return;
+	}
+	ScheduleRequestExpiry();
+}
+
+void WSClientConnection::ScheduleRequestExpiry()
+{
+	// Expects _requestMtx to be locked
+	std::optional<std::chrono::steady_clock::time_point> earliest;
+	for (const auto &[id, request] : _pendingRequests) {
+		if (!earliest || request.deadline < *earliest) {
+			earliest = request.deadline;
+		}
+	}
+
+	const auto now = std::chrono::steady_clock::now();
+	if (_expiryTimer && earliest && _expiryDeadline > now &&
+	    _expiryDeadline <= *earliest) {
+		return;
+	}
+	if (_expiryTimer) {
+		_expiryTimer->cancel();
+		_expiryTimer.reset();
+	}
+	if (!earliest) {
+		return;
+	}
+
+	_expiryDeadline = *earliest;
+	const auto delay =
+		std::chrono::duration_cast<std::chrono::milliseconds>(
+			*earliest - now)
+			.count();
+	_expiryTimer = _client.set_timer(
+		std::max<long>(delay, 0) + 1,
+		[this](const websocketpp::lib::error_code &ec) {
+			if (ec) {
+				return;
+			}
+			ExpirePendingRequests();
+		});
+}
+
+void WSClientConnection::CancelRequestTimers()
+{
+	// Expects _requestMtx to be locked
+	if (_expiryTimer) {
+		_expiryTimer->cancel();
+		_expiryTimer.reset();
+	}
+	if (_flushTimer) {
+		_flushTimer->cancel();
+		_flushTimer.reset();
+	}
+	_flushScheduled = false;
+}
+
+void WSClientConnection::CompleteRequest(obs_data_t *result)
+{
+	const std::string json = obs_data_get_json(result);
+	_responseDispatcher.DispatchMessage(json);
+
+	const std::string id = obs_data_get_string(result, "requestId");
+	OBSDataAutoRelease status = obs_data_get_obj(result, "requestStatus");
+	WSRequestResponse response;
+	response.received = true;
+	response.result = obs_data_get_bool(status, "result");
+	response.code = obs_data_get_int(status, "code");
+	response.comment = obs_data_get_string(status, "comment");
+	OBSDataAutoRelease responseData =
+		obs_data_get_obj(result, "responseData");
+	if (responseData) {
+		response.responseData = obs_data_get_json(responseData);
+	}
+	vblog(LOG_INFO, "received result '%d' with code '%d' (%s) for id '%s'",
+	      response.result, response.code, response.comment.c_str(),
+	      id.c_str());
+
+	std::lock_guard<std::mutex> lock(_requestMtx);
+	auto it = _pendingRequests.find(id);
+	if (it == _pendingRequests.end()) {
+		return;
+	}
+	it->second.promise.set_value(response);
+	_pendingRequests.erase(it);
+}
+
 WebsocketMessageBuffer WSClientConnection::RegisterForEvents()
 {
 	return _dispatcher.RegisterClient();
 }
 
+WebsocketMessageBuffer WSClientConnection::RegisterForResponses()
+{
+	return _responseDispatcher.RegisterClient();
+}
+
 WSClientConnection::Status WSClientConnection::GetStatus() const
 {
 	return _status;
@@ -322,16 +546,21 @@ void WSClientConnection::HandleEvent(obs_data_t *msg)
 
 void WSClientConnection::HandleResponse(obs_data_t *response)
 {
-	auto data = obs_data_get_obj(response, "d");
-	auto id = obs_data_get_string(data, "requestId");
-	auto status = obs_data_get_obj(data, "requestStatus");
-	bool result = obs_data_get_bool(status, "result");
-	int code = obs_data_get_int(status, "code");
-	auto comment = obs_data_get_string(status, "comment");
-	vblog(LOG_INFO, "received result '%d' with code '%d' (%s) for id '%s'",
-	      result, code, comment, id);
-	obs_data_release(status);
-	obs_data_release(data);
+	OBSDataAutoRelease data = obs_data_get_obj(response, "d");
+	CompleteRequest(data);
+	ExpirePendingRequests();
+}
+
+void WSClientConnection::HandleBatchResponse(obs_data_t *response)
+{
+	OBSDataAutoRelease data = obs_data_get_obj(response, "d");
+	OBSDataArrayAutoRelease results = obs_data_get_array(data, "results");
+	const size_t count = obs_data_array_count(results);
+	for (size_t i = 0; i < count; ++i) {
+		OBSDataAutoRelease result = obs_data_array_item(results, i);
+		CompleteRequest(result);
+	}
+	ExpirePendingRequests();
 }
 
 void WSClientConnection::OnGenericMessage(connection_hdl,
@@ -361,6 +590,27 @@ void WSClientConnection::OnOBSMessage(connection_hdl,
 
 	std::string payload = message->get_payload();
 	const char *msg = payload.c_str();
+
+	// Check the opcode first to avoid fully parsing messages which are
+	// ignored anyways
+	auto peekedOpcode = PeekJsonIntValue(payload, "op");
+	if (peekedOpcode) {
+		switch (*peekedOpcode) {
+		case 0:
+		case 5:
+		case 7:
+		case 9:
+			break;
+		case 2: // Identified
+			_status = Status::AUTHENTICATED;
+			return;
+		default:
+			vblog(LOG_INFO, "ignoring unknown opcode %d",
+			      *peekedOpcode);
+			return;
+		}
+	}
+
 	auto json = obs_data_create_from_json(msg);
 	if (!json) {
 		blog(LOG_ERROR, "invalid JSON payload received for '%s'", msg);
@@ -388,6 +638,9 @@ void WSClientConnection::OnOBSMessage(connection_hdl,
 	case 7: // RequestResponse
 		HandleResponse(json);
 		break;
+	case 9: // RequestBatchResponse
+		HandleBatchResponse(json);
+		break;
 	default:
 		vblog(LOG_INFO, "ignoring unknown opcode %d", opcode);
 		break;
@@ -415,6 +668,7 @@ void WSClientConnection::OnClose(connection_hdl)
 {
 	blog(LOG_INFO, "client-connection to %s closed.", _uri.c_str());
 	_status = Status::DISCONNECTED;
+	ExpirePendingRequests(true);
 }
 
 } // namespace advss
@@ -11,6 +11,10 @@
 #include <mutex>
 #include <condition_variable>
 #include <functional>
+#include <future>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 #include <QRunnable>
 
 #include <websocketpp/config/asio_no_tls_client.hpp>
@@ -30,6 +34,15 @@ void SendWebsocketEvent(const std::string &);
 std::string ConstructVendorRequestMessage(const std::string &message);
 [[nodiscard]] WebsocketMessageBuffer RegisterForWebsocketMessages();
 
+struct WSRequestResponse {
+	// Will be false if no response was received in time
+	bool received = false;
+	bool result = false;
+	int code = 0;
+	std::string comment;
+	std::string responseData;
+};
+
 class WSClientConnection : public QObject {
 	using server = websocketpp::server<websocketpp::config::asio>;
 	using client = websocketpp::client<websocketpp::config::asio_client>;
@@ -42,7 +55,17 @@ public:
 		     bool _reconnect, int reconnectDelay = 10);
 	void Disconnect();
 	void SendRequest(const std::string &msg);
+	// Requests queued within a short time window are sent as a single
+	// obs-websocket RequestBatch message
+	std::future<WSRequestResponse>
+	QueueRequest(const std::string &requestType, obs_data_t *requestData,
+		     std::chrono::milliseconds timeout);
+	// Queues the given obs-websocket request message (op 6) or sends it
+	// as is if it is any other type of message
+	std::future<WSRequestResponse>
+	QueueRequest(const std::string &msg, std::chrono::milliseconds timeout);
 	[[nodiscard]] WebsocketMessageBuffer RegisterForEvents();
+	[[nodiscard]] WebsocketMessageBuffer RegisterForResponses();
 	std::string GetFail() { return _failMsg; }
 
 	enum class Status {
@@ -65,6 +88,12 @@ private:
 	void HandleHello(obs_data_t *helloMsg);
 	void HandleEvent(obs_data_t *event);
 	void HandleResponse(obs_data_t *response);
+	void HandleBatchResponse(obs_data_t *response);
+	void CompleteRequest(obs_data_t *result);
+	void FlushRequestBatch();
+	void ExpirePendingRequests(bool expireAll = false);
+	void ScheduleRequestExpiry();
+	void CancelRequestTimers();
 
 	client _client;
 	std::string _uri = "";
@@ -80,7 +109,22 @@ private:
 	std::atomic<Status> _status = {Status::DISCONNECTED};
 	std::atomic_bool _disconnect{false};
 
+	struct PendingRequest {
+		std::promise<WSRequestResponse> promise;
+		std::chrono::steady_clock::time_point deadline;
+	};
+	std::mutex _requestMtx;
+	std::vector<OBSDataAutoRelease> _queuedRequests;
+	std::unordered_map<std::string, PendingRequest> _pendingRequests;
+	bool _flushScheduled = false;
+	client::timer_ptr _flushTimer;
+	// Single timer armed for the earliest pending request deadline
+	client::timer_ptr _expiryTimer;
+	std::chrono::steady_clock::time_point _expiryDeadline;
+	uint64_t _lastRequestId = 0;
+
 	WebsocketMessageDispatcher _dispatcher;
+	WebsocketMessageDispatcher _responseDispatcher;
 };
 
 } // namespace advss
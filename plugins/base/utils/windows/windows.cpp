@@ -138,41 +138,25 @@ static const std::unordered_map<HotkeyType, long> keyTable = {
 	{HotkeyType::Key_NumpadEnter, VK_RETURN},
 };
 
-void PressKeys(const std::vector<HotkeyType> keys, int duration)
+void SendKeyEvents(const std::vector<KeyEvent> &events)
 {
-	const int repeatInterval = 100;
-
-	INPUT ip;
-	ip.type = INPUT_KEYBOARD;
-	ip.ki.wScan = 0;
-	ip.ki.time = 0;
-	ip.ki.dwExtraInfo = 0;
-
-	for (int cur = 0; cur < duration; cur += repeatInterval) {
-		// Press keys
-		ip.ki.dwFlags = 0;
-		for (const auto &key : keys) {
-			auto it = keyTable.find(key);
-			if (it == keyTable.end()) {
-				continue;
-			}
-			ip.ki.wVk = (WORD)it->second;
-			SendInput(1, &ip, sizeof(INPUT));
-		}
-		// When instantly releasing the key presses OBS might miss them
-		Sleep(repeatInterval);
-	}
-
-	// Release keys
-	ip.ki.dwFlags = KEYEVENTF_KEYUP;
-	for (const auto &key : keys) {
-		auto it = keyTable.find(key);
+	std::vector<INPUT> inputs;
+	inputs.reserve(events.size());
+	for (const auto &event : events) {
+		auto it = keyTable.find(event.key);
 		if (it == keyTable.end()) {
 			continue;
 		}
+		INPUT ip = {};
+		ip.type = INPUT_KEYBOARD;
 		ip.ki.wVk = (WORD)it->second;
-		SendInput(1, &ip, sizeof(INPUT));
+		ip.ki.dwFlags = event.pressed ? 0 : KEYEVENTF_KEYUP;
+		inputs.push_back(ip);
+	}
+	if (inputs.empty()) {
+		return;
 	}
+	SendInput((UINT)inputs.size(), inputs.data(), sizeof(INPUT));
 }
 
 static bool windowIsValid(HWND window)
@@ -11,8 +11,20 @@ bool MacroActionMidi::_registered = MacroActionFactory::Register(
 	{MacroActionMidi::Create, MacroActionMidiEdit::Create,
 	 "AdvSceneSwitcher.action.midi"});
 
+const static std::map<MacroActionMidi::Action, std::string> actionTypes = {
+	{MacroActionMidi::Action::SEND_MESSAGE,
+	 "AdvSceneSwitcher.action.midi.type.sendMessage"},
+	{MacroActionMidi::Action::SEND_SEQUENCE,
+	 "AdvSceneSwitcher.action.midi.type.sendSequence"},
+};
+
 bool MacroActionMidi::PerformAction()
 {
+	if (_action == Action::SEND_SEQUENCE) {
+		SendSequence();
+		return true;
+	}
+
 	if (!_device.SendMessge(_message)) {
 		blog(LOG_WARNING,
 		     "failed to send midi message \"%s\" to \"%s\"",
@@ -21,8 +33,30 @@ bool MacroActionMidi::PerformAction()
 	return true;
 }
 
+void MacroActionMidi::SendSequence()
+{
+	std::string error;
+	auto events = ParseMidiSequence(_sequence,
+					std::chrono::steady_clock::now(),
+					&error);
+	if (!events) {
+		blog(LOG_WARNING, "invalid midi sequence for \"%s\": %s",
+		     _device.Name().c_str(), error.c_str());
+		return;
+	}
+	if (!_device.ScheduleMessages(std::move(*events))) {
+		blog(LOG_WARNING, "failed to send midi sequence to \"%s\"",
+		     _device.Name().c_str());
+	}
+}
+
 void MacroActionMidi::LogAction() const
 {
+	if (_action == Action::SEND_SEQUENCE) {
+		ablog(LOG_INFO, "send midi sequence to \"%s\"",
+		      _device.Name().c_str());
+		return;
+	}
 	ablog(LOG_INFO, "send midi message \"%s\" to \"%s\"",
 	      _message.ToString().c_str(), _device.Name().c_str());
 }
@@ -30,16 +64,22 @@ void MacroActionMidi::LogAction() const
 bool MacroActionMidi::Save(obs_data_t *obj) const
 {
 	MacroAction::Save(obj);
+	obs_data_set_int(obj, "action", static_cast<int>(_action));
 	_message.Save(obj);
 	_device.Save(obj);
+	_sequence.Save(obj, "sequence");
 	return true;
 }
 
 bool MacroActionMidi::Load(obs_data_t *obj)
 {
 	MacroAction::Load(obj);
+	_action = static_cast<Action>(obs_data_get_int(obj, "action"));
 	_message.Load(obj);
 	_device.Load(obj);
+	if (obs_data_has_user_value(obj, "sequence")) {
+		_sequence.Load(obj, "sequence");
+	}
 	return true;
 }
 
@@ -51,6 +91,7 @@ std::string MacroActionMidi::GetShortDesc() const
 void MacroActionMidi::ResolveVariablesToFixedValues()
 {
 	_message.ResolveVariables();
+	_sequence.ResolveVariables();
 }
 
 std::shared_ptr<MacroAction> MacroActionMidi::Create(Macro *m)
@@ -63,17 +104,35 @@ std::shared_ptr<MacroAction> MacroActionMidi::Copy() const
 	return std::make_shared<MacroActionMidi>(*this);
 }
 
+static inline void populateActionSelection(QComboBox *list)
+{
+	for (const auto &[_, name] : actionTypes) {
+		list->addItem(obs_module_text(name.c_str()));
+	}
+}
+
 MacroActionMidiEdit::MacroActionMidiEdit(
 	QWidget *parent, std::shared_ptr<MacroActionMidi> entryData)
 	: QWidget(parent),
+	  _actions(new QComboBox(this)),
 	  _devices(new MidiDeviceSelection(this, MidiDeviceType::OUTPUT)),
 	  _message(new MidiMessageSelection(this)),
+	  _sequence(new VariableTextEdit(this)),
+	  _listenLayout(new QHBoxLayout()),
 	  _resetMidiDevices(new QPushButton(
 		  obs_module_text("AdvSceneSwitcher.midi.resetDevices"))),
 	  _listenDevices(new MidiDeviceSelection(this, MidiDeviceType::INPUT)),
 	  _listen(new QPushButton(
 		  obs_module_text("AdvSceneSwitcher.midi.startListen")))
 {
+	populateActionSelection(_actions);
+	_sequence->setToolTip(obs_module_text(
+		"AdvSceneSwitcher.action.midi.sequence.tooltip"));
+
+	QWidget::connect(_actions, SIGNAL(currentIndexChanged(int)), this,
+			 SLOT(ActionChanged(int)));
+	QWidget::connect(_sequence, SIGNAL(textChanged()), this,
+			 SLOT(SequenceChanged()));
 	QWidget::connect(_devices,
 			 SIGNAL(DeviceSelectionChanged(const MidiDevice &)),
 			 this,
@@ -93,19 +152,21 @@ MacroActionMidiEdit::MacroActionMidiEdit(
 			 SLOT(SetMessageSelectionToLastReceived()));
 
 	auto entryLayout = new QHBoxLayout;
-	PlaceWidgets(obs_module_text("AdvSceneSwitcher.action.midi.entry"),
-		     entryLayout, {{"{{device}}", _devices}});
-	auto listenLayout = new QHBoxLayout;
+	PlaceWidgets(
+		obs_module_text("AdvSceneSwitcher.action.midi.entry.action"),
+		entryLayout,
+		{{"{{actions}}", _actions}, {"{{device}}", _devices}});
 	PlaceWidgets(
 		obs_module_text("AdvSceneSwitcher.action.midi.entry.listen"),
-		listenLayout,
+		_listenLayout,
 		{{"{{listenButton}}", _listen},
 		 {"{{listenDevices}}", _listenDevices}});
 
 	auto mainLayout = new QVBoxLayout;
 	mainLayout->addLayout(entryLayout);
 	mainLayout->addWidget(_message);
-	mainLayout->addLayout(listenLayout);
+	mainLayout->addWidget(_sequence);
+	mainLayout->addLayout(_listenLayout);
 	mainLayout->addWidget(_resetMidiDevices);
 	setLayout(mainLayout);
 
@@ -127,8 +188,50 @@ void MacroActionMidiEdit::UpdateEntryData()
 		return;
 	}
 
+	_actions->setCurrentIndex(static_cast<int>(_entryData->_action));
 	_message->SetMessage(_entryData->_message);
 	_devices->SetDevice(_entryData->_device);
+	_sequence->setPlainText(_entryData->_sequence);
+	SetWidgetVisibility();
+}
+
+void MacroActionMidiEdit::SetWidgetVisibility()
+{
+	const bool isSequence = _entryData->_action ==
+				MacroActionMidi::Action::SEND_SEQUENCE;
+	_message->setVisible(!isSequence);
+	SetLayoutVisible(_listenLayout, !isSequence);
+	_sequence->setVisible(isSequence);
+	if (isSequence && _currentlyListening) {
+		ToggleListen();
+	}
+
+	adjustSize();
+	updateGeometry();
+}
+
+void MacroActionMidiEdit::ActionChanged(int idx)
+{
+	if (_loading || !_entryData) {
+		return;
+	}
+
+	{
+		auto lock = LockContext();
+		_entryData->_action =
+			static_cast<MacroActionMidi::Action>(idx);
+	}
+	SetWidgetVisibility();
+}
+
+void MacroActionMidiEdit::SequenceChanged()
+{
+	if (_loading || !_entryData) {
+		return;
+	}
+
+	auto lock = LockContext();
+	_entryData->_sequence = _sequence->toPlainText().toStdString();
 
 	adjustSize();
 	updateGeometry();
@@ -2,8 +2,10 @@
 #include "macro-action-edit.hpp"
 #include "midi-helpers.hpp"
 
+#include <QComboBox>
 #include <QPushButton>
 #include <QTimer>
+#include <variable-text-edit.hpp>
 
 namespace advss {
 
@@ -20,10 +22,20 @@ public:
 	static std::shared_ptr<MacroAction> Create(Macro *m);
 	std::shared_ptr<MacroAction> Copy() const;
 
+	enum class Action {
+		SEND_MESSAGE,
+		SEND_SEQUENCE,
+	};
+
+	Action _action = Action::SEND_MESSAGE;
 	MidiDevice _device;
 	MidiMessage _message;
+	// Raw messages, one per line, see ParseMidiSequence()
+	StringVariable _sequence = "+0 B0 07 7F\n+100 B0 07 00";
 
 private:
+	void SendSequence();
+
 	static bool _registered;
 	static const std::string id;
 };
@@ -46,6 +58,8 @@ public:
 	}
 
 private slots:
+	void ActionChanged(int);
+	void SequenceChanged();
 	void DeviceSelectionChanged(const MidiDevice &);
 	void ListenDeviceSelectionChanged(const MidiDevice &);
 	void MidiMessageChanged(const MidiMessage &);
@@ -57,11 +71,15 @@ signals:
 
 private:
 	void EnableListening(bool);
+	void SetWidgetVisibility();
 
 	std::shared_ptr<MacroActionMidi> _entryData;
 
+	QComboBox *_actions;
 	MidiDeviceSelection *_devices;
 	MidiMessageSelection *_message;
+	VariableTextEdit *_sequence;
+	QHBoxLayout *_listenLayout;
 	MidiDeviceSelection *_listenDevices;
 	QPushButton *_resetMidiDevices;
 	QPushButton *_listen;
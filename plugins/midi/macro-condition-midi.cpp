@@ -5,6 +5,16 @@
 
 namespace advss {
 
+template<class T>
+static inline void populateList(QComboBox *list,
+				const std::map<T, std::string> &map)
+{
+	list->clear();
+	for (const auto &[_, name] : map) {
+		list->addItem(obs_module_text(name.c_str()));
+	}
+}
+
 const std::string MacroConditionMidi::id = "midi";
 
 bool MacroConditionMidi::_registered = MacroConditionFactory::Register(
@@ -12,7 +22,37 @@ bool MacroConditionMidi::_registered = MacroConditionFactory::Register(
 	{MacroConditionMidi::Create, MacroConditionMidiEdit::Create,
 	 "AdvSceneSwitcher.condition.midi"});
 
+const static std::map<MacroConditionMidi::Mode, std::string> modes = {
+	{MacroConditionMidi::Mode::MESSAGE_RECEIVED,
+	 "AdvSceneSwitcher.condition.midi.mode.messageReceived"},
+	{MacroConditionMidi::Mode::CURRENT_VALUE,
+	 "AdvSceneSwitcher.condition.midi.mode.currentValue"},
+};
+
+const static std::map<MacroConditionMidi::Comparison, std::string>
+	comparisons = {
+		{MacroConditionMidi::Comparison::EQUALS,
+		 "AdvSceneSwitcher.condition.midi.comparison.equals"},
+		{MacroConditionMidi::Comparison::ABOVE,
+		 "AdvSceneSwitcher.condition.midi.comparison.above"},
+		{MacroConditionMidi::Comparison::BELOW,
+		 "AdvSceneSwitcher.condition.midi.comparison.below"},
+};
+
 bool MacroConditionMidi::CheckCondition()
+{
+	switch (_mode) {
+	case Mode::MESSAGE_RECEIVED:
+		return CheckMessageReceived();
+	case Mode::CURRENT_VALUE:
+		return CheckCurrentValue();
+	default:
+		break;
+	}
+	return false;
+}
+
+bool MacroConditionMidi::CheckMessageReceived()
 {
 	if (!_messageBuffer) {
 		return false;
@@ -27,11 +67,13 @@ bool MacroConditionMidi::CheckCondition()
 	}
 
 	while (!_messageBuffer->Empty()) {
-		auto message = _messageBuffer->ConsumeMessage();
+		std::chrono::steady_clock::time_point arrival;
+		auto message = _messageBuffer->ConsumeMessage(arrival);
 		if (!message) {
 			continue;
 		}
 		if (message->Matches(_message)) {
+			TraceTriggerEvent("midi", arrival);
 			SetVariableValues(*message);
 			if (_clearBufferOnMatch) {
 				_messageBuffer->Clear();
@@ -43,12 +85,48 @@ bool MacroConditionMidi::CheckCondition()
 	return false;
 }
 
+bool MacroConditionMidi::CheckCurrentValue()
+{
+	const auto entry = _device.GetCurrentValue(_message);
+	if (!entry) {
+		return false;
+	}
+
+	// If no value is selected any received value matches
+	const int target = _message.Value();
+	bool match = target < 0;
+	if (!match) {
+		switch (_comparison) {
+		case Comparison::EQUALS:
+			match = entry->value == target;
+			break;
+		case Comparison::ABOVE:
+			match = entry->value > target;
+			break;
+		case Comparison::BELOW:
+			match = entry->value < target;
+			break;
+		default:
+			break;
+		}
+	}
+
+	SetVariableValue(std::to_string(entry->value));
+	SetTempVarValue("type", MidiMessage::MidiTypeToString(_message.Type()));
+	SetTempVarValue("channel", std::to_string(entry->channel));
+	SetTempVarValue("value1", std::to_string(entry->number));
+	SetTempVarValue("value2", std::to_string(entry->value));
+	return match;
+}
+
 bool MacroConditionMidi::Save(obs_data_t *obj) const
 {
 	MacroCondition::Save(obj);
 	_message.Save(obj);
 	_device.Save(obj);
 	obs_data_set_bool(obj, "clearBufferOnMatch", _clearBufferOnMatch);
+	obs_data_set_int(obj, "mode", static_cast<int>(_mode));
+	obs_data_set_int(obj, "comparison", static_cast<int>(_comparison));
 	obs_data_set_int(obj, "version", 1);
 	return true;
 }
@@ -58,7 +136,10 @@ bool MacroConditionMidi::Load(obs_data_t *obj)
 	MacroCondition::Load(obj);
 	_message.Load(obj);
 	_device.Load(obj);
-	_messageBuffer = _device.RegisterForMidiMessages();
+	_mode = static_cast<Mode>(obs_data_get_int(obj, "mode"));
+	_comparison =
+		static_cast<Comparison>(obs_data_get_int(obj, "comparison"));
+	UpdateMessageBuffer();
 	_clearBufferOnMatch = obs_data_get_bool(obj, "clearBufferOnMatch");
 	if (!obs_data_has_user_value(obj, "version")) {
 		_clearBufferOnMatch = true;
@@ -71,10 +152,38 @@ std::string MacroConditionMidi::GetShortDesc() const
 	return _device.Name();
 }
 
+void MacroConditionMidi::SetMode(Mode mode)
+{
+	_mode = mode;
+	UpdateMessageBuffer();
+}
+
 void MacroConditionMidi::SetDevice(const MidiDevice &dev)
 {
 	_device = dev;
-	_messageBuffer = dev.RegisterForMidiMessages();
+	UpdateMessageBuffer();
+}
+
+void MacroConditionMidi::SetMessage(const MidiMessage &message)
+{
+	const bool routingChanged =
+		message.TypeIsOptional() != _message.TypeIsOptional() ||
+		message.Type() != _message.Type();
+	_message = message;
+	if (routingChanged) {
+		UpdateMessageBuffer();
+	}
+}
+
+void MacroConditionMidi::UpdateMessageBuffer()
+{
+	// The current value is read from the device's state table, so there is
+	// no need to receive a copy of every message
+	if (_mode == Mode::CURRENT_VALUE) {
+		_messageBuffer.reset();
+		return;
+	}
+	_messageBuffer = _device.RegisterForMidiMessages(_message);
 }
 
 void MacroConditionMidi::SetupTempVars()
@@ -110,6 +219,8 @@ void MacroConditionMidi::SetVariableValues(const MidiMessage &m)
 MacroConditionMidiEdit::MacroConditionMidiEdit(
 	QWidget *parent, std::shared_ptr<MacroConditionMidi> entryData)
 	: QWidget(parent),
+	  _mode(new QComboBox(this)),
+	  _comparison(new QComboBox(this)),
 	  _devices(new MidiDeviceSelection(this, MidiDeviceType::INPUT)),
 	  _message(new MidiMessageSelection(this)),
 	  _resetMidiDevices(new QPushButton(
@@ -117,8 +228,17 @@ MacroConditionMidiEdit::MacroConditionMidiEdit(
 	  _listen(new QPushButton(
 		  obs_module_text("AdvSceneSwitcher.midi.startListen"))),
 	  _clearBufferOnMatch(new QCheckBox(
-		  obs_module_text("AdvSceneSwitcher.clearBufferOnMatch")))
+		  obs_module_text("AdvSceneSwitcher.clearBufferOnMatch"))),
+	  _entryLayout(new QHBoxLayout()),
+	  _comparisonLayout(new QHBoxLayout())
 {
+	populateList(_mode, modes);
+	populateList(_comparison, comparisons);
+
+	QWidget::connect(_mode, SIGNAL(currentIndexChanged(int)), this,
+			 SLOT(ModeChanged(int)));
+	QWidget::connect(_comparison, SIGNAL(currentIndexChanged(int)), this,
+			 SLOT(ComparisonChanged(int)));
 	QWidget::connect(_devices,
 			 SIGNAL(DeviceSelectionChanged(const MidiDevice &)),
 			 this,
@@ -135,17 +255,24 @@ MacroConditionMidiEdit::MacroConditionMidiEdit(
 	QWidget::connect(&_listenTimer, SIGNAL(timeout()), this,
 			 SLOT(SetMessageSelectionToLastReceived()));
 
-	auto entryLayout = new QHBoxLayout;
-	PlaceWidgets(obs_module_text("AdvSceneSwitcher.condition.midi.entry"),
-		     entryLayout, {{"{{device}}", _devices}});
+	auto modeLayout = new QHBoxLayout;
+	PlaceWidgets(
+		obs_module_text("AdvSceneSwitcher.condition.midi.entry.mode"),
+		modeLayout, {{"{{mode}}", _mode}});
+	PlaceWidgets(
+		obs_module_text(
+			"AdvSceneSwitcher.condition.midi.entry.comparison"),
+		_comparisonLayout, {{"{{comparison}}", _comparison}});
 	auto listenLayout = new QHBoxLayout;
 	PlaceWidgets(
 		obs_module_text("AdvSceneSwitcher.condition.midi.entry.listen"),
 		listenLayout, {{"{{listenButton}}", _listen}});
 
 	auto mainLayout = new QVBoxLayout;
-	mainLayout->addLayout(entryLayout);
+	mainLayout->addLayout(modeLayout);
+	mainLayout->addLayout(_entryLayout);
 	mainLayout->addWidget(_message);
+	mainLayout->addLayout(_comparisonLayout);
 	mainLayout->addLayout(listenLayout);
 	mainLayout->addWidget(_resetMidiDevices);
 	mainLayout->addWidget(_clearBufferOnMatch);
@@ -169,14 +296,55 @@ void MacroConditionMidiEdit::UpdateEntryData()
 		return;
 	}
 
+	_mode->setCurrentIndex(static_cast<int>(_entryData->GetMode()));
+	_comparison->setCurrentIndex(
+		static_cast<int>(_entryData->_comparison));
 	_message->SetMessage(_entryData->_message);
 	_devices->SetDevice(_entryData->GetDevice());
 	_clearBufferOnMatch->setChecked(_entryData->_clearBufferOnMatch);
+	SetWidgetVisibility();
+}
+
+void MacroConditionMidiEdit::SetWidgetVisibility()
+{
+	_entryLayout->removeWidget(_devices);
+	ClearLayout(_entryLayout);
+	const bool isValueCheck = _entryData->GetMode() ==
+				  MacroConditionMidi::Mode::CURRENT_VALUE;
+	const char *entryText =
+		isValueCheck
+			? "AdvSceneSwitcher.condition.midi.entry.currentValue"
+			: "AdvSceneSwitcher.condition.midi.entry";
+	PlaceWidgets(obs_module_text(entryText), _entryLayout,
+		     {{"{{device}}", _devices}});
+	SetLayoutVisible(_comparisonLayout, isValueCheck);
+	_clearBufferOnMatch->setVisible(!isValueCheck);
 
 	adjustSize();
 	updateGeometry();
 }
 
+void MacroConditionMidiEdit::ModeChanged(int value)
+{
+	if (_loading || !_entryData) {
+		return;
+	}
+
+	{
+		auto lock = LockContext();
+		_entryData->SetMode(
+			static_cast<MacroConditionMidi::Mode>(value));
+	}
+	SetWidgetVisibility();
+}
+
+void MacroConditionMidiEdit::ComparisonChanged(int value)
+{
+	GUARD_LOADING_AND_LOCK();
+	_entryData->_comparison =
+		static_cast<MacroConditionMidi::Comparison>(value);
+}
+
 void MacroConditionMidiEdit::DeviceSelectionChanged(const MidiDevice &device)
 {
 	if (_loading || !_entryData) {
@@ -198,7 +366,7 @@ void MacroConditionMidiEdit::DeviceSelectionChanged(const MidiDevice &device)
 void MacroConditionMidiEdit::MidiMessageChanged(const MidiMessage &message)
 {
 	GUARD_LOADING_AND_LOCK();
-	_entryData->_message = message;
+	_entryData->SetMessage(message);
 }
 
 void MacroConditionMidiEdit::ClearBufferOnMatchChanged(int value)
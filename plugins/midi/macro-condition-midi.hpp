@@ -3,6 +3,8 @@
 #include "midi-helpers.hpp"
 
 #include <QCheckBox>
+#include <QComboBox>
+#include <QHBoxLayout>
 #include <QPushButton>
 #include <QTimer>
 
@@ -21,15 +23,36 @@ public:
 		return std::make_shared<MacroConditionMidi>(m);
 	}
 
+	enum class Mode {
+		MESSAGE_RECEIVED,
+		// Compare against the last value received for the selected
+		// note, controller, or pitch bend
+		CURRENT_VALUE,
+	};
+
+	enum class Comparison {
+		EQUALS,
+		ABOVE,
+		BELOW,
+	};
+
+	void SetMode(Mode);
+	Mode GetMode() const { return _mode; }
 	void SetDevice(const MidiDevice &dev);
 	const MidiDevice &GetDevice() const { return _device; }
+	void SetMessage(const MidiMessage &);
 	MidiMessage _message;
 	bool _clearBufferOnMatch = true;
+	Comparison _comparison = Comparison::EQUALS;
 
 private:
+	bool CheckMessageReceived();
+	bool CheckCurrentValue();
+	void UpdateMessageBuffer();
 	void SetupTempVars();
 	void SetVariableValues(const MidiMessage &);
 
+	Mode _mode = Mode::MESSAGE_RECEIVED;
 	MidiDevice _device;
 	MidiMessageBuffer _messageBuffer;
 	std::chrono::high_resolution_clock::time_point _lastCheck{};
@@ -55,6 +78,8 @@ public:
 	}
 
 private slots:
+	void ModeChanged(int);
+	void ComparisonChanged(int);
 	void DeviceSelectionChanged(const MidiDevice &);
 	void MidiMessageChanged(const MidiMessage &);
 	void ClearBufferOnMatchChanged(int);
@@ -66,12 +91,17 @@ signals:
 
 private:
 	void EnableListening(bool);
+	void SetWidgetVisibility();
 
+	QComboBox *_mode;
+	QComboBox *_comparison;
 	MidiDeviceSelection *_devices;
 	MidiMessageSelection *_message;
 	QPushButton *_resetMidiDevices;
 	QPushButton *_listen;
 	QCheckBox *_clearBufferOnMatch;
+	QHBoxLayout *_entryLayout;
+	QHBoxLayout *_comparisonLayout;
 
 	std::shared_ptr<MacroConditionMidi> _entryData;
 	QTimer _listenTimer;
@@ -10,6 +10,8 @@
 #include <ui-helpers.hpp>
 #include <utility.hpp>
 
+#include <cstdio>
+
 #undef DispatchMessage
 
 namespace advss {
@@ -79,6 +81,14 @@ static bool setupDeviceObservers()
 
 static bool deviceObserversAreSetup = setupDeviceObservers();
 
+static bool setupCleanup()
+{
+	AddPluginCleanupStep(MidiDeviceInstance::StopAllSchedulers);
+	return true;
+}
+
+static bool cleanupIsSetup = setupCleanup();
+
 void MidiDeviceInstance::ResetAllDevices()
 {
 	for (auto const &[_, device] : MidiDeviceInstance::devices) {
@@ -87,6 +97,14 @@ void MidiDeviceInstance::ResetAllDevices()
 	}
 }
 
+void MidiDeviceInstance::StopAllSchedulers()
+{
+	for (auto const &[_, device] : MidiDeviceInstance::devices) {
+		std::lock_guard<std::mutex> lock(device->_schedulerMutex);
+		device->_scheduler.reset();
+	}
+}
+
 MidiMessage::MidiMessage(const libremidi::message &message)
 {
 	_typeIsOptional = false;
@@ -434,6 +452,15 @@ bool MidiDevice::SendMessge(const MidiMessage &m) const
 	return _dev->SendMessge(m);
 }
 
+bool MidiDevice::ScheduleMessages(std::vector<MidiOutputEvent> &&events) const
+{
+	if (_type == MidiDeviceType::INPUT || _name.empty() || !_dev) {
+		return false;
+	}
+
+	return _dev->ScheduleMessages(std::move(events));
+}
+
 static std::optional<libremidi::output_port>
 getOutPortFromName(const std::string &name)
 {
@@ -483,6 +510,7 @@ bool MidiDeviceInstance::OpenPort()
 			return false;
 		}
 		try {
+			std::lock_guard<std::mutex> lock(_outMutex);
 			_out.open_port(*port);
 			blog(LOG_INFO, "Opened output midi port '%s'",
 			     _name.c_str());
@@ -548,6 +576,7 @@ void MidiDeviceInstance::ClosePort()
 
 	if (_type == MidiDeviceType::OUTPUT) {
 		try {
+			std::lock_guard<std::mutex> lock(_outMutex);
 			_out.close_port();
 			blog(LOG_INFO, "Closed output midi port '%s'",
 			     _name.c_str());
@@ -627,11 +656,81 @@ bool MidiDeviceInstance::SendMessge(const MidiMessage &m)
 		break;
 	}
 
+	RawMidiMessage raw;
+	for (size_t i = 0; i < message.size(); i++) {
+		raw.push_back(message[i]);
+	}
+	return ScheduleMessages(
+		{{std::chrono::steady_clock::now(), {std::move(raw)}}});
+}
+
+bool MidiDeviceInstance::ScheduleMessages(
+	std::vector<MidiOutputEvent> &&events)
+{
+	if (_type == MidiDeviceType::INPUT || !IsOpened()) {
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(_schedulerMutex);
+	if (!_scheduler) {
+		_scheduler = std::make_unique<MidiOutputScheduler>(
+			[this](const RawMidiMessage &message) {
+				return SendRawMessage(message);
+			});
+	}
+	_scheduler->Schedule(std::move(events));
+	return true;
+}
+
+static std::string rawMidiMessageToString(const RawMidiMessage &message)
+{
+	std::string result;
+	char byte[4];
+	for (const auto value : message) {
+		snprintf(byte, sizeof(byte), "%02X ", value);
+		result += byte;
+	}
+	if (!result.empty()) {
+		result.pop_back();
+	}
+	return result;
+}
+
+// Called from the scheduler's thread, so failures can only be logged here
+bool MidiDeviceInstance::SendRawMessage(const RawMidiMessage &message)
+{
+	if (message.empty()) {
+		blog(LOG_WARNING, "failed to send empty midi message to \"%s\"",
+		     _name.c_str());
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(_outMutex);
+	if (!_out.is_port_open()) {
+		blog(LOG_WARNING,
+		     "failed to send midi message \"%s\" to \"%s\": port closed",
+		     rawMidiMessageToString(message).c_str(), _name.c_str());
+		return false;
+	}
+
 	try {
-		_out.send_message(message);
+		_out.send_message(message.data(), message.size());
 		return true;
 	} catch (const libremidi::driver_error &err) {
-		blog(LOG_WARNING, "%s", err.what());
+		blog(LOG_WARNING,
+		     "failed to send midi message \"%s\" to \"%s\": %s",
+		     rawMidiMessageToString(message).c_str(), _name.c_str(),
+		     err.what());
+	} catch (const libremidi::system_error &err) {
+		blog(LOG_WARNING,
+		     "failed to send midi message \"%s\" to \"%s\": %s",
+		     rawMidiMessageToString(message).c_str(), _name.c_str(),
+		     err.what());
+	} catch (const libremidi::midi_exception &err) {
+		blog(LOG_WARNING,
+		     "failed to send midi message \"%s\" to \"%s\": %s",
+		     rawMidiMessageToString(message).c_str(), _name.c_str(),
+		     err.what());
 	}
 
 	return false;
@@ -642,13 +741,68 @@ MidiMessageBuffer MidiDeviceInstance::RegisterForMidiMessages()
 	return _dispatcher.RegisterClient();
 }
 
+MidiMessageBuffer
+MidiDeviceInstance::RegisterForMidiMessages(libremidi::message_type type)
+{
+	return _dispatcher.RegisterClient(type);
+}
+
 void MidiDeviceInstance::ReceiveMidiMessage(libremidi::message &&msg)
 {
-	_dispatcher.DispatchMessage(msg);
+	const MidiMessage message(msg);
+	UpdateState(message);
+	_dispatcher.DispatchMessage(message, message.Type());
 	vblog(LOG_INFO, "received midi: %s",
 	      MidiMessage::ToString(msg).c_str());
 }
 
+static std::optional<MidiStateTable::Kind>
+getStateTableKind(libremidi::message_type type)
+{
+	switch (type) {
+	case libremidi::message_type::CONTROL_CHANGE:
+		return MidiStateTable::Kind::CONTROL_CHANGE;
+	case libremidi::message_type::NOTE_ON:
+	case libremidi::message_type::NOTE_OFF:
+		return MidiStateTable::Kind::NOTE;
+	case libremidi::message_type::PITCH_BEND:
+		return MidiStateTable::Kind::PITCH_BEND;
+	default:
+		return {};
+	}
+}
+
+void MidiDeviceInstance::UpdateState(const MidiMessage &message)
+{
+	const auto kind = getStateTableKind(message.Type());
+	if (!kind) {
+		return;
+	}
+	// The velocity of note off messages is the release velocity, so store 0
+	// to indicate that the note is no longer held
+	const int value = message.Type() == libremidi::message_type::NOTE_OFF
+				  ? 0
+				  : message.Value();
+	_state.Set(*kind, message.Channel(), message.Note(), value);
+}
+
+std::optional<MidiStateTable::Entry>
+MidiDeviceInstance::GetCurrentValue(const MidiMessage &message) const
+{
+	const auto kind = getStateTableKind(message.Type());
+	if (!kind) {
+		return {};
+	}
+	// Any received value matches if no channel or note is selected
+	return _state.GetLatest(
+		*kind,
+		message.ChannelIsOptional()
+			? std::nullopt
+			: std::optional<int>(message.Channel()),
+		message.NoteIsOptional() ? std::nullopt
+					 : std::optional<int>(message.Note()));
+}
+
 [[nodiscard]] MidiMessageBuffer MidiDevice::RegisterForMidiMessages() const
 {
 	if (_type == MidiDeviceType::OUTPUT || _name.empty() || !_dev) {
@@ -658,6 +812,29 @@ void MidiDeviceInstance::ReceiveMidiMessage(libremidi::message &&msg)
 	return _dev->RegisterForMidiMessages();
 }
 
+[[nodiscard]] MidiMessageBuffer
+MidiDevice::RegisterForMidiMessages(const MidiMessage &message) const
+{
+	if (_type == MidiDeviceType::OUTPUT || _name.empty() || !_dev) {
+		return {};
+	}
+
+	if (message.TypeIsOptional()) {
+		return _dev->RegisterForMidiMessages();
+	}
+	return _dev->RegisterForMidiMessages(message.Type());
+}
+
+std::optional<MidiStateTable::Entry>
+MidiDevice::GetCurrentValue(const MidiMessage &message) const
+{
+	if (_type == MidiDeviceType::OUTPUT || _name.empty() || !_dev ||
+	    message.TypeIsOptional()) {
+		return {};
+	}
+	return _dev->GetCurrentValue(message);
+}
+
 std::string MidiDevice::Name() const
 {
 	return _name;
@@ -1,4 +1,7 @@
 #pragma once
+#include "midi-output-scheduler.hpp"
+#include "midi-state-table.hpp"
+
 #include <QComboBox>
 #include <message-dispatcher.hpp>
 #include <obs-data.h>
@@ -13,7 +16,9 @@ namespace advss {
 
 class MidiMessage;
 using MidiMessageBuffer = std::shared_ptr<MessageBuffer<MidiMessage>>;
-using MidiMessageDispatcher = MessageDispatcher<MidiMessage>;
+// Messages are routed by their type
+using MidiMessageDispatcher =
+	MessageDispatcher<MidiMessage, libremidi::message_type>;
 
 // Based on https://github.com/nhielost/obs-midi-mg MMGMessage
 class MidiMessage {
@@ -34,6 +39,12 @@ public:
 
 	std::string ToString() const;
 	libremidi::message_type Type() const { return _type; }
+	bool TypeIsOptional() const { return _typeIsOptional; }
+	bool ChannelIsOptional() const
+	{
+		return _channel == optionalChannelIndicator;
+	}
+	bool NoteIsOptional() const { return _note == optionalNoteIndicator; }
 	int Channel() const { return _channel; }
 	int Note() const { return _note; }
 	int Value() const { return _value; }
@@ -72,6 +83,7 @@ public:
 	static MidiDeviceInstance *GetDevice(const libremidi::output_port &p);
 
 	static void ResetAllDevices();
+	static void StopAllSchedulers();
 
 	bool OpenPort();
 	void ClosePort();
@@ -80,9 +92,18 @@ private:
 	MidiDeviceInstance() = default;
 	~MidiDeviceInstance() = default;
 	bool IsOpened() const;
+	// Only report whether the messages could be queued.
+	// Failures to actually send them are logged by the scheduler's thread.
 	bool SendMessge(const MidiMessage &);
+	bool ScheduleMessages(std::vector<MidiOutputEvent> &&);
+	bool SendRawMessage(const RawMidiMessage &);
 	[[nodiscard]] MidiMessageBuffer RegisterForMidiMessages();
+	[[nodiscard]] MidiMessageBuffer
+	RegisterForMidiMessages(libremidi::message_type);
 	void ReceiveMidiMessage(libremidi::message &&);
+	void UpdateState(const MidiMessage &);
+	std::optional<MidiStateTable::Entry>
+	GetCurrentValue(const MidiMessage &) const;
 
 	static std::map<std::pair<MidiDeviceType, std::string>,
 			MidiDeviceInstance *>
@@ -97,7 +118,15 @@ private:
 			}});
 	libremidi::midi_out _out =
 		libremidi::midi_out(libremidi::output_configuration());
+	// Guards _out as messages are sent from the scheduler's thread
+	std::mutex _outMutex;
+	std::mutex _schedulerMutex;
+	// Created when the first message is sent
+	std::unique_ptr<MidiOutputScheduler> _scheduler;
 	MidiMessageDispatcher _dispatcher;
+	// Last received values, which can be queried without having to
+	// consume all messages of the dispatcher
+	MidiStateTable _state;
 
 	friend class MidiDevice;
 };
@@ -110,7 +139,16 @@ public:
 	void Load(obs_data_t *obj);
 
 	bool SendMessge(const MidiMessage &) const;
+	// Messages are sent asynchronously at the time of their event
+	bool ScheduleMessages(std::vector<MidiOutputEvent> &&) const;
 	[[nodiscard]] MidiMessageBuffer RegisterForMidiMessages() const;
+	// Only receives messages which could match the given message
+	[[nodiscard]] MidiMessageBuffer
+	RegisterForMidiMessages(const MidiMessage &) const;
+	// Returns the last value received for the note, controller, or pitch
+	// bend on the channel of the given message
+	std::optional<MidiStateTable::Entry>
+	GetCurrentValue(const MidiMessage &) const;
 
 	std::string Name() const;
 
@@ -0,0 +1,309 @@
+#include "midi-output-scheduler.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <unordered_map>
+
+namespace advss {
+
+static bool isControlChange(const RawMidiMessage &message)
+{
+	return message.size() == 3 && (message[0] & 0xF0) == 0xB0;
+}
+
+// Events consisting of a single control change or a 14-bit control change
+// pair can be coalesced with later updates to the same controller
+static std::optional<int>
+getCoalescingKey(const std::vector<RawMidiMessage> &messages)
+{
+	if (messages.empty() || messages.size() > 2 ||
+	    !isControlChange(messages[0])) {
+		return {};
+	}
+	const int status = messages[0][0];
+	const int controller = messages[0][1];
+	if (messages.size() == 1) {
+		return (status << 8) | controller;
+	}
+	const auto &lsb = messages[1];
+	if (!isControlChange(lsb) || lsb[0] != status || controller >= 32 ||
+	    lsb[1] != controller + 32) {
+		return {};
+	}
+	// Distinguish pairs from single updates of the MSB controller
+	return (1 << 16) | (status << 8) | controller;
+}
+
+void MidiOutputQueue::Push(MidiOutputEvent &&event)
+{
+	_events.emplace(event.time, std::move(event.messages));
+}
+
+std::vector<MidiOutputEvent> MidiOutputQueue::TakeDue(Clock::time_point now)
+{
+	std::vector<MidiOutputEvent> due;
+	auto end = _events.upper_bound(now);
+	for (auto it = _events.begin(); it != end; ++it) {
+		due.push_back({it->first, std::move(it->second)});
+	}
+	_events.erase(_events.begin(), end);
+
+	std::unordered_map<int, size_t> lastIndex;
+	for (size_t i = 0; i < due.size(); i++) {
+		const auto key = getCoalescingKey(due[i].messages);
+		if (key) {
+			lastIndex[*key] = i;
+		}
+	}
+
+	std::vector<MidiOutputEvent> result;
+	result.reserve(due.size());
+	for (size_t i = 0; i < due.size(); i++) {
+		const auto key = getCoalescingKey(due[i].messages);
+		if (key && lastIndex[*key] != i) {
+			continue;
+		}
+		result.emplace_back(std::move(due[i]));
+	}
+	return result;
+}
+
+std::optional<MidiOutputQueue::Clock::time_point>
+MidiOutputQueue::NextTime() const
+{
+	if (_events.empty()) {
+		return {};
+	}
+	return _events.begin()->first;
+}
+
+MidiOutputScheduler::MidiOutputScheduler(SendFunction send,
+					 std::chrono::milliseconds frame)
+	: _send(std::move(send)),
+	  _frame(frame)
+{
+	_thread = std::thread(&MidiOutputScheduler::Thread, this);
+}
+
+MidiOutputScheduler::~MidiOutputScheduler()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_cv.notify_all();
+	if (_thread.joinable()) {
+		_thread.join();
+	}
+}
+
+void MidiOutputScheduler::Schedule(MidiOutputEvent &&event)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_queue.Push(std::move(event));
+	}
+	_cv.notify_all();
+}
+
+void MidiOutputScheduler::Schedule(std::vector<MidiOutputEvent> &&events)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		for (auto &event : events) {
+			_queue.Push(std::move(event));
+		}
+	}
+	_cv.notify_all();
+}
+
+void MidiOutputScheduler::Clear()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_queue.Clear();
+}
+
+size_t MidiOutputScheduler::PendingCount() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _queue.Size();
+}
+
+uint64_t MidiOutputScheduler::FailedCount() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _failed;
+}
+
+void MidiOutputScheduler::Thread()
+{
+	auto lastFlush = Clock::time_point{};
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (!_stop) {
+		const auto next = _queue.NextTime();
+		if (!next) {
+			_cv.wait(lock);
+			continue;
+		}
+
+		const auto flushTime = std::max(*next, lastFlush + _frame);
+		if (Clock::now() < flushTime) {
+			_cv.wait_until(lock, flushTime);
+			continue;
+		}
+
+		lastFlush = Clock::now();
+		auto events = _queue.TakeDue(lastFlush);
+
+		// Do not block new events from being scheduled while waiting
+		// for the driver
+		lock.unlock();
+		uint64_t failed = 0;
+		for (const auto &event : events) {
+			for (const auto &message : event.messages) {
+				if (!_send(message)) {
+					++failed;
+				}
+			}
+		}
+		lock.lock();
+		_failed += failed;
+	}
+}
+
+static unsigned char getStatusByte(int type, int channel)
+{
+	return static_cast<unsigned char>(type | ((channel - 1) & 0x0F));
+}
+
+RawMidiMessage MakeMidiControlChange(int channel, int controller, int value)
+{
+	return {getStatusByte(0xB0, channel),
+		static_cast<unsigned char>(controller & 0x7F),
+		static_cast<unsigned char>(value & 0x7F)};
+}
+
+std::vector<RawMidiMessage> MakeMidiControlChange14Bit(int channel,
+						       int controller,
+						       int value)
+{
+	value = std::clamp(value, 0, 0x3FFF);
+	return {MakeMidiControlChange(channel, controller & 0x1F, value >> 7),
+		MakeMidiControlChange(channel, (controller & 0x1F) + 32,
+				      value & 0x7F)};
+}
+
+static bool parseByte(const std::string &token, unsigned char &byte)
+{
+	if (token.empty() || token.size() > 2) {
+		return false;
+	}
+	try {
+		size_t pos = 0;
+		const auto value = std::stoi(token, &pos, 16);
+		if (pos != token.size() || value < 0) {
+			return false;
+		}
+		byte = static_cast<unsigned char>(value);
+		return true;
+	} catch (...) {
+		return false;
+	}
+}
+
+static bool parseInt(const std::string &token, int &value)
+{
+	try {
+		size_t pos = 0;
+		value = std::stoi(token, &pos);
+		return pos == token.size();
+	} catch (...) {
+		return false;
+	}
+}
+
+static void setError(std::string *error, int line, const std::string &msg)
+{
+	if (error) {
+		*error = "line " + std::to_string(line) + ": " + msg;
+	}
+}
+
+std::optional<std::vector<MidiOutputEvent>>
+ParseMidiSequence(const std::string &text,
+		  std::chrono::steady_clock::time_point start,
+		  std::string *error)
+{
+	std::vector<MidiOutputEvent> events;
+	auto time = start;
+	std::istringstream stream(text);
+	std::string line;
+	int lineNumber = 0;
+	while (std::getline(stream, line)) {
+		++lineNumber;
+		std::istringstream lineStream(line);
+		std::vector<std::string> tokens;
+		std::string token;
+		while (lineStream >> token) {
+			tokens.emplace_back(token);
+		}
+		if (tokens.empty() || tokens[0][0] == '#') {
+			continue;
+		}
+
+		size_t idx = 0;
+		if (tokens[0][0] == '+') {
+			int delay = 0;
+			if (!parseInt(tokens[0].substr(1), delay) ||
+			    delay < 0) {
+				setError(error, lineNumber, "invalid delay");
+				return {};
+			}
+			time += std::chrono::milliseconds(delay);
+			++idx;
+		}
+		if (idx == tokens.size()) {
+			setError(error, lineNumber, "missing message");
+			return {};
+		}
+
+		if (tokens[idx] == "cc14") {
+			int channel, controller, value;
+			if (tokens.size() - idx != 4 ||
+			    !parseInt(tokens[idx + 1], channel) ||
+			    !parseInt(tokens[idx + 2], controller) ||
+			    !parseInt(tokens[idx + 3], value) ||
+			    channel < 1 || channel > 16 || controller < 0 ||
+			    controller > 31 || value < 0 || value > 0x3FFF) {
+				setError(error, lineNumber,
+					 "invalid 14-bit control change");
+				return {};
+			}
+			events.push_back({time, MakeMidiControlChange14Bit(
+							channel, controller,
+							value)});
+			continue;
+		}
+
+		RawMidiMessage message;
+		for (; idx < tokens.size(); idx++) {
+			unsigned char byte;
+			if (!parseByte(tokens[idx], byte)) {
+				setError(error, lineNumber,
+					 "invalid byte \"" + tokens[idx] +
+						 "\"");
+				return {};
+			}
+			message.push_back(byte);
+		}
+		if (!(message[0] & 0x80)) {
+			setError(error, lineNumber,
+				 "message must start with a status byte");
+			return {};
+		}
+		events.push_back({time, {message}});
+	}
+	return events;
+}
+
+} // namespace advss
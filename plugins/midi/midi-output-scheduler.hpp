@@ -0,0 +1,107 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace advss {
+
+using RawMidiMessage = std::vector<unsigned char>;
+
+// Group of raw MIDI messages, which are sent back to back at the given time
+struct MidiOutputEvent {
+	std::chrono::steady_clock::time_point time;
+	std::vector<RawMidiMessage> messages;
+};
+
+// Orders pending output events by time.
+// Events with the same time keep the order in which they were added.
+//
+// Not thread safe - access has to be synchronized by the owner.
+class MidiOutputQueue {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	void Push(MidiOutputEvent &&);
+	// Removes and returns all events due at the given time.
+	// If several control change events for the same controller are due,
+	// only the last one is returned, as the earlier values would be
+	// overwritten immediately anyway.
+	std::vector<MidiOutputEvent> TakeDue(Clock::time_point now);
+	std::optional<Clock::time_point> NextTime() const;
+	size_t Size() const { return _events.size(); }
+	bool Empty() const { return _events.empty(); }
+	void Clear() { _events.clear(); }
+
+private:
+	std::multimap<Clock::time_point, std::vector<RawMidiMessage>> _events;
+};
+
+// Sends scheduled MIDI messages on its own thread, so the caller does not
+// have to wait for the driver.
+// Due events are flushed at most once per frame, which allows redundant
+// control change updates within a frame to be dropped.
+//
+// As messages are only sent after Schedule() returned, send failures cannot be
+// reported to the caller. The send function is expected to log them and they
+// are counted in FailedCount().
+class MidiOutputScheduler {
+public:
+	using Clock = MidiOutputQueue::Clock;
+	using SendFunction = std::function<bool(const RawMidiMessage &)>;
+
+	MidiOutputScheduler(SendFunction,
+			    std::chrono::milliseconds frame = defaultFrame);
+	~MidiOutputScheduler();
+
+	void Schedule(MidiOutputEvent &&);
+	void Schedule(std::vector<MidiOutputEvent> &&);
+	// Drops all pending events
+	void Clear();
+	size_t PendingCount() const;
+	// Number of messages the send function failed to send
+	uint64_t FailedCount() const;
+
+	static constexpr std::chrono::milliseconds defaultFrame =
+		std::chrono::milliseconds(5);
+
+private:
+	void Thread();
+
+	const SendFunction _send;
+	const std::chrono::milliseconds _frame;
+	MidiOutputQueue _queue;
+	mutable std::mutex _mutex;
+	std::condition_variable _cv;
+	bool _stop = false;
+	uint64_t _failed = 0;
+	std::thread _thread;
+};
+
+RawMidiMessage MakeMidiControlChange(int channel, int controller, int value);
+// Splits the 14-bit value into the MSB for the given controller in the range
+// of [0, 31] and the LSB for its paired controller 32 numbers above
+std::vector<RawMidiMessage> MakeMidiControlChange14Bit(int channel,
+						       int controller,
+						       int value);
+
+// Parses a sequence of MIDI messages with one event per line:
+//
+//   [+<delay ms>] <hex bytes>
+//   [+<delay ms>] cc14 <channel> <controller> <value>
+//
+// Delays are relative to the previous line.
+// Empty lines and lines starting with '#' are ignored.
+// On failure nothing is returned and the error is written to "error".
+std::optional<std::vector<MidiOutputEvent>>
+ParseMidiSequence(const std::string &text,
+		  std::chrono::steady_clock::time_point start,
+		  std::string *error = nullptr);
+
+} // namespace advss
@@ -0,0 +1,184 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace advss {
+
+// Last received value of every controller, note, and the pitch bend of each
+// MIDI channel.
+// Updated by the thread receiving the MIDI messages and can be queried from
+// any other thread without locking.
+class MidiStateTable {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	enum class Kind {
+		CONTROL_CHANGE,
+		// The velocity of the note, which is 0 if the note was released
+		NOTE,
+		PITCH_BEND,
+	};
+
+	struct Entry {
+		int value = 0;
+		Clock::time_point time;
+		int channel = 0;
+		int number = 0;
+	};
+
+	static constexpr int channelCount = 16;
+	static constexpr int numberCount = 128;
+
+	MidiStateTable(Clock::time_point epoch = Clock::now());
+
+	// Channels are in the range of [1, 16] and numbers in [0, 127].
+	// The number is ignored for pitch bend values.
+	// Values outside of these ranges are ignored.
+	void Set(Kind, int channel, int number, int value,
+		 Clock::time_point time = Clock::now());
+	// Returns nothing if no value was received yet
+	std::optional<Entry> Get(Kind, int channel, int number = 0) const;
+	// Returns the most recently received value of all entries matching
+	// the given channel and number. If no channel or number is given, any
+	// channel or number matches.
+	std::optional<Entry> GetLatest(Kind, std::optional<int> channel,
+				       std::optional<int> number) const;
+	void Clear();
+
+private:
+	// Value and timestamp are packed into a single word, so each entry can
+	// be updated atomically:
+	// Bit 63 marks the entry as valid, bits 48 to 62 hold the value, and
+	// the lower 48 bits the milliseconds passed since the epoch.
+	static constexpr uint64_t validBit = uint64_t(1) << 63;
+	static constexpr int valueShift = 48;
+	static constexpr uint64_t valueMask = 0x7FFF;
+	static constexpr uint64_t timeMask = (uint64_t(1) << valueShift) - 1;
+
+	std::atomic<uint64_t> *GetSlot(Kind, int channel, int number);
+	const std::atomic<uint64_t> *GetSlot(Kind, int channel,
+					     int number) const;
+
+	const Clock::time_point _epoch;
+	std::array<std::atomic<uint64_t>, channelCount * numberCount>
+		_controllers = {};
+	std::array<std::atomic<uint64_t>, channelCount * numberCount> _notes =
+		{};
+	std::array<std::atomic<uint64_t>, channelCount> _pitchBend = {};
+};
+
+inline MidiStateTable::MidiStateTable(Clock::time_point epoch) : _epoch(epoch)
+{
+	Clear();
+}
+
+inline const std::atomic<uint64_t> *
+MidiStateTable::GetSlot(Kind kind, int channel, int number) const
+{
+	if (channel < 1 || channel > channelCount) {
+		return nullptr;
+	}
+	const int channelIdx = channel - 1;
+	if (kind == Kind::PITCH_BEND) {
+		return &_pitchBend[channelIdx];
+	}
+	if (number < 0 || number >= numberCount) {
+		return nullptr;
+	}
+	const int idx = channelIdx * numberCount + number;
+	switch (kind) {
+	case Kind::CONTROL_CHANGE:
+		return &_controllers[idx];
+	case Kind::NOTE:
+		return &_notes[idx];
+	default:
+		return nullptr;
+	}
+}
+
+inline std::atomic<uint64_t> *MidiStateTable::GetSlot(Kind kind, int channel,
+						      int number)
+{
+	return const_cast<std::atomic<uint64_t> *>(
+		static_cast<const MidiStateTable *>(this)->GetSlot(
+			kind, channel, number));
+}
+
+inline void MidiStateTable::Set(Kind kind, int channel, int number, int value,
+				Clock::time_point time)
+{
+	auto slot = GetSlot(kind, channel, number);
+	if (!slot || value < 0) {
+		return;
+	}
+	const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+				time - _epoch)
+				.count();
+	const uint64_t timestamp = ms > 0 ? (uint64_t(ms) & timeMask) : 0;
+	const uint64_t packed = validBit |
+				((uint64_t(value) & valueMask) << valueShift) |
+				timestamp;
+	slot->store(packed, std::memory_order_release);
+}
+
+inline std::optional<MidiStateTable::Entry>
+MidiStateTable::Get(Kind kind, int channel, int number) const
+{
+	auto slot = GetSlot(kind, channel, number);
+	if (!slot) {
+		return {};
+	}
+	const uint64_t packed = slot->load(std::memory_order_acquire);
+	if (!(packed & validBit)) {
+		return {};
+	}
+	Entry entry;
+	entry.value = static_cast<int>((packed >> valueShift) & valueMask);
+	entry.time = _epoch + std::chrono::milliseconds(packed & timeMask);
+	entry.channel = channel;
+	entry.number = kind == Kind::PITCH_BEND ? 0 : number;
+	return entry;
+}
+
+inline std::optional<MidiStateTable::Entry>
+MidiStateTable::GetLatest(Kind kind, std::optional<int> channel,
+			  std::optional<int> number) const
+{
+	// There is only a single pitch bend value per channel
+	if (kind == Kind::PITCH_BEND) {
+		number = 0;
+	}
+	const int firstChannel = channel ? *channel : 1;
+	const int lastChannel = channel ? *channel : channelCount;
+	const int firstNumber = number ? *number : 0;
+	const int lastNumber = number ? *number : numberCount - 1;
+
+	std::optional<Entry> result;
+	for (int c = firstChannel; c <= lastChannel; c++) {
+		for (int n = firstNumber; n <= lastNumber; n++) {
+			auto entry = Get(kind, c, n);
+			if (entry && (!result || entry->time > result->time)) {
+				result = entry;
+			}
+		}
+	}
+	return result;
+}
+
+inline void MidiStateTable::Clear()
+{
+	for (auto &slot : _controllers) {
+		slot.store(0, std::memory_order_relaxed);
+	}
+	for (auto &slot : _notes) {
+		slot.store(0, std::memory_order_relaxed);
+	}
+	for (auto &slot : _pitchBend) {
+		slot.store(0, std::memory_order_relaxed);
+	}
+}
+
+} // namespace advss
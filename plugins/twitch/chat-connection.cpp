@@ -15,6 +15,7 @@ using websocketpp::lib::placeholders::_2;
 using websocketpp::lib::bind;
 
 static const auto reconnectDelay = 15s;
+static constexpr size_t maxQueuedMessages = 100;
 
 /* ------------------------------------------------------------------------- */
 
@@ -274,7 +275,8 @@ TwitchChatConnection::TwitchChatConnection(const TwitchToken &token,
 					   const TwitchChannel &channel)
 	: QObject(nullptr),
 	  _token(token),
-	  _channel(channel)
+	  _channel(channel),
+	  _sendQueue(maxQueuedMessages, ChatMessageQueue::regularUserLimits)
 {
 	_client.get_alog().clear_channels(
 		websocketpp::log::alevel::frame_header |
@@ -296,10 +298,19 @@ TwitchChatConnection::TwitchChatConnection(const TwitchToken &token,
 			asio::ssl::context::sslv23_client);
 	});
 	_url = defaultURL.data();
+	_sendThread = std::thread(&TwitchChatConnection::SendThread, this);
 }
 
 TwitchChatConnection::~TwitchChatConnection()
 {
+	{
+		std::lock_guard<std::mutex> lock(_sendQueueMtx);
+		_stopSending = true;
+	}
+	_sendQueueCv.notify_all();
+	if (_sendThread.joinable()) {
+		_sendThread.join();
+	}
 	Disconnect();
 }
 
@@ -436,10 +447,54 @@ ChatMessageBuffer TwitchChatConnection::RegisterForWhispers()
 	return _whisperDispatcher.RegisterClient();
 }
 
-void TwitchChatConnection::SendChatMessage(const std::string &message)
+void TwitchChatConnection::SendChatMessage(const std::string &message,
+					   ChatMessageQueue::Priority priority,
+					   bool merge)
 {
 	ConnectToChat();
-	Send("PRIVMSG " + _joinedChannelName + " :" + message);
+	{
+		std::lock_guard<std::mutex> lock(_sendQueueMtx);
+		_sendQueue.Push("#" + toLowerCase(_channel.GetName()), message,
+				priority, merge);
+	}
+	_sendQueueCv.notify_all();
+}
+
+size_t TwitchChatConnection::GetQueuedMessageCount()
+{
+	std::lock_guard<std::mutex> lock(_sendQueueMtx);
+	return _sendQueue.Size();
+}
+
+uint64_t TwitchChatConnection::GetDroppedMessageCount()
+{
+	std::lock_guard<std::mutex> lock(_sendQueueMtx);
+	return _sendQueue.DroppedCount();
+}
+
+void TwitchChatConnection::SendThread()
+{
+	std::unique_lock<std::mutex> lock(_sendQueueMtx);
+	while (!_stopSending) {
+		// Messages are kept queued until the channel was joined
+		const auto next = _sendQueue.NextSendTime();
+		if (!next || !_joined) {
+			_sendQueueCv.wait(lock);
+			continue;
+		}
+		if (*next > ChatMessageQueue::Clock::now()) {
+			_sendQueueCv.wait_until(lock, *next);
+			continue;
+		}
+
+		auto message = _sendQueue.Pop();
+		if (!message) {
+			continue;
+		}
+		lock.unlock();
+		Send("PRIVMSG " + message->channel + " :" + message->text);
+		lock.lock();
+	}
 }
 
 void TwitchChatConnection::Authenticate()
@@ -471,6 +526,28 @@ void TwitchChatConnection::HandleJoin(const IRCMessage &message)
 {
 	_joinedChannelName = std::get<std::string>(message.command.parameters);
 	vblog(LOG_INFO, "Twitch chat join was successful!");
+	{
+		std::lock_guard<std::mutex> lock(_sendQueueMtx);
+		_joined = true;
+	}
+	_sendQueueCv.notify_all();
+}
+
+void TwitchChatConnection::HandleUserState(const IRCMessage &message)
+{
+	// Moderators and the broadcaster are allowed to send more messages
+	bool isPrivileged = message.properties.isMod;
+	for (const auto &badge : message.properties.badges) {
+		if (badge.enabled && (badge.name == "broadcaster" ||
+				      badge.name == "moderator")) {
+			isPrivileged = true;
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(_sendQueueMtx);
+	_sendQueue.SetLimits(isPrivileged
+				     ? ChatMessageQueue::moderatorLimits
+				     : ChatMessageQueue::regularUserLimits);
 }
 
 void TwitchChatConnection::HandleNewMessage(const IRCMessage &message)
@@ -539,6 +616,7 @@ void TwitchChatConnection::OnMessage(
 	static constexpr std::string_view reconnectCommand = "RECONNECT";
 	static constexpr std::string_view newMessageCommand = "PRIVMSG";
 	static constexpr std::string_view whisperCommand = "WHISPER";
+	static constexpr std::string_view userStateCommand = "USERSTATE";
 
 	if (!message) {
 		return;
@@ -569,6 +647,8 @@ void TwitchChatConnection::OnMessage(
 			HandleNotice(message);
 		} else if (message.command.command == reconnectCommand) {
 			HandleReconnect();
+		} else if (message.command.command == userStateCommand) {
+			HandleUserState(message);
 		}
 	}
 }
@@ -579,6 +659,7 @@ void TwitchChatConnection::OnClose(connection_hdl hdl)
 		con = _client.get_con_from_hdl(hdl);
 	auto msg = con->get_ec().message();
 	blog(LOG_INFO, "Twitch chat connection closed: %s", msg.c_str());
+	_joined = false;
 }
 
 void TwitchChatConnection::OnFail(connection_hdl hdl)
@@ -587,6 +668,7 @@ void TwitchChatConnection::OnFail(connection_hdl hdl)
 		con = _client.get_con_from_hdl(hdl);
 	auto msg = con->get_ec().message();
 	blog(LOG_INFO, "Twitch chat connection failed: %s", msg.c_str());
+	_joined = false;
 }
 
 void TwitchChatConnection::Send(const std::string &msg)
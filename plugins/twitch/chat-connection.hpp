@@ -1,5 +1,6 @@
 #pragma once
 #include "channel-selection.hpp"
+#include "chat-message-queue.hpp"
 #include "token.hpp"
 
 #include <condition_variable>
@@ -53,8 +54,14 @@ public:
 			  const TwitchChannel &channel);
 	[[nodiscard]] ChatMessageBuffer RegisterForMessages();
 	[[nodiscard]] ChatMessageBuffer RegisterForWhispers();
-	void SendChatMessage(const std::string &message);
+	// Messages are queued and sent as fast as Twitch's rate limits allow
+	void SendChatMessage(const std::string &message,
+			     ChatMessageQueue::Priority =
+				     ChatMessageQueue::Priority::NORMAL,
+			     bool merge = false);
 	void ConnectToChat();
+	size_t GetQueuedMessageCount();
+	uint64_t GetDroppedMessageCount();
 
 private:
 	TwitchChatConnection(const TwitchToken &token,
@@ -72,6 +79,7 @@ private:
 	void OnFail(connection_hdl hdl);
 	void Send(const std::string &msg);
 	void ConnectThread();
+	void SendThread();
 
 	void Authenticate();
 	void JoinChannel(const std::string &);
@@ -79,6 +87,7 @@ private:
 	void HandleNewMessage(const IRCMessage &);
 	void HandleWhisper(const IRCMessage &);
 	void HandleNotice(const IRCMessage &) const;
+	void HandleUserState(const IRCMessage &);
 	void HandleReconnect();
 
 	struct ChatMapKey {
@@ -104,9 +113,16 @@ private:
 	std::atomic<State> _state = {State::DISCONNECTED};
 
 	std::atomic_bool _authenticated{false};
+	std::atomic_bool _joined{false};
 	std::atomic_bool _stop{false};
 	std::string _url;
 
+	ChatMessageQueue _sendQueue;
+	std::mutex _sendQueueMtx;
+	std::condition_variable _sendQueueCv;
+	bool _stopSending = false;
+	std::thread _sendThread;
+
 	ChatMessageDispatcher _messageDispatcher;
 	ChatMessageDispatcher _whisperDispatcher;
 };
@@ -0,0 +1,166 @@
+#include "chat-message-queue.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace advss {
+
+SendRateLimiter::SendRateLimiter(size_t limit,
+				 std::chrono::milliseconds period)
+	: _limit(std::max<size_t>(limit, 1)),
+	  _period(period)
+{
+}
+
+size_t SendRateLimiter::ActiveSends(Clock::time_point now) const
+{
+	const auto active = std::find_if(
+		_sendTimes.begin(), _sendTimes.end(),
+		[this, now](const Clock::time_point &sendTime) {
+			return sendTime + _period > now;
+		});
+	return std::distance(active, _sendTimes.end());
+}
+
+bool SendRateLimiter::TryTake(Clock::time_point now)
+{
+	while (!_sendTimes.empty() && _sendTimes.front() + _period <= now) {
+		_sendTimes.pop_front();
+	}
+	if (_sendTimes.size() >= _limit) {
+		return false;
+	}
+	_sendTimes.push_back(now);
+	return true;
+}
+
+SendRateLimiter::Clock::time_point
+SendRateLimiter::NextAvailable(Clock::time_point now) const
+{
+	if (ActiveSends(now) < _limit) {
+		return now;
+	}
+	// The window has room again once enough of the recent sends are older
+	// than the period
+	return _sendTimes[_sendTimes.size() - _limit] + _period;
+}
+
+void SendRateLimiter::SetLimits(size_t limit, std::chrono::milliseconds period)
+{
+	_limit = std::max<size_t>(limit, 1);
+	_period = period;
+}
+
+const ChatMessageQueue::Limits ChatMessageQueue::regularUserLimits = {
+	20, std::chrono::seconds(30)};
+const ChatMessageQueue::Limits ChatMessageQueue::moderatorLimits = {
+	100, std::chrono::seconds(30)};
+
+ChatMessageQueue::ChatMessageQueue(size_t maxSize, const Limits &limits)
+	: _maxSize(std::max<size_t>(maxSize, 1)),
+	  _rateLimiter(limits.messages, limits.period)
+{
+}
+
+std::deque<ChatMessageQueue::Message> &
+ChatMessageQueue::GetQueue(Priority priority)
+{
+	return _queues[static_cast<size_t>(priority)];
+}
+
+bool ChatMessageQueue::TryMerge(const std::string &channel,
+				const std::string &text, Priority priority)
+{
+	auto &queue = GetQueue(priority);
+	for (auto it = queue.rbegin(); it != queue.rend(); ++it) {
+		if (it->channel != channel || !it->mergeable) {
+			continue;
+		}
+		if (it->text.size() + 1 + text.size() > maxMergedLength) {
+			return false;
+		}
+		it->text += " " + text;
+		return true;
+	}
+	return false;
+}
+
+bool ChatMessageQueue::MakeRoom(Priority priority)
+{
+	if (Size() < _maxSize) {
+		return true;
+	}
+	for (size_t i = 0; i <= static_cast<size_t>(priority); i++) {
+		if (_queues[i].empty()) {
+			continue;
+		}
+		_queues[i].pop_front();
+		++_dropped;
+		return true;
+	}
+	++_dropped;
+	return false;
+}
+
+void ChatMessageQueue::Push(const std::string &channel,
+			    const std::string &text, Priority priority,
+			    bool merge)
+{
+	if (merge && TryMerge(channel, text, priority)) {
+		return;
+	}
+	if (!MakeRoom(priority)) {
+		return;
+	}
+	GetQueue(priority).push_back({channel, text, priority, merge});
+}
+
+std::optional<ChatMessageQueue::Message>
+ChatMessageQueue::Pop(Clock::time_point now)
+{
+	for (size_t i = priorityCount; i > 0; i--) {
+		auto &queue = _queues[i - 1];
+		if (queue.empty()) {
+			continue;
+		}
+		if (!_rateLimiter.TryTake(now)) {
+			return {};
+		}
+		auto message = std::move(queue.front());
+		queue.pop_front();
+		return message;
+	}
+	return {};
+}
+
+std::optional<ChatMessageQueue::Clock::time_point>
+ChatMessageQueue::NextSendTime(Clock::time_point now) const
+{
+	if (Empty()) {
+		return {};
+	}
+	return _rateLimiter.NextAvailable(now);
+}
+
+void ChatMessageQueue::SetLimits(const Limits &limits)
+{
+	_rateLimiter.SetLimits(limits.messages, limits.period);
+}
+
+size_t ChatMessageQueue::Size() const
+{
+	size_t size = 0;
+	for (const auto &queue : _queues) {
+		size += queue.size();
+	}
+	return size;
+}
+
+void ChatMessageQueue::Clear()
+{
+	for (auto &queue : _queues) {
+		queue.clear();
+	}
+}
+
+} // namespace advss
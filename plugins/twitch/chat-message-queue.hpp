@@ -0,0 +1,99 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+
+namespace advss {
+
+// Remembers the time of recent sends, so that at most "limit" sends happen
+// within any time window of length "period"
+class SendRateLimiter {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	SendRateLimiter(size_t limit, std::chrono::milliseconds period);
+
+	bool TryTake(Clock::time_point now = Clock::now());
+	// Returns the time at which the next send will be allowed
+	Clock::time_point NextAvailable(Clock::time_point now) const;
+	// Recent sends still count towards the new limit
+	void SetLimits(size_t limit, std::chrono::milliseconds period);
+
+private:
+	size_t ActiveSends(Clock::time_point now) const;
+
+	size_t _limit;
+	std::chrono::milliseconds _period;
+	std::deque<Clock::time_point> _sendTimes;
+};
+
+// Outbound queue for chat messages, which only releases messages as fast as
+// the rate limits of Twitch's IRC interface allow.
+// Messages of higher priority are sent first.
+//
+// Not thread safe - access has to be synchronized by the owner.
+class ChatMessageQueue {
+public:
+	using Clock = SendRateLimiter::Clock;
+
+	enum class Priority {
+		LOW,
+		NORMAL,
+		HIGH,
+	};
+
+	struct Limits {
+		size_t messages;
+		std::chrono::milliseconds period;
+	};
+	static const Limits regularUserLimits;
+	// Moderators and broadcasters are allowed to send more messages
+	static const Limits moderatorLimits;
+
+	struct Message {
+		std::string channel;
+		std::string text;
+		Priority priority = Priority::NORMAL;
+		bool mergeable = false;
+	};
+
+	ChatMessageQueue(size_t maxSize, const Limits &);
+
+	// If "merge" is set and a mergeable message of the same priority is
+	// already queued for the channel, the text is appended to it instead of
+	// queuing a new message.
+	// If the queue is full the oldest message of the lowest priority is
+	// dropped, unless the new message has a lower priority than all queued
+	// messages, in which case the new message is dropped.
+	void Push(const std::string &channel, const std::string &text,
+		  Priority = Priority::NORMAL, bool merge = false);
+	// Returns a message if one is queued and the rate limit allows sending
+	std::optional<Message> Pop(Clock::time_point now = Clock::now());
+	// Returns the time at which the next message can be sent or nothing if
+	// the queue is empty
+	std::optional<Clock::time_point>
+	NextSendTime(Clock::time_point now = Clock::now()) const;
+	void SetLimits(const Limits &);
+	size_t Size() const;
+	bool Empty() const { return Size() == 0; }
+	uint64_t DroppedCount() const { return _dropped; }
+	void Clear();
+
+private:
+	static constexpr size_t maxMergedLength = 500;
+	static constexpr size_t priorityCount = 3;
+
+	std::deque<Message> &GetQueue(Priority);
+	bool TryMerge(const std::string &channel, const std::string &text,
+		      Priority);
+	bool MakeRoom(Priority);
+
+	const size_t _maxSize;
+	SendRateLimiter _rateLimiter;
+	std::deque<Message> _queues[priorityCount];
+	uint64_t _dropped = 0;
+};
+
+} // namespace advss
@@ -0,0 +1,76 @@
+#include "event-sub-session.hpp"
+
+namespace advss {
+
+static bool isSameConnection(const EventSubSession::Handle &a,
+			     const EventSubSession::Handle &b)
+{
+	return !a.owner_before(b) && !b.owner_before(a);
+}
+
+EventSubSession::EventSubSession(std::chrono::milliseconds messageIDWindow,
+				 size_t maxMessageIDs)
+	: _messageIDs(messageIDWindow, maxMessageIDs)
+{
+}
+
+void EventSubSession::Connect(const Handle &hdl)
+{
+	_current = hdl;
+	_pending.reset();
+}
+
+void EventSubSession::Reconnect(const Handle &hdl)
+{
+	_pending = hdl;
+}
+
+std::optional<EventSubSession::Handle>
+EventSubSession::Welcome(const Handle &hdl)
+{
+	if (!IsPending(hdl)) {
+		return {};
+	}
+	auto previous = _current;
+	_current = hdl;
+	_pending.reset();
+	return previous;
+}
+
+EventSubSession::CloseResult EventSubSession::Close(const Handle &hdl)
+{
+	if (IsPending(hdl)) {
+		_pending.reset();
+		return CloseResult::RECONNECT_FAILED;
+	}
+	if (!IsCurrent(hdl)) {
+		return CloseResult::IGNORED;
+	}
+	if (_pending.expired()) {
+		return CloseResult::CLOSED;
+	}
+
+	// Twitch closed the previous connection before the new one was
+	// welcomed, which will happen on the pending connection
+	_current = _pending;
+	_pending.reset();
+	return CloseResult::HANDED_OFF;
+}
+
+bool EventSubSession::AcceptMessage(const std::string &id,
+				    Clock::time_point now)
+{
+	return _messageIDs.Insert(id, now);
+}
+
+bool EventSubSession::IsCurrent(const Handle &hdl) const
+{
+	return isSameConnection(hdl, _current);
+}
+
+bool EventSubSession::IsPending(const Handle &hdl) const
+{
+	return !_pending.expired() && isSameConnection(hdl, _pending);
+}
+
+} // namespace advss
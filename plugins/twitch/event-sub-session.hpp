@@ -0,0 +1,65 @@
+#pragma once
+#include "duplicate-filter.hpp"
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace advss {
+
+// Keeps track of the connections of an EventSub session.
+// When Twitch requests a reconnect, the connection to the reconnect URL stays
+// pending until it was welcomed, while the current connection keeps receiving
+// notifications. Only then the previous connection is closed.
+// Notifications which are delivered on both connections are only accepted
+// once.
+//
+// Not thread safe - access has to be synchronized by the owner.
+class EventSubSession {
+public:
+	// Same as websocketpp::connection_hdl
+	using Handle = std::weak_ptr<void>;
+	using Clock = DuplicateFilter::Clock;
+
+	enum class CloseResult {
+		// Connection of a previous session
+		IGNORED,
+		// The connection to the reconnect URL closed before it was
+		// welcomed, so the current connection stays in use
+		RECONNECT_FAILED,
+		// The pending connection took over the session
+		HANDED_OFF,
+		// The session ended
+		CLOSED,
+	};
+
+	EventSubSession(std::chrono::milliseconds messageIDWindow,
+			size_t maxMessageIDs);
+
+	// Starts a new session on the given connection
+	void Connect(const Handle &);
+	// Connection to the reconnect URL of a session_reconnect message
+	void Reconnect(const Handle &);
+	// Returns the previous connection, which has to be closed, if the
+	// welcome message was received on the pending connection
+	std::optional<Handle> Welcome(const Handle &);
+	// Has to be called if a connection was closed or failed
+	CloseResult Close(const Handle &);
+	// Returns false if the message was received already
+	bool AcceptMessage(const std::string &id,
+			   Clock::time_point now = Clock::now());
+
+	const Handle &Current() const { return _current; }
+	const Handle &Pending() const { return _pending; }
+	bool IsCurrent(const Handle &) const;
+	bool IsPending(const Handle &) const;
+
+private:
+	Handle _current;
+	// Not yet welcomed connection to the reconnect URL
+	Handle _pending;
+	DuplicateFilter _messageIDs;
+};
+
+} // namespace advss
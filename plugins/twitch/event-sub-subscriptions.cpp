@@ -0,0 +1,136 @@
+#include "event-sub-subscriptions.hpp"
+
+namespace advss {
+
+EventSubSubscription::EventSubSubscription(const std::string &key) : _key(key)
+{
+}
+
+std::shared_ptr<EventSubSubscription>
+EventSubSubscriptionRegistry::Request(const std::string &key)
+{
+	auto &weakSubscription = _subscriptions[key];
+	auto result = weakSubscription.lock();
+	if (result) {
+		return result;
+	}
+	result = std::make_shared<EventSubSubscription>(key);
+	weakSubscription = result;
+	return result;
+}
+
+std::vector<std::shared_ptr<EventSubSubscription>>
+EventSubSubscriptionRegistry::TakePending(size_t maxCount)
+{
+	std::vector<std::shared_ptr<EventSubSubscription>> result;
+	if (_costLimitReached) {
+		return result;
+	}
+
+	for (auto it = _subscriptions.begin(); it != _subscriptions.end();) {
+		auto subscription = it->second.lock();
+		if (!subscription) {
+			it = _subscriptions.erase(it);
+			continue;
+		}
+		++it;
+		if (subscription->_state !=
+		    EventSubSubscription::State::PENDING) {
+			continue;
+		}
+		subscription->_state = EventSubSubscription::State::REGISTERING;
+		result.emplace_back(subscription);
+		if (result.size() >= maxCount) {
+			break;
+		}
+	}
+	return result;
+}
+
+bool EventSubSubscriptionRegistry::HandleResult(
+	EventSubSubscription &subscription,
+	const SubscriptionRegistrationResult &result)
+{
+	using State = EventSubSubscription::State;
+
+	// The session ended or the token changed in the meantime
+	if (subscription._state != State::REGISTERING) {
+		return true;
+	}
+
+	// Request failed or was rate limited
+	if (result.status == 0 || result.status == 429) {
+		subscription._state = State::PENDING;
+		return false;
+	}
+
+	if (result.status != 202) {
+		subscription._state = State::FAILED;
+		return true;
+	}
+
+	subscription._id = result.id;
+	_subscriptionKeys[result.id] = subscription._key;
+	subscription._state = State::ACTIVE;
+
+	if (result.maxTotalCost > 0 &&
+	    result.totalCost >= result.maxTotalCost) {
+		_costLimitReached = true;
+	}
+	return true;
+}
+
+void EventSubSubscriptionRegistry::Revoke(const std::string &id)
+{
+	auto it = _subscriptionKeys.find(id);
+	if (it == _subscriptionKeys.end()) {
+		return;
+	}
+	auto revoked = _subscriptions[it->second].lock();
+	if (revoked) {
+		revoked->_state = EventSubSubscription::State::FAILED;
+	}
+	_subscriptionKeys.erase(it);
+}
+
+std::optional<std::string>
+EventSubSubscriptionRegistry::GetKey(const std::string &id) const
+{
+	auto it = _subscriptionKeys.find(id);
+	if (it == _subscriptionKeys.end()) {
+		return {};
+	}
+	return it->second;
+}
+
+void EventSubSubscriptionRegistry::Reset()
+{
+	for (auto it = _subscriptions.begin(); it != _subscriptions.end();) {
+		auto subscription = it->second.lock();
+		if (!subscription) {
+			it = _subscriptions.erase(it);
+			continue;
+		}
+		subscription->_id.clear();
+		subscription->_state = EventSubSubscription::State::PENDING;
+		++it;
+	}
+	_subscriptionKeys.clear();
+	_costLimitReached = false;
+}
+
+void EventSubSubscriptionRegistry::Clear()
+{
+	for (const auto &[_, weakSubscription] : _subscriptions) {
+		auto subscription = weakSubscription.lock();
+		if (subscription) {
+			subscription->_state =
+				EventSubSubscription::State::EXPIRED;
+		}
+	}
+	_subscriptions.clear();
+	_subscriptionKeys.clear();
+	_costLimitReached = false;
+}
+
+} // namespace advss
@@ -0,0 +1,86 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace advss {
+
+// Handle to a subscription requested via EventSub::RequestSubscription().
+// The subscription stays requested as long as a handle to it exists.
+class EventSubSubscription {
+public:
+	enum class State {
+		PENDING,
+		REGISTERING,
+		ACTIVE,
+		// Registration was rejected or the subscription was revoked.
+		// It will be attempted again for the next session.
+		FAILED,
+		// The subscription is no longer managed, as the token changed,
+		// and has to be requested again
+		EXPIRED,
+	};
+
+	// The key is the JSON representation of the subscription data
+	explicit EventSubSubscription(const std::string &key);
+
+	const std::string &GetKey() const { return _key; }
+	State GetState() const { return _state; }
+	bool IsActive() const { return _state == State::ACTIVE; }
+	bool IsExpired() const { return _state == State::EXPIRED; }
+
+private:
+	const std::string _key;
+	// Only accessed by the owner of the registry
+	std::string _id;
+	std::atomic<State> _state{State::PENDING};
+
+	friend class EventSub;
+	friend class EventSubSubscriptionRegistry;
+};
+
+// Reply of Twitch to a subscription registration request
+struct SubscriptionRegistrationResult {
+	// HTTP status code or 0 if the request failed
+	int status = 0;
+	std::string id;
+	long long totalCost = 0;
+	long long maxTotalCost = 0;
+};
+
+// Keeps track of the requested subscriptions and their registration state for
+// the current EventSub session.
+//
+// Not thread safe - access has to be synchronized by the owner.
+class EventSubSubscriptionRegistry {
+public:
+	// Identical subscriptions share a single handle
+	std::shared_ptr<EventSubSubscription> Request(const std::string &key);
+	// Marks at most maxCount pending subscriptions as registering
+	std::vector<std::shared_ptr<EventSubSubscription>>
+	TakePending(size_t maxCount);
+	// Returns false if the registration should be retried
+	bool HandleResult(EventSubSubscription &,
+			  const SubscriptionRegistrationResult &);
+	void Revoke(const std::string &id);
+	std::optional<std::string> GetKey(const std::string &id) const;
+	bool CostLimitReached() const { return _costLimitReached; }
+	// Subscriptions have to be registered again for the next session
+	void Reset();
+	// Expires all subscription handles
+	void Clear();
+
+private:
+	// Requested subscriptions by key
+	std::unordered_map<std::string, std::weak_ptr<EventSubSubscription>>
+		_subscriptions;
+	// Keys of the registered subscriptions by subscription ID
+	std::unordered_map<std::string, std::string> _subscriptionKeys;
+	bool _costLimitReached = false;
+};
+
+} // namespace advss
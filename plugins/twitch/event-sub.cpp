@@ -4,6 +4,8 @@
 
 #include <log-helper.hpp>
 
+#include <future>
+
 namespace advss {
 
 using websocketpp::lib::placeholders::_1;
@@ -25,10 +27,19 @@ static constexpr std::string_view registerSubscriptionPath =
 	"/helix/eventsub/subscriptions";
 #endif
 static const int reconnectDelay = 15;
+// Twitch may resend messages and recommends to discard messages older than
+// 10 minutes, so message IDs only have to be remembered for that long
+static constexpr auto messageIDWindow = std::chrono::minutes(10);
+static constexpr size_t maxMessageIDs = 10000;
+static constexpr size_t maxConcurrentRegistrations = 4;
+static constexpr auto registrationRetryDelay = std::chrono::seconds(5);
+static constexpr size_t maxUnroutedEvents = 100;
 
 #undef DispatchMessage
 
-EventSub::EventSub() : QObject(nullptr)
+EventSub::EventSub()
+	: QObject(nullptr),
+	  _session(messageIDWindow, maxMessageIDs)
 {
 	_client.get_alog().clear_channels(
 		websocketpp::log::alevel::frame_header |
@@ -89,8 +100,12 @@ void EventSub::ConnectThread()
 			blog(LOG_INFO, "Twitch EventSub failed: %s",
 			     ec.message().c_str());
 		} else {
+			{
+				std::lock_guard<std::mutex> conLock(
+					_connectionMtx);
+				_session.Connect(connection_hdl(con));
+			}
 			_client.connect(con);
-			_connection = connection_hdl(con);
 			_client.run();
 		}
 
@@ -102,6 +117,18 @@ void EventSub::ConnectThread()
 	_connected = false;
 }
 
+void EventSub::CloseConnections(const std::string &reason)
+{
+	std::lock_guard<std::mutex> lock(_connectionMtx);
+	websocketpp::lib::error_code ec;
+	_client.close(_session.Current(), websocketpp::close::status::normal,
+		      reason, ec);
+	if (!_session.Pending().expired()) {
+		_client.close(_session.Pending(),
+			      websocketpp::close::status::normal, reason, ec);
+	}
+}
+
 void EventSub::Connect()
 {
 	std::lock_guard<std::mutex> lock(_connectMtx);
@@ -120,16 +147,31 @@ void EventSub::Connect()
 void EventSub::ClearActiveSubscriptions()
 {
 	std::lock_guard<std::mutex> lock(_subscriptionMtx);
-	_activeSubscriptions.clear();
+	_registrationToken.clear();
+	_subscriptions.Clear();
+	_unroutedEvents.clear();
+}
+
+void EventSub::ResetSubscriptions()
+{
+	std::lock_guard<std::mutex> lock(_subscriptionMtx);
+	_sessionID.clear();
+	_subscriptions.Reset();
+	_unroutedEvents.clear();
+}
+
+void EventSub::SetSessionID(const std::string &id)
+{
+	std::lock_guard<std::mutex> lock(_subscriptionMtx);
+	_sessionID = id;
+	StartSubscriptionRegistration();
 }
 
 void EventSub::Disconnect()
 {
 	std::lock_guard<std::mutex> lock(_connectMtx);
 	_disconnect = true;
-	websocketpp::lib::error_code ec;
-	_client.close(_connection, websocketpp::close::status::normal,
-		      "Twitch EventSub stopping", ec);
+	CloseConnections("Twitch EventSub stopping");
 	{
 		std::unique_lock<std::mutex> waitLock(_waitMtx);
 		_cv.notify_all();
@@ -137,15 +179,15 @@ void EventSub::Disconnect()
 
 	while (_connected) {
 		std::this_thread::sleep_for(std::chrono::milliseconds(10));
-		_client.close(_connection, websocketpp::close::status::normal,
-			      "Twitch EventSub stopping", ec);
+		CloseConnections("Twitch EventSub stopping");
 	}
 
 	if (_thread.joinable()) {
 		_thread.join();
 	}
 	_connected = false;
-	ClearActiveSubscriptions();
+	StopSubscriptionRegistration();
+	ResetSubscriptions();
 }
 
 EventSubMessageBuffer EventSub::RegisterForEvents()
@@ -153,21 +195,10 @@ EventSubMessageBuffer EventSub::RegisterForEvents()
 	return _dispatcher.RegisterClient();
 }
 
-bool EventSub::SubscriptionIsActive(const std::string &id)
+EventSubMessageBuffer
+EventSub::RegisterForEvents(const std::string &subscriptionKey)
 {
-	std::lock_guard<std::mutex> lock(_subscriptionMtx);
-	for (const auto &subscription : _activeSubscriptions) {
-		if (subscription.id == id) {
-			return true;
-		}
-	}
-	return false;
-}
-
-static bool isAlreadySubscribed(const std::set<Subscription> &subscriptions,
-				const Subscription &newSubsciption)
-{
-	return subscriptions.find(newSubsciption) != subscriptions.end();
+	return _dispatcher.RegisterClient(subscriptionKey);
 }
 
 static void setTransportData(const OBSData &data, const std::string &sessionID)
@@ -178,55 +209,165 @@ static void setTransportData(const OBSData &data, const std::string &sessionID)
 	obs_data_set_obj(data, "transport", transport);
 }
 
-static obs_data_t *copyData(const OBSData &data)
-{
-	auto json = obs_data_get_json(data);
-	if (!json) {
-		return nullptr;
-	}
-	return obs_data_create_from_json(json);
-}
-
-std::string EventSub::AddEventSubscribtion(std::shared_ptr<TwitchToken> token,
-					   Subscription subscription)
+std::shared_ptr<EventSubSubscription>
+EventSub::RequestSubscription(const std::shared_ptr<TwitchToken> &token,
+			      const Subscription &subscription)
 {
 	auto eventSub = token->GetEventSub();
 	if (!eventSub) {
 		blog(LOG_WARNING, "failed to get Twitch EventSub from token!");
-		return "";
+		return {};
 	}
 
+	auto json = obs_data_get_json(subscription.data);
+	const std::string key = json ? json : "";
+	const auto tokenValue = token->GetToken();
+
 	std::lock_guard<std::mutex> lock(eventSub->_subscriptionMtx);
+	eventSub->_registrationToken = tokenValue.value_or("");
+	auto result = eventSub->_subscriptions.Request(key);
+
 	if (!eventSub->_connected) {
 		std::thread t([eventSub]() { eventSub->Connect(); });
 		t.detach();
 		vblog(LOG_INFO, "Twitch EventSub connect started for %s",
 		      token->GetName().c_str());
-		return "";
 	}
+	eventSub->StartSubscriptionRegistration();
+	return result;
+}
+
+void EventSub::StartSubscriptionRegistration()
+{
+	if (_registrationActive || _disconnect || _sessionID.empty() ||
+	    _registrationToken.empty() || _subscriptions.CostLimitReached()) {
+		return;
+	}
+
+	// The previous registration thread is done at this point
+	if (_registrationThread.joinable()) {
+		_registrationThread.join();
+	}
+	_registrationActive = true;
+	_registrationThread =
+		std::thread(&EventSub::RegisterPendingSubscriptions, this);
+}
+
+void EventSub::StopSubscriptionRegistration()
+{
+	{
+		std::lock_guard<std::mutex> lock(_subscriptionMtx);
+		_registrationCv.notify_all();
+	}
+	if (_registrationThread.joinable()) {
+		_registrationThread.join();
+	}
+}
+
+void EventSub::RegisterPendingSubscriptions()
+{
+	std::unique_lock<std::mutex> lock(_subscriptionMtx);
+	while (!_disconnect && !_sessionID.empty()) {
+		auto subscriptions =
+			_subscriptions.TakePending(maxConcurrentRegistrations);
+		if (subscriptions.empty()) {
+			break;
+		}
+
+		std::vector<OBSData> requests;
+		for (const auto &subscription : subscriptions) {
+			OBSDataAutoRelease postData = obs_data_create_from_json(
+				subscription->GetKey().c_str());
+			setTransportData(postData.Get(), _sessionID);
+			requests.emplace_back(postData.Get());
+		}
+		const auto token = _registrationToken;
+		lock.unlock();
+
+		std::vector<std::future<RequestResult>> futures;
+		for (const auto &postData : requests) {
+			futures.emplace_back(std::async(
+				std::launch::async, [&token, postData]() {
+					return SendPostRequest(
+						token,
+						registerSubscriptionURL.data(),
+						registerSubscriptionPath.data(),
+						{}, postData);
+				}));
+		}
+		std::vector<RequestResult> results;
+		for (auto &future : futures) {
+			results.emplace_back(future.get());
+		}
+
+		lock.lock();
+		bool retry = false;
+		for (size_t i = 0; i < subscriptions.size(); i++) {
+			if (!HandleRegistrationResult(*subscriptions[i],
+						      results[i])) {
+				retry = true;
+			}
+		}
+		if (retry) {
+			_registrationCv.wait_for(
+				lock, registrationRetryDelay,
+				[this]() { return _disconnect.load(); });
+		}
+	}
+	_registrationActive = false;
+}
 
-	if (isAlreadySubscribed(eventSub->_activeSubscriptions, subscription)) {
-		return eventSub->_activeSubscriptions.find(subscription)->id;
+void EventSub::DispatchUnroutedEvents(const EventSubSubscription &subscription)
+{
+	const auto &id = subscription._id;
+	for (auto it = _unroutedEvents.begin(); it != _unroutedEvents.end();) {
+		if (it->id != id) {
+			++it;
+			continue;
+		}
+		_dispatcher.DispatchMessageToKey(*it, subscription._key);
+		it = _unroutedEvents.erase(it);
 	}
+}
 
-	OBSDataAutoRelease postData = copyData(subscription.data);
-	setTransportData(postData.Get(), eventSub->_sessionID);
-	auto result = SendPostRequest(*token, registerSubscriptionURL.data(),
-				      registerSubscriptionPath.data(), {},
-				      postData.Get());
+bool EventSub::HandleRegistrationResult(EventSubSubscription &subscription,
+					const RequestResult &result)
+{
+	SubscriptionRegistrationResult registration;
+	registration.status = result.status;
+	if (result.status == 202) {
+		OBSDataArrayAutoRelease replyArray =
+			obs_data_get_array(result.data, "data");
+		OBSDataAutoRelease replyData =
+			obs_data_array_item(replyArray, 0);
+		registration.id = obs_data_get_string(replyData, "id");
+		registration.totalCost =
+			obs_data_get_int(result.data, "total_cost");
+		registration.maxTotalCost =
+			obs_data_get_int(result.data, "max_total_cost");
+	}
 
-	if (result.status != 202) {
-		vblog(LOG_INFO, "failed to register Twitch EventSub (%d)",
+	const bool costLimitReached = _subscriptions.CostLimitReached();
+	if (!_subscriptions.HandleResult(subscription, registration)) {
+		vblog(LOG_INFO, "retrying Twitch EventSub registration (%d)",
 		      result.status);
-		return "";
+		return false;
 	}
 
-	OBSDataArrayAutoRelease replyArray =
-		obs_data_get_array(result.data, "data");
-	OBSDataAutoRelease replyData = obs_data_array_item(replyArray, 0);
-	subscription.id = obs_data_get_string(replyData, "id");
-	eventSub->_activeSubscriptions.emplace(subscription);
-	return subscription.id;
+	if (subscription.GetState() == EventSubSubscription::State::FAILED) {
+		blog(LOG_WARNING, "failed to register Twitch EventSub (%d)",
+		     result.status);
+		return true;
+	}
+	if (subscription.IsActive()) {
+		DispatchUnroutedEvents(subscription);
+	}
+	if (!costLimitReached && _subscriptions.CostLimitReached()) {
+		blog(LOG_WARNING,
+		     "Twitch EventSub subscription cost limit reached (%lld)",
+		     registration.maxTotalCost);
+	}
+	return true;
 }
 
 void EventSub::OnOpen(connection_hdl)
@@ -250,23 +391,18 @@ static bool isValidTimestamp(const std::string &timestamp)
 
 bool EventSub::IsValidMessageID(const std::string &id)
 {
-	auto it = std::find(_messageIDs.begin(), _messageIDs.end(), id);
-	if (it != _messageIDs.end()) {
-		return false;
-	}
-	if (!_messageIDs.empty()) {
-		_messageIDs.pop_front();
-	}
-	_messageIDs.push_back(id);
-	return true;
+	std::lock_guard<std::mutex> lock(_connectionMtx);
+	return _session.AcceptMessage(id);
 }
 
 bool EventSub::IsValidID(const std::string &id)
 {
+	std::lock_guard<std::mutex> lock(_subscriptionMtx);
 	return !_sessionID.empty() && id == _sessionID;
 }
 
-void EventSub::OnMessage(connection_hdl, EventSubWSClient::message_ptr message)
+void EventSub::OnMessage(connection_hdl hdl,
+			 EventSubWSClient::message_ptr message)
 {
 	if (!message) {
 		return;
@@ -300,7 +436,7 @@ void EventSub::OnMessage(connection_hdl, EventSubWSClient::message_ptr message)
 	std::string messageType = obs_data_get_string(metadata, "message_type");
 	OBSDataAutoRelease payloadJson = obs_data_get_obj(json, "payload");
 	if (messageType == "session_welcome") {
-		HandleWelcome(payloadJson);
+		HandleWelcome(hdl, payloadJson);
 	} else if (messageType == "session_keepalive") {
 		HandleKeepAlive();
 	} else if (messageType == "notification") {
@@ -315,11 +451,27 @@ void EventSub::OnMessage(connection_hdl, EventSubWSClient::message_ptr message)
 	}
 }
 
-void EventSub::HandleWelcome(obs_data_t *data)
+void EventSub::HandleWelcome(connection_hdl hdl, obs_data_t *data)
 {
 	OBSDataAutoRelease session = obs_data_get_obj(data, "session");
-	_sessionID = obs_data_get_string(session, "id");
-	blog(LOG_INFO, "Twitch EventSub connected");
+	SetSessionID(obs_data_get_string(session, "id"));
+
+	std::optional<connection_hdl> previousConnection;
+	{
+		std::lock_guard<std::mutex> lock(_connectionMtx);
+		previousConnection = _session.Welcome(hdl);
+	}
+	if (!previousConnection) {
+		blog(LOG_INFO, "Twitch EventSub connected");
+		return;
+	}
+
+	// The new session is ready to receive notifications, so the previous
+	// connection is no longer needed
+	websocketpp::lib::error_code ec;
+	_client.close(*previousConnection, websocketpp::close::status::normal,
+		      "Twitch EventSub reconnected", ec);
+	blog(LOG_INFO, "Twitch EventSub reconnected");
 }
 
 void EventSub::HandleKeepAlive() const
@@ -336,7 +488,22 @@ void EventSub::HandleNotification(obs_data_t *data)
 	event.type = obs_data_get_string(subscription, "type");
 	OBSDataAutoRelease eventData = obs_data_get_obj(data, "event");
 	event.data = eventData;
-	_dispatcher.DispatchMessage(event);
+
+	std::unique_lock<std::mutex> lock(_subscriptionMtx);
+	const auto key = _subscriptions.GetKey(event.id);
+	if (!key) {
+		// The reply to the registration request might not have been
+		// processed yet, so keep the event until the key is known
+		_unroutedEvents.push_back(event);
+		if (_unroutedEvents.size() > maxUnroutedEvents) {
+			_unroutedEvents.pop_front();
+		}
+		lock.unlock();
+		_dispatcher.DispatchMessage(event);
+		return;
+	}
+	lock.unlock();
+	_dispatcher.DispatchMessage(event, *key);
 }
 
 void EventSub::HandleReconnect(obs_data_t *data)
@@ -348,10 +515,24 @@ void EventSub::HandleReconnect(obs_data_t *data)
 		      "ignoring Twitch EventSub reconnect message with invalid id");
 		return;
 	}
-	_url = obs_data_get_string(session, "reconnect_url");
+	std::string url = obs_data_get_string(session, "reconnect_url");
+
+	// Keep the current connection open until the new session was welcomed
+	// to not lose any notifications sent in the meantime.
+	// Subscriptions are carried over to the new session by Twitch.
 	websocketpp::lib::error_code ec;
-	_client.close(_connection, websocketpp::close::status::normal,
-		      "Twitch EventSub reconnecting", ec);
+	EventSubWSClient::connection_ptr con = _client.get_connection(url, ec);
+	if (ec) {
+		blog(LOG_WARNING, "Twitch EventSub reconnect failed: %s",
+		     ec.message().c_str());
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(_connectionMtx);
+		_session.Reconnect(connection_hdl(con));
+	}
+	_client.connect(con);
+	vblog(LOG_INFO, "Twitch EventSub reconnecting to new session");
 }
 
 void EventSub::HanldeRevocation(obs_data_t *data)
@@ -375,41 +556,53 @@ void EventSub::HanldeRevocation(obs_data_t *data)
 	     id, status, type, version, conditionJson ? conditionJson : "");
 
 	std::lock_guard<std::mutex> lock(_subscriptionMtx);
-	for (auto it = _activeSubscriptions.begin();
-	     it != _activeSubscriptions.begin();) {
-		if (it->id == id) {
-			it = _activeSubscriptions.erase(it);
-		} else {
-			++it;
-		}
-	}
+	_subscriptions.Revoke(id);
 }
 
 void EventSub::OnClose(connection_hdl hdl)
 {
 	EventSubWSClient::connection_ptr con = _client.get_con_from_hdl(hdl);
-	auto msg = con->get_ec().message();
-	blog(LOG_INFO, "Twitch EventSub connection closed: %s", msg.c_str());
-	ClearActiveSubscriptions();
-	_connected = false;
+	HandleConnectionEnd(hdl, "closed", con->get_ec().message());
 }
 
 void EventSub::OnFail(connection_hdl hdl)
 {
 	EventSubWSClient::connection_ptr con = _client.get_con_from_hdl(hdl);
-	auto msg = con->get_ec().message();
-	blog(LOG_INFO, "Twitch EventSub connection failed: %s", msg.c_str());
-	ClearActiveSubscriptions();
-	_connected = false;
+	HandleConnectionEnd(hdl, "failed", con->get_ec().message());
 }
 
-bool Subscription::operator<(const Subscription &other) const
+void EventSub::HandleConnectionEnd(connection_hdl hdl, const char *reason,
+				   const std::string &msg)
 {
-	auto json = obs_data_get_json(data);
-	std::string jsonString = json ? json : "";
-	auto otherJson = obs_data_get_json(other.data);
-	std::string otherJsonString = otherJson ? otherJson : "";
-	return jsonString < otherJsonString;
+	using CloseResult = EventSubSession::CloseResult;
+
+	CloseResult result;
+	{
+		std::lock_guard<std::mutex> lock(_connectionMtx);
+		result = _session.Close(hdl);
+	}
+	switch (result) {
+	case CloseResult::IGNORED:
+		vblog(LOG_INFO, "previous Twitch EventSub connection %s: %s",
+		      reason, msg.c_str());
+		return;
+	case CloseResult::RECONNECT_FAILED:
+		// Keep using the current session until Twitch closes it
+		blog(LOG_INFO, "Twitch EventSub reconnect %s: %s", reason,
+		     msg.c_str());
+		return;
+	case CloseResult::HANDED_OFF:
+		blog(LOG_INFO,
+		     "Twitch EventSub connection %s during reconnect: %s",
+		     reason, msg.c_str());
+		return;
+	case CloseResult::CLOSED:
+		break;
+	}
+	blog(LOG_INFO, "Twitch EventSub connection %s: %s", reason,
+	     msg.c_str());
+	ResetSubscriptions();
+	_connected = false;
 }
 
 std::string Event::ToString() const
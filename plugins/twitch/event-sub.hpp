@@ -1,12 +1,15 @@
 #pragma once
+#include "event-sub-session.hpp"
+#include "event-sub-subscriptions.hpp"
 #include "message-dispatcher.hpp"
 
 #include <obs.hpp>
 #include <websocketpp/client.hpp>
 #include <QObject>
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
-#include <set>
+#include <deque>
 
 #ifdef USE_TWITCH_CLI_MOCK
 #include <websocketpp/config/asio_no_tls_client.hpp>
@@ -26,6 +29,7 @@ typedef websocketpp::client<websocketpp::config::asio_tls_client>
 #endif
 
 struct Event;
+struct RequestResult;
 class TwitchToken;
 
 using websocketpp::connection_hdl;
@@ -43,7 +47,6 @@ struct Event {
 struct Subscription {
 	OBSData data;
 	std::string id;
-	bool operator<(const Subscription &) const;
 };
 
 class EventSub : public QObject {
@@ -54,9 +57,16 @@ public:
 	void Connect();
 	void Disconnect();
 	[[nodiscard]] EventSubMessageBuffer RegisterForEvents();
-	bool SubscriptionIsActive(const std::string &id);
-	static std::string AddEventSubscribtion(std::shared_ptr<TwitchToken>,
-						Subscription);
+	// Only receives events of the subscription with the given key
+	[[nodiscard]] EventSubMessageBuffer
+	RegisterForEvents(const std::string &subscriptionKey);
+	// Identical subscriptions share a single handle and are only registered
+	// once. Registration happens in the background as soon as a session is
+	// established and is repeated whenever a new session is started.
+	[[nodiscard]] static std::shared_ptr<EventSubSubscription>
+	RequestSubscription(const std::shared_ptr<TwitchToken> &,
+			    const Subscription &);
+	// Expires all subscription handles
 	void ClearActiveSubscriptions();
 
 private:
@@ -66,11 +76,14 @@ private:
 	void OnClose(connection_hdl hdl);
 	void OnFail(connection_hdl hdl);
 	void ConnectThread();
+	void HandleConnectionEnd(connection_hdl, const char *reason,
+				 const std::string &msg);
+	void CloseConnections(const std::string &reason);
 
 	bool IsValidMessageID(const std::string &);
 	bool IsValidID(const std::string &);
 
-	void HandleWelcome(obs_data_t *);
+	void HandleWelcome(connection_hdl, obs_data_t *);
 	void HandleKeepAlive() const;
 	void HandleNotification(obs_data_t *);
 	void HandleReconnect(obs_data_t *);
@@ -79,8 +92,23 @@ private:
 	void RegisterInstance();
 	void UnregisterInstance();
 
+	void SetSessionID(const std::string &);
+	// Subscriptions have to be registered again for the next session
+	void ResetSubscriptions();
+	// Has to be called with _subscriptionMtx locked
+	void StartSubscriptionRegistration();
+	void StopSubscriptionRegistration();
+	void RegisterPendingSubscriptions();
+	// Has to be called with _subscriptionMtx locked.
+	// Returns false if the registration should be retried.
+	bool HandleRegistrationResult(EventSubSubscription &,
+				      const RequestResult &);
+	// Has to be called with _subscriptionMtx locked
+	void DispatchUnroutedEvents(const EventSubSubscription &);
+
 	EventSubWSClient _client;
-	connection_hdl _connection;
+	EventSubSession _session;
+	std::mutex _connectionMtx;
 	std::thread _thread;
 	std::mutex _waitMtx;
 	std::mutex _connectMtx;
@@ -90,9 +118,17 @@ private:
 	std::string _url;
 	std::string _sessionID;
 
-	std::deque<std::string> _messageIDs;
 	std::mutex _subscriptionMtx;
-	std::set<Subscription> _activeSubscriptions;
+	// Token value used for the registration requests, so the registration
+	// thread never has to keep the token alive
+	std::string _registrationToken;
+	EventSubSubscriptionRegistry _subscriptions;
+	// Events of subscriptions whose registration reply was not processed
+	std::deque<Event> _unroutedEvents;
+	bool _registrationActive = false;
+	std::thread _registrationThread;
+	// Interrupts waiting for the next registration attempt on disconnect
+	std::condition_variable _registrationCv;
 	static std::mutex _instancesMtx;
 	static std::vector<EventSub *> _instances;
 	EventSubMessageDispatcher _dispatcher;
@@ -258,10 +258,20 @@ void MacroActionTwitch::SendChatMessage(
 	if (!_chatConnection) {
 		_chatConnection = TwitchChatConnection::GetChatConnection(
 			*token, _channel);
+	}
+	if (!_chatConnection) {
 		return;
 	}
 
-	_chatConnection->SendChatMessage(_chatMessage);
+	// The message is queued until the connection is established
+	_chatConnection->SendChatMessage(_chatMessage, _chatMessagePriority,
+					 _mergeChatMessages);
+	SetTempVarValue(
+		"queuedChatMessages",
+		std::to_string(_chatConnection->GetQueuedMessageCount()));
+	SetTempVarValue(
+		"droppedChatMessages",
+		std::to_string(_chatConnection->GetDroppedMessageCount()));
 }
 
 bool MacroActionTwitch::PerformAction()
@@ -338,6 +348,9 @@ bool MacroActionTwitch::Save(obs_data_t *obj) const
 			 static_cast<int>(_announcementColor));
 	_channel.Save(obj);
 	_chatMessage.Save(obj, "chatMessage");
+	obs_data_set_int(obj, "chatMessagePriority",
+			 static_cast<int>(_chatMessagePriority));
+	obs_data_set_bool(obj, "mergeChatMessages", _mergeChatMessages);
 
 	return true;
 }
@@ -357,6 +370,13 @@ bool MacroActionTwitch::Load(obs_data_t *obj)
 		obs_data_get_int(obj, "announcementColor"));
 	_channel.Load(obj);
 	_chatMessage.Load(obj, "chatMessage");
+	if (obs_data_has_user_value(obj, "chatMessagePriority")) {
+		_chatMessagePriority = static_cast<ChatMessageQueue::Priority>(
+			obs_data_get_int(obj, "chatMessagePriority"));
+	} else {
+		_chatMessagePriority = ChatMessageQueue::Priority::NORMAL;
+	}
+	_mergeChatMessages = obs_data_get_bool(obj, "mergeChatMessages");
 	SetAction(static_cast<Action>(obs_data_get_int(obj, "action")));
 
 	return true;
@@ -366,6 +386,28 @@ void MacroActionTwitch::SetAction(Action action)
 {
 	_action = action;
 	ResetChatConnection();
+	SetupTempVars();
+}
+
+void MacroActionTwitch::SetupTempVars()
+{
+	MacroAction::SetupTempVars();
+	if (_action != Action::SEND_CHAT_MESSAGE) {
+		return;
+	}
+
+	AddTempvar(
+		"queuedChatMessages",
+		obs_module_text(
+			"AdvSceneSwitcher.tempVar.twitch.queuedChatMessages"),
+		obs_module_text(
+			"AdvSceneSwitcher.tempVar.twitch.queuedChatMessages.description"));
+	AddTempvar(
+		"droppedChatMessages",
+		obs_module_text(
+			"AdvSceneSwitcher.tempVar.twitch.droppedChatMessages"),
+		obs_module_text(
+			"AdvSceneSwitcher.tempVar.twitch.droppedChatMessages.description"));
 }
 
 bool MacroActionTwitch::ActionIsSupportedByToken()
@@ -507,6 +549,16 @@ static inline void populateAnnouncementColorSelection(QComboBox *list)
 	}
 }
 
+static inline void populateChatMessagePrioritySelection(QComboBox *list)
+{
+	list->addItem(obs_module_text(
+		"AdvSceneSwitcher.action.twitch.chat.priority.low"));
+	list->addItem(obs_module_text(
+		"AdvSceneSwitcher.action.twitch.chat.priority.normal"));
+	list->addItem(obs_module_text(
+		"AdvSceneSwitcher.action.twitch.chat.priority.high"));
+}
+
 MacroActionTwitchEdit::MacroActionTwitchEdit(
 	QWidget *parent, std::shared_ptr<MacroActionTwitch> entryData)
 	: QWidget(parent),
@@ -523,7 +575,10 @@ MacroActionTwitchEdit::MacroActionTwitchEdit(
 	  _announcementMessage(new VariableTextEdit(this)),
 	  _announcementColor(new QComboBox(this)),
 	  _channel(new TwitchChannelSelection(this)),
-	  _chatMessage(new VariableTextEdit(this))
+	  _chatMessage(new VariableTextEdit(this)),
+	  _chatMessagePriority(new QComboBox(this)),
+	  _mergeChatMessages(new QCheckBox(obs_module_text(
+		  "AdvSceneSwitcher.action.twitch.chat.merge")))
 {
 	SetWidgetProperties();
 	SetWidgetSignalConnections();
@@ -535,6 +590,7 @@ MacroActionTwitchEdit::MacroActionTwitchEdit(
 	mainLayout->addLayout(_layout);
 	mainLayout->addWidget(_announcementMessage);
 	mainLayout->addWidget(_chatMessage);
+	mainLayout->addWidget(_mergeChatMessages);
 	mainLayout->addWidget(_tokenWarning);
 	setLayout(mainLayout);
 
@@ -708,6 +764,7 @@ void MacroActionTwitchEdit::SetWidgetProperties()
 
 	populateActionSelection(_actions);
 	populateAnnouncementColorSelection(_announcementColor);
+	populateChatMessagePrioritySelection(_chatMessagePriority);
 }
 
 void MacroActionTwitchEdit::SetWidgetSignalConnections()
@@ -738,6 +795,11 @@ void MacroActionTwitchEdit::SetWidgetSignalConnections()
 			 SLOT(ChannelChanged(const TwitchChannel &)));
 	QWidget::connect(_chatMessage, SIGNAL(textChanged()), this,
 			 SLOT(ChatMessageChanged()));
+	QWidget::connect(_chatMessagePriority,
+			 SIGNAL(currentIndexChanged(int)), this,
+			 SLOT(ChatMessagePriorityChanged(int)));
+	QObject::connect(_mergeChatMessages, SIGNAL(stateChanged(int)), this,
+			 SLOT(MergeChatMessagesChanged(int)));
 }
 
 void MacroActionTwitchEdit::SetWidgetVisibility()
@@ -770,6 +832,12 @@ void MacroActionTwitchEdit::SetWidgetVisibility()
 		MacroActionTwitch::Action::CHAT_ANNOUNCEMENT_SEND);
 	_chatMessage->setVisible(_entryData->GetAction() ==
 				 MacroActionTwitch::Action::SEND_CHAT_MESSAGE);
+	_chatMessagePriority->setVisible(
+		_entryData->GetAction() ==
+		MacroActionTwitch::Action::SEND_CHAT_MESSAGE);
+	_mergeChatMessages->setVisible(
+		_entryData->GetAction() ==
+		MacroActionTwitch::Action::SEND_CHAT_MESSAGE);
 
 	if (_entryData->GetAction() ==
 		    MacroActionTwitch::Action::CHANNEL_INFO_TITLE_SET ||
@@ -810,12 +878,33 @@ void MacroActionTwitchEdit::ChatMessageChanged()
 	updateGeometry();
 }
 
+void MacroActionTwitchEdit::ChatMessagePriorityChanged(int index)
+{
+	if (_loading || !_entryData) {
+		return;
+	}
+
+	auto lock = LockContext();
+	_entryData->_chatMessagePriority =
+		static_cast<ChatMessageQueue::Priority>(index);
+}
+
+void MacroActionTwitchEdit::MergeChatMessagesChanged(int state)
+{
+	if (_loading || !_entryData) {
+		return;
+	}
+
+	auto lock = LockContext();
+	_entryData->_mergeChatMessages = state;
+}
+
 void MacroActionTwitchEdit::SetWidgetLayout()
 {
 	const std::vector<QWidget *> widgets{
 		_tokens,   _actions,           _streamTitle,
 		_category, _markerDescription, _clipHasDelay,
-		_duration, _announcementColor, _channel};
+		_duration, _announcementColor, _channel, _chatMessagePriority};
 	for (auto widget : widgets) {
 		_layout->removeWidget(widget);
 	}
@@ -837,7 +926,8 @@ void MacroActionTwitchEdit::SetWidgetLayout()
 		      {"{{clipHasDelay}}", _clipHasDelay},
 		      {"{{duration}}", _duration},
 		      {"{{announcementColor}}", _announcementColor},
-		      {"{{channel}}", _channel}});
+		      {"{{channel}}", _channel},
+		      {"{{chatPriority}}", _chatMessagePriority}});
 	_layout->setContentsMargins(0, 0, 0, 0);
 }
 
@@ -862,6 +952,9 @@ void MacroActionTwitchEdit::UpdateEntryData()
 	_channel->SetToken(_entryData->_token);
 	_channel->SetChannel(_entryData->_channel);
 	_chatMessage->setPlainText(_entryData->_chatMessage);
+	_chatMessagePriority->setCurrentIndex(
+		static_cast<int>(_entryData->_chatMessagePriority));
+	_mergeChatMessages->setChecked(_entryData->_mergeChatMessages);
 
 	SetWidgetVisibility();
 }
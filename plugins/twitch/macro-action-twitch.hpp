@@ -169,6 +169,9 @@ public:
 	AnnouncementColor _announcementColor = AnnouncementColor::PRIMARY;
 	TwitchChannel _channel;
 	StringVariable _chatMessage;
+	ChatMessageQueue::Priority _chatMessagePriority =
+		ChatMessageQueue::Priority::NORMAL;
+	bool _mergeChatMessages = false;
 
 private:
 	void SetStreamTitle(const std::shared_ptr<TwitchToken> &) const;
@@ -181,6 +184,7 @@ private:
 				  bool enable) const;
 	void StartRaid(const std::shared_ptr<TwitchToken> &);
 	void SendChatMessage(const std::shared_ptr<TwitchToken> &);
+	void SetupTempVars();
 
 	Action _action = Action::CHANNEL_INFO_TITLE_SET;
 	std::shared_ptr<TwitchChatConnection> _chatConnection;
@@ -218,6 +222,8 @@ private slots:
 	void AnnouncementColorChanged(int index);
 	void ChannelChanged(const TwitchChannel &);
 	void ChatMessageChanged();
+	void ChatMessagePriorityChanged(int);
+	void MergeChatMessagesChanged(int);
 
 signals:
 	void HeaderInfoChanged(const QString &);
@@ -246,6 +252,8 @@ private:
 	QComboBox *_announcementColor;
 	TwitchChannelSelection *_channel;
 	VariableTextEdit *_chatMessage;
+	QComboBox *_chatMessagePriority;
+	QCheckBox *_mergeChatMessages;
 
 	bool _loading = true;
 };
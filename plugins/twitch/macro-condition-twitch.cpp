@@ -233,6 +233,7 @@ void MacroConditionTwitch::SetCondition(const Condition &condition)
 void MacroConditionTwitch::SetToken(const std::weak_ptr<TwitchToken> &t)
 {
 	_token = t;
+	ResetSubscription();
 }
 
 void MacroConditionTwitch::SetChannel(const TwitchChannel &channel)
@@ -292,13 +293,12 @@ bool MacroConditionTwitch::CheckChannelGenericEvents()
 	}
 
 	while (!_eventBuffer->Empty()) {
-		auto event = _eventBuffer->ConsumeMessage();
+		std::chrono::steady_clock::time_point arrival;
+		auto event = _eventBuffer->ConsumeMessage(arrival);
 		if (!event) {
 			continue;
 		}
-		if (_subscriptionID != event->id) {
-			continue;
-		}
+		TraceTriggerEvent("twitch event", arrival);
 		SetVariableValue(event->ToString());
 		setTempVarsHelper(
 			event->data,
@@ -322,13 +322,11 @@ bool MacroConditionTwitch::CheckChannelLiveEvents()
 	}
 
 	while (!_eventBuffer->Empty()) {
-		auto event = _eventBuffer->ConsumeMessage();
+		std::chrono::steady_clock::time_point arrival;
+		auto event = _eventBuffer->ConsumeMessage(arrival);
 		if (!event) {
 			continue;
 		}
-		if (_subscriptionID != event->id) {
-			continue;
-		}
 
 		auto it = liveEventIDs.find(_condition);
 		if (it == liveEventIDs.end()) {
@@ -341,6 +339,7 @@ bool MacroConditionTwitch::CheckChannelLiveEvents()
 			continue;
 		}
 
+		TraceTriggerEvent("twitch event", arrival);
 		SetVariableValue(event->ToString());
 		setTempVarsHelper(
 			event->data,
@@ -380,7 +379,8 @@ bool MacroConditionTwitch::CheckChatMessages(TwitchToken &token)
 	}
 
 	while (!_chatBuffer->Empty()) {
-		auto message = _chatBuffer->ConsumeMessage();
+		std::chrono::steady_clock::time_point arrival;
+		auto message = _chatBuffer->ConsumeMessage(arrival);
 		if (!message) {
 			continue;
 		}
@@ -389,6 +389,7 @@ bool MacroConditionTwitch::CheckChatMessages(TwitchToken &token)
 			continue;
 		}
 
+		TraceTriggerEvent("twitch chat", arrival);
 		SetTempVarValue("user_login", message->source.nick);
 		SetTempVarValue("user_name", message->properties.displayName);
 		SetTempVarValue("chat_message", message->message);
@@ -462,12 +463,10 @@ bool MacroConditionTwitch::EventSubscriptionIsSetup(
 	if (!eventSub) {
 		return false;
 	}
-	SetupEventSubscription(*eventSub);
-	if (_subscriptionIDFuture.valid()) {
-		// Still waiting for the subscription to be registered
-		return false;
+	if (!_subscription || _subscription->IsExpired()) {
+		RegisterEventSubscription();
 	}
-	return true;
+	return _subscription && _subscription->IsActive();
 }
 
 void MacroConditionTwitch::HandleMacroPause()
@@ -627,7 +626,7 @@ bool MacroConditionTwitch::Load(obs_data_t *obj)
 		_clearBufferOnMatch = false;
 	}
 
-	_subscriptionID = "";
+	ResetSubscription();
 	ResetChatConnection();
 
 	return true;
@@ -836,23 +835,7 @@ void MacroConditionTwitch::RegisterEventSubscription()
 void MacroConditionTwitch::ResetSubscription()
 {
 	_eventBuffer.reset();
-	_subscriptionID = "";
-}
-
-void MacroConditionTwitch::SetupEventSubscription(EventSub &eventSub)
-{
-	if (_subscriptionIDFuture.valid()) {
-		if (_subscriptionIDFuture.wait_for(std::chrono::seconds(0)) !=
-		    std::future_status::ready)
-			return;
-
-		_subscriptionID = _subscriptionIDFuture.get();
-	}
-	if (eventSub.SubscriptionIsActive(_subscriptionID)) {
-		return;
-	}
-	RegisterEventSubscription();
-	_eventBuffer = eventSub.RegisterForEvents();
+	_subscription.reset();
 }
 
 bool MacroConditionTwitch::IsUsingEventSubCondition()
@@ -860,16 +843,6 @@ bool MacroConditionTwitch::IsUsingEventSubCondition()
 	return eventIdentifiers.find(_condition) != eventIdentifiers.end();
 }
 
-std::future<std::string>
-waitForSubscription(const std::shared_ptr<TwitchToken> &token,
-		    const Subscription &subscription)
-{
-	return std::async(std::launch::async, [token, subscription]() {
-		auto id = EventSub::AddEventSubscribtion(token, subscription);
-		return id;
-	});
-}
-
 void MacroConditionTwitch::AddChannelGenericEventSubscription(
 	const char *version, bool includeModeratorId,
 	const char *mainUserIdFieldName, obs_data_t *extraConditions)
@@ -899,7 +872,15 @@ void MacroConditionTwitch::AddChannelGenericEventSubscription(
 
 	obs_data_apply(condition, extraConditions);
 	obs_data_set_obj(subscription.data, "condition", condition);
-	_subscriptionIDFuture = waitForSubscription(token, subscription);
+
+	_subscription = EventSub::RequestSubscription(token, subscription);
+	if (!_subscription) {
+		return;
+	}
+	// Events are routed by subscription key, so no events will be missed
+	// even if they arrive before the registration request completed
+	_eventBuffer = token->GetEventSub()->RegisterForEvents(
+		_subscription->GetKey());
 }
 
 static std::string tryTranslate(const std::string &testString)
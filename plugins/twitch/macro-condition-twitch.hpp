@@ -113,7 +113,6 @@ private:
 
 	void RegisterEventSubscription();
 	void ResetSubscription();
-	void SetupEventSubscription(EventSub &);
 	bool EventSubscriptionIsSetup(const std::shared_ptr<EventSub> &);
 	void AddChannelGenericEventSubscription(
 		const char *version, bool includeModeratorId = false,
@@ -131,8 +130,7 @@ private:
 	std::weak_ptr<TwitchToken> _token;
 
 	EventSubMessageBuffer _eventBuffer;
-	std::future<std::string> _subscriptionIDFuture;
-	std::string _subscriptionID;
+	std::shared_ptr<EventSubSubscription> _subscription;
 
 	ChatMessageBuffer _chatBuffer;
 	std::shared_ptr<TwitchChatConnection> _chatConnection;
@@ -155,18 +155,24 @@ RequestResult SendPostRequest(const TwitchToken &token, const std::string &uri,
 			      const httplib::Params &params,
 			      const OBSData &data)
 {
-	httplib::Client cli(uri);
 	auto tokenStr = token.GetToken();
-
 	if (!tokenStr) {
 		return {};
 	}
+	return SendPostRequest(*tokenStr, uri, path, params, data);
+}
 
+RequestResult SendPostRequest(const std::string &token, const std::string &uri,
+			      const std::string &path,
+			      const httplib::Params &params,
+			      const OBSData &data)
+{
+	httplib::Client cli(uri);
 	auto pathWithParams = httplib::append_query_params(path, params);
 	auto url = uri + pathWithParams;
 	vblog(LOG_INFO, "Twitch POST request to %s began", url.c_str());
 
-	auto headers = getTokenRequestHeaders(*tokenStr);
+	auto headers = getTokenRequestHeaders(token);
 	auto body = getRequestBody(data);
 	auto response =
 		cli.Post(pathWithParams, headers, body, "application/json");
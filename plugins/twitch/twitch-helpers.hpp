@@ -23,6 +23,11 @@ RequestResult SendPostRequest(const TwitchToken &token, const std::string &uri,
 			      const std::string &path,
 			      const httplib::Params &params = {},
 			      const OBSData &data = nullptr);
+// Uses the given token value instead of querying it from a TwitchToken
+RequestResult SendPostRequest(const std::string &token, const std::string &uri,
+			      const std::string &path,
+			      const httplib::Params &params = {},
+			      const OBSData &data = nullptr);
 RequestResult SendPutRequest(const TwitchToken &token, const std::string &uri,
 			     const std::string &path,
 			     const httplib::Params &params = {},
@@ -0,0 +1,128 @@
+#include "catch.hpp"
+
+#include <chat-message-queue.hpp>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Send rate limiter limits rate", "[chat-message-queue]")
+{
+	auto now = advss::SendRateLimiter::Clock::now();
+	advss::SendRateLimiter limiter(2, 1s);
+
+	REQUIRE(limiter.TryTake(now));
+	REQUIRE(limiter.TryTake(now + 400ms));
+	REQUIRE_FALSE(limiter.TryTake(now + 400ms));
+	REQUIRE(limiter.NextAvailable(now + 400ms) == now + 1s);
+	REQUIRE_FALSE(limiter.TryTake(now + 999ms));
+	REQUIRE(limiter.TryTake(now + 1s));
+	REQUIRE_FALSE(limiter.TryTake(now + 1s));
+	REQUIRE(limiter.NextAvailable(now + 1s) == now + 1400ms);
+
+	// Unused sends do not accumulate
+	REQUIRE(limiter.TryTake(now + 10s));
+	REQUIRE(limiter.TryTake(now + 10s));
+	REQUIRE_FALSE(limiter.TryTake(now + 10s));
+}
+
+TEST_CASE("Send rate limiter never exceeds the limit within any window",
+	  "[chat-message-queue]")
+{
+	constexpr size_t limit = 5;
+	constexpr auto period = 1s;
+
+	auto start = advss::SendRateLimiter::Clock::now();
+	advss::SendRateLimiter limiter(limit, period);
+
+	// Try to send every 10ms, which is far more than the limit allows
+	std::vector<advss::SendRateLimiter::Clock::time_point> sendTimes;
+	for (auto time = start; time < start + 10s; time += 10ms) {
+		if (limiter.TryTake(time)) {
+			sendTimes.push_back(time);
+		}
+	}
+
+	REQUIRE(sendTimes.size() == limit * 10);
+	for (size_t i = limit; i < sendTimes.size(); i++) {
+		REQUIRE(sendTimes[i] - sendTimes[i - limit] >= period);
+	}
+}
+
+TEST_CASE("Chat messages are released at the allowed rate",
+	  "[chat-message-queue]")
+{
+	auto now = advss::ChatMessageQueue::Clock::now();
+	advss::ChatMessageQueue queue(100, {2, 30s});
+
+	REQUIRE_FALSE(queue.NextSendTime(now));
+	REQUIRE_FALSE(queue.Pop(now));
+
+	queue.Push("#a", "1");
+	queue.Push("#a", "2");
+	queue.Push("#a", "3");
+	REQUIRE(queue.Size() == 3);
+
+	REQUIRE(queue.Pop(now)->text == "1");
+	REQUIRE(queue.Pop(now)->text == "2");
+	REQUIRE_FALSE(queue.Pop(now));
+	REQUIRE(*queue.NextSendTime(now) == now + 30s);
+	REQUIRE_FALSE(queue.Pop(now + 29s));
+	REQUIRE(queue.Pop(now + 30s)->text == "3");
+	REQUIRE(queue.Empty());
+}
+
+TEST_CASE("Chat messages with higher priority are sent first",
+	  "[chat-message-queue]")
+{
+	using Priority = advss::ChatMessageQueue::Priority;
+
+	auto now = advss::ChatMessageQueue::Clock::now();
+	advss::ChatMessageQueue queue(100, {10, 30s});
+
+	queue.Push("#a", "low", Priority::LOW);
+	queue.Push("#a", "normal", Priority::NORMAL);
+	queue.Push("#a", "high", Priority::HIGH);
+
+	REQUIRE(queue.Pop(now)->text == "high");
+	REQUIRE(queue.Pop(now)->text == "normal");
+	REQUIRE(queue.Pop(now)->text == "low");
+}
+
+TEST_CASE("Chat messages are merged", "[chat-message-queue]")
+{
+	auto now = advss::ChatMessageQueue::Clock::now();
+	advss::ChatMessageQueue queue(100, {10, 30s});
+
+	queue.Push("#a", "1", advss::ChatMessageQueue::Priority::NORMAL, true);
+	queue.Push("#b", "2", advss::ChatMessageQueue::Priority::NORMAL, true);
+	queue.Push("#a", "3", advss::ChatMessageQueue::Priority::NORMAL, true);
+	queue.Push("#a", "4", advss::ChatMessageQueue::Priority::NORMAL);
+	REQUIRE(queue.Size() == 3);
+
+	auto message = queue.Pop(now);
+	REQUIRE(message->channel == "#a");
+	REQUIRE(message->text == "1 3");
+	REQUIRE(queue.Pop(now)->text == "2");
+	REQUIRE(queue.Pop(now)->text == "4");
+}
+
+TEST_CASE("Chat messages are dropped if queue is full",
+	  "[chat-message-queue]")
+{
+	using Priority = advss::ChatMessageQueue::Priority;
+
+	auto now = advss::ChatMessageQueue::Clock::now();
+	advss::ChatMessageQueue queue(2, {10, 30s});
+
+	queue.Push("#a", "1", Priority::NORMAL);
+	queue.Push("#a", "2", Priority::NORMAL);
+	queue.Push("#a", "3", Priority::LOW);
+	REQUIRE(queue.DroppedCount() == 1);
+	REQUIRE(queue.Size() == 2);
+
+	queue.Push("#a", "4", Priority::HIGH);
+	REQUIRE(queue.DroppedCount() == 2);
+	REQUIRE(queue.Pop(now)->text == "4");
+	REQUIRE(queue.Pop(now)->text == "2");
+	REQUIRE(queue.Empty());
+}
@@ -1,6 +1,8 @@
 #include "catch.hpp"
 
 #include <condition-logic.hpp>
+#include <random>
+#include <vector>
 
 TEST_CASE("Get and set", "[conditon-logic]")
 {
@@ -171,3 +173,134 @@ TEST_CASE("Logic", "[conditon-logic]")
 	REQUIRE(advss::Logic::ApplyConditionLogic(logic, true, false, ""));
 	REQUIRE(advss::Logic::ApplyConditionLogic(logic, true, true, ""));
 }
+
+static const std::vector<advss::Logic::Type> allLogicTypes = {
+	advss::Logic::Type::ROOT_NONE,
+	advss::Logic::Type::ROOT_NOT,
+	advss::Logic::Type::ROOT_LAST,
+	advss::Logic::Type::NONE,
+	advss::Logic::Type::AND,
+	advss::Logic::Type::OR,
+	advss::Logic::Type::AND_NOT,
+	advss::Logic::Type::OR_NOT,
+	advss::Logic::Type::LAST,
+	static_cast<advss::Logic::Type>(-1),
+};
+
+struct TestConditionEntry {
+	advss::Logic::Type logicType;
+	advss::LogicOp op;
+	bool result;
+};
+
+static bool evaluateOps(const std::vector<advss::Logic::Type> &types,
+			const std::vector<bool> &results)
+{
+	std::vector<TestConditionEntry> plan;
+	for (size_t i = 0; i < types.size(); ++i) {
+		plan.push_back({types[i], advss::LogicOp::FromType(types[i]),
+				results[i]});
+	}
+	bool matched = false;
+	REQUIRE(advss::EvaluateConditionPlan(
+		plan,
+		[](const TestConditionEntry &entry) -> std::optional<bool> {
+			return entry.result;
+		},
+		matched, ""));
+	return matched;
+}
+
+// Previous evaluation of the condition list
+static bool evaluateLogic(const std::vector<advss::Logic::Type> &types,
+			  const std::vector<bool> &results)
+{
+	bool matched = false;
+	for (size_t i = 0; i < types.size(); ++i) {
+		if (types[i] == advss::Logic::Type::NONE) {
+			continue;
+		}
+		matched = advss::Logic::ApplyConditionLogic(types[i], matched,
+							    results[i], "");
+	}
+	return matched;
+}
+
+TEST_CASE("Logic op", "[conditon-logic]")
+{
+	for (const auto type : allLogicTypes) {
+		auto op = advss::LogicOp::FromType(type);
+		REQUIRE(op.negate == advss::Logic::IsNegationType(type));
+		if (op.mode == advss::LogicOp::Mode::SKIP ||
+		    op.mode == advss::LogicOp::Mode::INVALID) {
+			continue;
+		}
+		for (const bool current : {false, true}) {
+			for (const bool matched : {false, true}) {
+				REQUIRE(op.Apply(current, matched) ==
+					advss::Logic::ApplyConditionLogic(
+						type, current, matched, ""));
+			}
+		}
+	}
+}
+
+TEST_CASE("Logic op condition lists", "[conditon-logic]")
+{
+	std::mt19937 gen(1234);
+	std::uniform_int_distribution<size_t> typeDist(
+		0, allLogicTypes.size() - 1);
+	std::uniform_int_distribution<size_t> sizeDist(1, 8);
+	std::bernoulli_distribution resultDist;
+
+	for (int i = 0; i < 10000; ++i) {
+		const auto size = sizeDist(gen);
+		std::vector<advss::Logic::Type> types;
+		std::vector<bool> results;
+		for (size_t j = 0; j < size; ++j) {
+			types.emplace_back(allLogicTypes[typeDist(gen)]);
+			results.emplace_back(resultDist(gen));
+		}
+		REQUIRE(evaluateOps(types, results) ==
+			evaluateLogic(types, results));
+	}
+}
+
+TEST_CASE("Logic op condition list abort", "[conditon-logic]")
+{
+	std::vector<TestConditionEntry> plan = {
+		{advss::Logic::Type::ROOT_NONE,
+		 advss::LogicOp::FromType(advss::Logic::Type::ROOT_NONE), true},
+		{advss::Logic::Type::AND,
+		 advss::LogicOp::FromType(advss::Logic::Type::AND), true},
+		{advss::Logic::Type::AND,
+		 advss::LogicOp::FromType(advss::Logic::Type::AND), false},
+	};
+
+	int checks = 0;
+	bool matched = false;
+	REQUIRE_FALSE(advss::EvaluateConditionPlan(
+		plan,
+		[&checks](const TestConditionEntry &entry)
+			-> std::optional<bool> {
+			if (++checks == 2) {
+				return {};
+			}
+			return entry.result;
+		},
+		matched, ""));
+	REQUIRE(checks == 2);
+	REQUIRE(matched);
+
+	checks = 0;
+	REQUIRE(advss::EvaluateConditionPlan(
+		plan,
+		[&checks](const TestConditionEntry &entry)
+			-> std::optional<bool> {
+			++checks;
+			return entry.result;
+		},
+		matched, ""));
+	REQUIRE(checks == 3);
+	REQUIRE_FALSE(matched);
+}
@@ -0,0 +1,51 @@
+#include "catch.hpp"
+
+#include <duplicate-filter.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Duplicate IDs are rejected", "[duplicate-filter]")
+{
+	advss::DuplicateFilter filter(10min, 100);
+	auto now = advss::DuplicateFilter::Clock::now();
+
+	REQUIRE(filter.Insert("a", now));
+	REQUIRE(filter.Insert("b", now));
+	REQUIRE(filter.Insert("c", now));
+	REQUIRE_FALSE(filter.Insert("a", now + 1s));
+	REQUIRE_FALSE(filter.Insert("b", now + 2s));
+	REQUIRE(filter.Size() == 3);
+}
+
+TEST_CASE("Duplicate filter forgets IDs outside of window",
+	  "[duplicate-filter]")
+{
+	advss::DuplicateFilter filter(10min, 100);
+	auto now = advss::DuplicateFilter::Clock::now();
+
+	REQUIRE(filter.Insert("a", now));
+	REQUIRE(filter.Insert("b", now + 5min));
+	REQUIRE_FALSE(filter.Insert("a", now + 10min));
+	REQUIRE(filter.Insert("a", now + 11min));
+	REQUIRE_FALSE(filter.Insert("b", now + 11min));
+	REQUIRE(filter.Contains("b"));
+	REQUIRE(filter.Size() == 2);
+}
+
+TEST_CASE("Duplicate filter is limited in size", "[duplicate-filter]")
+{
+	advss::DuplicateFilter filter(10min, 2);
+	auto now = advss::DuplicateFilter::Clock::now();
+
+	REQUIRE(filter.Insert("a", now));
+	REQUIRE(filter.Insert("b", now));
+	REQUIRE(filter.Insert("c", now));
+	REQUIRE(filter.Size() == 2);
+	REQUIRE_FALSE(filter.Contains("a"));
+	REQUIRE(filter.Insert("a", now));
+	REQUIRE_FALSE(filter.Contains("b"));
+
+	filter.Clear();
+	REQUIRE(filter.Size() == 0);
+	REQUIRE(filter.Insert("c", now));
+}
@@ -0,0 +1,145 @@
+#include "catch.hpp"
+
+#include <event-sub-session.hpp>
+#include <vector>
+
+using namespace std::chrono_literals;
+using CloseResult = advss::EventSubSession::CloseResult;
+
+namespace {
+
+// Replays the messages of an EventSub session as they are received on the
+// individual connections
+struct SessionReplay {
+	advss::EventSubSession session{10min, 100};
+	std::vector<std::string> notifications;
+	std::vector<advss::EventSubSession::Handle> closedByClient;
+
+	void Notify(const std::string &id)
+	{
+		if (session.AcceptMessage(id)) {
+			notifications.emplace_back(id);
+		}
+	}
+
+	void Welcome(const advss::EventSubSession::Handle &hdl)
+	{
+		auto previous = session.Welcome(hdl);
+		if (previous) {
+			closedByClient.emplace_back(*previous);
+		}
+	}
+};
+
+} // namespace
+
+static bool isSame(const advss::EventSubSession::Handle &a,
+		   const std::shared_ptr<int> &b)
+{
+	return a.lock() == b;
+}
+
+TEST_CASE("EventSub session hands off to reconnect connection",
+	  "[event-sub-session]")
+{
+	SessionReplay replay;
+	auto oldConnection = std::make_shared<int>(1);
+	auto newConnection = std::make_shared<int>(2);
+
+	replay.session.Connect(oldConnection);
+	replay.Welcome(oldConnection);
+	REQUIRE(replay.closedByClient.empty());
+	replay.Notify("1");
+
+	// session_reconnect received on the old connection
+	replay.session.Reconnect(newConnection);
+	REQUIRE(replay.session.IsPending(newConnection));
+	REQUIRE(replay.session.IsCurrent(oldConnection));
+
+	// Notifications keep arriving on the old connection until the new one
+	// was welcomed
+	replay.Notify("2");
+	replay.Welcome(newConnection);
+	REQUIRE(replay.session.IsCurrent(newConnection));
+	REQUIRE_FALSE(replay.session.IsPending(newConnection));
+	REQUIRE(replay.closedByClient.size() == 1);
+	REQUIRE(isSame(replay.closedByClient[0], oldConnection));
+
+	// Twitch may deliver messages on both connections during the handoff
+	replay.Notify("2");
+	replay.Notify("3");
+	replay.Notify("3");
+
+	REQUIRE(replay.session.Close(oldConnection) == CloseResult::IGNORED);
+	replay.Notify("4");
+
+	const std::vector<std::string> expected = {"1", "2", "3", "4"};
+	REQUIRE(replay.notifications == expected);
+
+	REQUIRE(replay.session.Close(newConnection) == CloseResult::CLOSED);
+}
+
+TEST_CASE("EventSub session handles old connection closing first",
+	  "[event-sub-session]")
+{
+	SessionReplay replay;
+	auto oldConnection = std::make_shared<int>(1);
+	auto newConnection = std::make_shared<int>(2);
+
+	replay.session.Connect(oldConnection);
+	replay.Notify("1");
+	replay.session.Reconnect(newConnection);
+
+	// Twitch closes the old connection before the welcome was processed
+	REQUIRE(replay.session.Close(oldConnection) ==
+		CloseResult::HANDED_OFF);
+	REQUIRE(replay.session.IsCurrent(newConnection));
+
+	// Nothing is left to be closed by the welcome
+	replay.Welcome(newConnection);
+	REQUIRE(replay.closedByClient.empty());
+	replay.Notify("1");
+	replay.Notify("2");
+
+	const std::vector<std::string> expected = {"1", "2"};
+	REQUIRE(replay.notifications == expected);
+}
+
+TEST_CASE("EventSub session keeps current connection if reconnect fails",
+	  "[event-sub-session]")
+{
+	SessionReplay replay;
+	auto connection = std::make_shared<int>(1);
+	auto failedConnection = std::make_shared<int>(2);
+
+	replay.session.Connect(connection);
+	replay.session.Reconnect(failedConnection);
+	REQUIRE(replay.session.Close(failedConnection) ==
+		CloseResult::RECONNECT_FAILED);
+	REQUIRE(replay.session.IsCurrent(connection));
+	REQUIRE_FALSE(replay.session.IsPending(failedConnection));
+
+	// A late welcome of the failed connection is ignored
+	replay.Welcome(failedConnection);
+	REQUIRE(replay.closedByClient.empty());
+	REQUIRE(replay.session.IsCurrent(connection));
+
+	REQUIRE(replay.session.Close(connection) == CloseResult::CLOSED);
+}
+
+TEST_CASE("EventSub session connect discards pending connection",
+	  "[event-sub-session]")
+{
+	advss::EventSubSession session(10min, 100);
+	auto oldConnection = std::make_shared<int>(1);
+	auto pendingConnection = std::make_shared<int>(2);
+	auto connection = std::make_shared<int>(3);
+
+	session.Connect(oldConnection);
+	session.Reconnect(pendingConnection);
+	session.Connect(connection);
+	REQUIRE(session.IsCurrent(connection));
+	REQUIRE_FALSE(session.IsPending(pendingConnection));
+	REQUIRE(session.Close(pendingConnection) == CloseResult::IGNORED);
+	REQUIRE(session.Close(oldConnection) == CloseResult::IGNORED);
+}
@@ -0,0 +1,136 @@
+#include "catch.hpp"
+
+#include <event-sub-subscriptions.hpp>
+
+using State = advss::EventSubSubscription::State;
+
+static advss::SubscriptionRegistrationResult
+accepted(const std::string &id, long long totalCost = 1,
+	 long long maxTotalCost = 10)
+{
+	advss::SubscriptionRegistrationResult result;
+	result.status = 202;
+	result.id = id;
+	result.totalCost = totalCost;
+	result.maxTotalCost = maxTotalCost;
+	return result;
+}
+
+static advss::SubscriptionRegistrationResult failed(int status)
+{
+	advss::SubscriptionRegistrationResult result;
+	result.status = status;
+	return result;
+}
+
+TEST_CASE("EventSub subscriptions are registered in batches",
+	  "[event-sub-subscriptions]")
+{
+	advss::EventSubSubscriptionRegistry registry;
+	std::vector<std::shared_ptr<advss::EventSubSubscription>> handles;
+	for (int i = 0; i < 6; i++) {
+		handles.emplace_back(registry.Request(std::to_string(i)));
+	}
+	REQUIRE(registry.Request("0") == handles[0]);
+
+	auto batch = registry.TakePending(4);
+	REQUIRE(batch.size() == 4);
+	for (const auto &subscription : batch) {
+		REQUIRE(subscription->GetState() == State::REGISTERING);
+	}
+	REQUIRE(registry.TakePending(4).size() == 2);
+	REQUIRE(registry.TakePending(4).empty());
+
+	REQUIRE(registry.HandleResult(*batch[0], accepted("id")));
+	REQUIRE(batch[0]->IsActive());
+	REQUIRE(registry.GetKey("id") == batch[0]->GetKey());
+	REQUIRE_FALSE(registry.GetKey("unknown"));
+
+	// Subscriptions without a handle are no longer registered
+	registry.Reset();
+	handles.resize(1);
+	batch.clear();
+	REQUIRE(handles[0]->GetState() == State::PENDING);
+	REQUIRE_FALSE(registry.GetKey("id"));
+	REQUIRE(registry.TakePending(4).size() == 1);
+}
+
+TEST_CASE("EventSub subscription registration is retried after failure",
+	  "[event-sub-subscriptions]")
+{
+	advss::EventSubSubscriptionRegistry registry;
+	auto subscription = registry.Request("a");
+	auto rejected = registry.Request("b");
+
+	REQUIRE(registry.TakePending(4).size() == 2);
+	REQUIRE_FALSE(registry.HandleResult(*subscription, failed(0)));
+	REQUIRE(subscription->GetState() == State::PENDING);
+	REQUIRE(registry.HandleResult(*rejected, failed(403)));
+	REQUIRE(rejected->GetState() == State::FAILED);
+
+	auto retry = registry.TakePending(4);
+	REQUIRE(retry.size() == 1);
+	REQUIRE(retry[0] == subscription);
+	REQUIRE_FALSE(registry.HandleResult(*subscription, failed(429)));
+	REQUIRE(registry.TakePending(4).size() == 1);
+	REQUIRE(registry.HandleResult(*subscription, accepted("id")));
+	REQUIRE(subscription->IsActive());
+	REQUIRE(registry.TakePending(4).empty());
+
+	// Failed subscriptions are attempted again for the next session
+	registry.Reset();
+	REQUIRE(rejected->GetState() == State::PENDING);
+	REQUIRE(registry.TakePending(4).size() == 2);
+}
+
+TEST_CASE("EventSub subscription cost limit stops the registration",
+	  "[event-sub-subscriptions]")
+{
+	advss::EventSubSubscriptionRegistry registry;
+	auto first = registry.Request("a");
+	auto second = registry.Request("b");
+	auto third = registry.Request("c");
+
+	auto batch = registry.TakePending(2);
+	REQUIRE(batch.size() == 2);
+	REQUIRE(registry.HandleResult(*batch[0], accepted("1", 9, 10)));
+	REQUIRE_FALSE(registry.CostLimitReached());
+	REQUIRE(registry.HandleResult(*batch[1], accepted("2", 10, 10)));
+	REQUIRE(registry.CostLimitReached());
+	REQUIRE(registry.TakePending(2).empty());
+
+	registry.Reset();
+	REQUIRE_FALSE(registry.CostLimitReached());
+	REQUIRE(registry.TakePending(4).size() == 3);
+}
+
+TEST_CASE("EventSub subscription results are ignored after session end",
+	  "[event-sub-subscriptions]")
+{
+	advss::EventSubSubscriptionRegistry registry;
+	auto subscription = registry.Request("a");
+
+	REQUIRE(registry.TakePending(4).size() == 1);
+	registry.Reset();
+	REQUIRE(registry.HandleResult(*subscription, accepted("id")));
+	REQUIRE(subscription->GetState() == State::PENDING);
+	REQUIRE_FALSE(registry.GetKey("id"));
+}
+
+TEST_CASE("EventSub subscriptions are revoked and expired",
+	  "[event-sub-subscriptions]")
+{
+	advss::EventSubSubscriptionRegistry registry;
+	auto subscription = registry.Request("a");
+
+	REQUIRE(registry.TakePending(4).size() == 1);
+	REQUIRE(registry.HandleResult(*subscription, accepted("id")));
+	registry.Revoke("id");
+	REQUIRE(subscription->GetState() == State::FAILED);
+	REQUIRE_FALSE(registry.GetKey("id"));
+
+	registry.Clear();
+	REQUIRE(subscription->IsExpired());
+	REQUIRE(registry.TakePending(4).empty());
+	REQUIRE(registry.Request("a") != subscription);
+}
@@ -51,3 +51,34 @@ TEST_CASE("MatchJson", "[json-helpers]")
 	result = advss::MatchJson("{\n    \"test\": true\n}\n", "(", regex);
 	REQUIRE(result == false);
 }
+
+TEST_CASE("PeekJsonIntValue", "[json-helpers]")
+{
+	auto result = advss::PeekJsonIntValue("", "op");
+	REQUIRE_FALSE(result);
+
+	result = advss::PeekJsonIntValue("{\"op\":5}", "op");
+	REQUIRE(result);
+	REQUIRE(*result == 5);
+
+	result = advss::PeekJsonIntValue("{ \"d\" : {\"op\": 1}, \"op\" : 7 }",
+					 "op");
+	REQUIRE(result);
+	REQUIRE(*result == 7);
+
+	result = advss::PeekJsonIntValue(
+		"{\"d\":{\"message\":\"{\\\"op\\\":3}\"},\"op\":-2}", "op");
+	REQUIRE(result);
+	REQUIRE(*result == -2);
+
+	result = advss::PeekJsonIntValue("{\"d\":{\"op\":1}}", "op");
+	REQUIRE_FALSE(result);
+
+	result = advss::PeekJsonIntValue("{\"op\":\"abc\"}", "op");
+	REQUIRE_FALSE(result);
+
+	result = advss::PeekJsonIntValue("{\"list\":[{\"op\":1}],\"op\":9}",
+					 "op");
+	REQUIRE(result);
+	REQUIRE(*result == 9);
+}
@@ -0,0 +1,127 @@
+#include "catch.hpp"
+
+#include <key-press-scheduler.hpp>
+
+#include <mutex>
+
+using namespace std::chrono_literals;
+
+using advss::HotkeyType;
+
+struct RecordingSink {
+	std::mutex mutex;
+	std::vector<std::vector<advss::KeyEvent>> batches;
+
+	advss::KeyPressScheduler::Sink Get()
+	{
+		return [this](const std::vector<advss::KeyEvent> &batch) {
+			std::lock_guard<std::mutex> lock(mutex);
+			batches.push_back(batch);
+		};
+	}
+
+	std::vector<std::pair<HotkeyType, bool>> Events()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		std::vector<std::pair<HotkeyType, bool>> result;
+		for (const auto &batch : batches) {
+			for (const auto &event : batch) {
+				result.emplace_back(event.key, event.pressed);
+			}
+		}
+		return result;
+	}
+};
+
+TEST_CASE("Chord is pressed and released as batches", "[key-press-scheduler]")
+{
+	RecordingSink sink;
+	{
+		advss::KeyPressScheduler scheduler(sink.Get());
+		scheduler.Press({HotkeyType::Key_A, HotkeyType::Key_B}, 20ms);
+		std::this_thread::sleep_for(100ms);
+		REQUIRE_FALSE(scheduler.IsPressed(HotkeyType::Key_A));
+	}
+
+	std::lock_guard<std::mutex> lock(sink.mutex);
+	REQUIRE(sink.batches.size() == 2);
+	REQUIRE(sink.batches[0].size() == 2);
+	REQUIRE(sink.batches[0][0].key == HotkeyType::Key_A);
+	REQUIRE(sink.batches[0][0].pressed);
+	REQUIRE(sink.batches[0][1].key == HotkeyType::Key_B);
+	REQUIRE(sink.batches[0][1].pressed);
+	REQUIRE(sink.batches[1].size() == 2);
+	REQUIRE_FALSE(sink.batches[1][0].pressed);
+	REQUIRE_FALSE(sink.batches[1][1].pressed);
+}
+
+TEST_CASE("Overlapping presses are reference counted", "[key-press-scheduler]")
+{
+	RecordingSink sink;
+	advss::KeyPressScheduler scheduler(sink.Get());
+	scheduler.Press({HotkeyType::Key_A}, 150ms);
+	std::this_thread::sleep_for(20ms);
+	scheduler.Press({HotkeyType::Key_A}, 20ms);
+	std::this_thread::sleep_for(60ms);
+
+	// The first press is still holding the key
+	REQUIRE(scheduler.IsPressed(HotkeyType::Key_A));
+	REQUIRE(sink.Events().size() == 1);
+
+	std::this_thread::sleep_for(150ms);
+	REQUIRE_FALSE(scheduler.IsPressed(HotkeyType::Key_A));
+	auto events = sink.Events();
+	REQUIRE(events.size() == 2);
+	REQUIRE(events[0] == std::make_pair(HotkeyType::Key_A, true));
+	REQUIRE(events[1] == std::make_pair(HotkeyType::Key_A, false));
+}
+
+TEST_CASE("Sequences keep their order", "[key-press-scheduler]")
+{
+	RecordingSink sink;
+	advss::KeyPressScheduler scheduler(sink.Get());
+	scheduler.PressSequence({{{HotkeyType::Key_A}, 10ms, 10ms},
+				 {{HotkeyType::Key_B}, 10ms, 0ms},
+				 {{HotkeyType::Key_C}, 10ms, 0ms}});
+	std::this_thread::sleep_for(150ms);
+
+	auto events = sink.Events();
+	REQUIRE(events.size() == 6);
+	REQUIRE(events[0] == std::make_pair(HotkeyType::Key_A, true));
+	REQUIRE(events[1] == std::make_pair(HotkeyType::Key_A, false));
+	REQUIRE(events[2] == std::make_pair(HotkeyType::Key_B, true));
+	REQUIRE(events[3] == std::make_pair(HotkeyType::Key_B, false));
+	REQUIRE(events[4] == std::make_pair(HotkeyType::Key_C, true));
+	REQUIRE(events[5] == std::make_pair(HotkeyType::Key_C, false));
+}
+
+TEST_CASE("Held keys are repeated", "[key-press-scheduler]")
+{
+	RecordingSink sink;
+	advss::KeyPressScheduler scheduler(sink.Get(), 20ms);
+	scheduler.Press({HotkeyType::Key_A}, 110ms);
+	std::this_thread::sleep_for(200ms);
+
+	auto events = sink.Events();
+	REQUIRE(events.size() >= 4);
+	REQUIRE(events.front() == std::make_pair(HotkeyType::Key_A, true));
+	REQUIRE(events.back() == std::make_pair(HotkeyType::Key_A, false));
+	for (size_t i = 0; i < events.size() - 1; ++i) {
+		REQUIRE(events[i].second);
+	}
+}
+
+TEST_CASE("Key presses are held for the minimum duration",
+	  "[key-press-scheduler]")
+{
+	RecordingSink sink;
+	advss::KeyPressScheduler scheduler(sink.Get(), {}, 100ms);
+	scheduler.Press({HotkeyType::Key_A}, 0ms);
+	std::this_thread::sleep_for(50ms);
+	REQUIRE(scheduler.IsPressed(HotkeyType::Key_A));
+	REQUIRE(sink.Events().size() == 1);
+
+	std::this_thread::sleep_for(150ms);
+	REQUIRE_FALSE(scheduler.IsPressed(HotkeyType::Key_A));
+	REQUIRE(sink.Events().size() == 2);
+}
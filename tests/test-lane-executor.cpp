@@ -0,0 +1,134 @@
+#include "catch.hpp"
+
+#include <lane-executor.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+static int laneA = 0;
+static int laneB = 0;
+static int laneC = 0;
+
+TEST_CASE("Tasks of a lane run in order", "[lane-executor]")
+{
+	advss::LaneExecutor executor(4);
+	std::mutex mutex;
+	std::vector<int> order;
+	std::atomic_int running = 0;
+	std::atomic_bool overlapped = false;
+
+	for (int i = 0; i < 20; ++i) {
+		executor.Submit(&laneA, [&, i]() {
+			if (++running > 1) {
+				overlapped = true;
+			}
+			std::this_thread::sleep_for(1ms);
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				order.push_back(i);
+			}
+			--running;
+		});
+	}
+	executor.WaitUntilIdle();
+
+	REQUIRE_FALSE(overlapped);
+	REQUIRE(order.size() == 20);
+	for (int i = 0; i < 20; ++i) {
+		REQUIRE(order[i] == i);
+	}
+	REQUIRE_FALSE(executor.IsBusy(&laneA));
+}
+
+TEST_CASE("Different lanes run concurrently", "[lane-executor]")
+{
+	advss::LaneExecutor executor(2);
+	std::atomic_bool release = false;
+	std::atomic_bool otherLaneDone = false;
+
+	executor.Submit(&laneA, [&]() {
+		while (!release) {
+			std::this_thread::sleep_for(1ms);
+		}
+	});
+	executor.Submit(&laneB, [&]() { otherLaneDone = true; });
+
+	for (int i = 0; i < 1000 && !otherLaneDone; ++i) {
+		std::this_thread::sleep_for(1ms);
+	}
+	REQUIRE(otherLaneDone);
+	REQUIRE(executor.IsBusy(&laneA));
+	REQUIRE_FALSE(executor.IsBusy(&laneB));
+
+	release = true;
+	executor.WaitUntilIdle();
+	REQUIRE_FALSE(executor.IsBusy(&laneA));
+}
+
+TEST_CASE("Exclusive tasks do not overlap with other tasks",
+	  "[lane-executor]")
+{
+	advss::LaneExecutor executor(4);
+	std::atomic_int running = 0;
+	std::atomic_bool overlapped = false;
+
+	auto task = [&]() {
+		++running;
+		std::this_thread::sleep_for(2ms);
+		--running;
+	};
+	auto exclusiveTask = [&]() {
+		if (++running > 1) {
+			overlapped = true;
+		}
+		std::this_thread::sleep_for(2ms);
+		--running;
+	};
+
+	for (int i = 0; i < 5; ++i) {
+		executor.Submit(&laneA, task);
+		executor.Submit(&laneB, task);
+		executor.Submit(&laneC, exclusiveTask, true);
+	}
+	executor.WaitUntilIdle();
+
+	REQUIRE_FALSE(overlapped);
+}
+
+TEST_CASE("Cancel drops queued tasks of a lane", "[lane-executor]")
+{
+	advss::LaneExecutor executor(1);
+	std::atomic_bool started = false;
+	std::atomic_bool release = false;
+	std::atomic_int count = 0;
+
+	executor.Submit(&laneA, [&]() {
+		started = true;
+		while (!release) {
+			std::this_thread::sleep_for(1ms);
+		}
+		++count;
+	});
+	executor.Submit(&laneA, [&]() { ++count; });
+	executor.Submit(&laneB, [&]() { ++count; });
+
+	while (!started) {
+		std::this_thread::sleep_for(1ms);
+	}
+	std::thread releaser([&]() {
+		std::this_thread::sleep_for(10ms);
+		release = true;
+	});
+	// Waits for the running task
+	REQUIRE(executor.Cancel(&laneA));
+	REQUIRE_FALSE(executor.IsBusy(&laneA));
+	releaser.join();
+
+	executor.WaitUntilIdle();
+	REQUIRE(count == 2);
+	REQUIRE_FALSE(executor.Cancel(&laneA));
+}
@@ -0,0 +1,63 @@
+#include "catch.hpp"
+
+#include <latency-histogram.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Empty latency histogram", "[latency-histogram]")
+{
+	advss::LatencyHistogram histogram;
+
+	REQUIRE(histogram.Count() == 0);
+	REQUIRE(histogram.Min() == 0us);
+	REQUIRE(histogram.Max() == 0us);
+	REQUIRE(histogram.Mean() == 0us);
+	REQUIRE(histogram.Percentile(50.0) == 0us);
+}
+
+TEST_CASE("Latency histogram buckets", "[latency-histogram]")
+{
+	advss::LatencyHistogram histogram;
+
+	histogram.Record(0us);
+	histogram.Record(1us);
+	histogram.Record(3us);
+	histogram.Record(1000us);
+
+	const auto &buckets = histogram.Buckets();
+	REQUIRE(buckets[0] == 1);
+	REQUIRE(buckets[1] == 1);
+	REQUIRE(buckets[2] == 1);
+	// 2^9 <= 1000 < 2^10
+	REQUIRE(buckets[10] == 1);
+	REQUIRE(advss::LatencyHistogram::BucketUpperBound(10) == 1024us);
+
+	// Negative durations are counted as zero
+	histogram.Record(-5us);
+	REQUIRE(buckets[0] == 2);
+	REQUIRE(histogram.Min() == 0us);
+}
+
+TEST_CASE("Latency histogram aggregates", "[latency-histogram]")
+{
+	advss::LatencyHistogram histogram;
+
+	for (int i = 0; i < 99; ++i) {
+		histogram.Record(10us);
+	}
+	histogram.Record(50000us);
+
+	REQUIRE(histogram.Count() == 100);
+	REQUIRE(histogram.Min() == 10us);
+	REQUIRE(histogram.Max() == 50000us);
+	REQUIRE(histogram.Mean() == 509us);
+	// Percentiles are reported as the upper bound of the bucket
+	REQUIRE(histogram.Percentile(50.0) == 16us);
+	REQUIRE(histogram.Percentile(99.0) == 16us);
+	// The maximum is a tighter bound than the bucket
+	REQUIRE(histogram.Percentile(100.0) == 50000us);
+
+	histogram.Clear();
+	REQUIRE(histogram.Count() == 0);
+	REQUIRE(histogram.Buckets()[4] == 0);
+}
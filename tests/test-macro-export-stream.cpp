@@ -0,0 +1,69 @@
+#include "catch.hpp"
+
+#include <macro-export-stream.hpp>
+
+#include <QTemporaryDir>
+
+TEST_CASE("Macro export file round trip", "[macro-export-stream]")
+{
+	QTemporaryDir dir;
+	REQUIRE(dir.isValid());
+	const auto path = dir.filePath("export.advss");
+
+	advss::MacroExportWriter writer(path);
+	REQUIRE(writer.IsOpen());
+	REQUIRE(writer.WriteChunk("{\"version\":\"1.0\"}"));
+	REQUIRE(writer.WriteChunk(QByteArray(100000, 'a')));
+	REQUIRE_FALSE(writer.WriteChunk(QByteArray()));
+	REQUIRE(writer.Finish());
+
+	advss::MacroImportReader reader(path);
+	REQUIRE(reader.IsOpen());
+	QByteArray chunk;
+	REQUIRE(reader.ReadChunk(chunk));
+	REQUIRE(chunk == "{\"version\":\"1.0\"}");
+	REQUIRE(reader.Progress() < 100);
+	REQUIRE(reader.ReadChunk(chunk));
+	REQUIRE(chunk == QByteArray(100000, 'a'));
+	REQUIRE_FALSE(reader.ReadChunk(chunk));
+	REQUIRE_FALSE(reader.Failed());
+	REQUIRE(reader.Progress() == 100);
+}
+
+TEST_CASE("Macro export file corruption", "[macro-export-stream]")
+{
+	QTemporaryDir dir;
+	REQUIRE(dir.isValid());
+	const auto path = dir.filePath("export.advss");
+
+	{
+		QFile file(path);
+		REQUIRE(file.open(QIODevice::WriteOnly));
+		file.write("{\"macros\":[]}");
+	}
+	advss::MacroImportReader invalidHeader(path);
+	REQUIRE_FALSE(invalidHeader.IsOpen());
+
+	advss::MacroExportWriter writer(path);
+	REQUIRE(writer.WriteChunk("{\"version\":\"1.0\"}"));
+	REQUIRE(writer.WriteChunk("{\"macros\":[]}"));
+	writer.Discard();
+	REQUIRE_FALSE(QFile::exists(path));
+
+	// Files without the end marker are treated as truncated
+	advss::MacroExportWriter truncatedWriter(path);
+	REQUIRE(truncatedWriter.WriteChunk("{\"version\":\"1.0\"}"));
+	truncatedWriter.Finish();
+	{
+		QFile file(path);
+		REQUIRE(file.open(QIODevice::ReadWrite));
+		REQUIRE(file.resize(file.size() - 2));
+	}
+
+	advss::MacroImportReader reader(path);
+	REQUIRE(reader.IsOpen());
+	QByteArray chunk;
+	REQUIRE(reader.ReadChunk(chunk));
+	REQUIRE_FALSE(reader.ReadChunk(chunk));
+	REQUIRE(reader.Failed());
+}
@@ -0,0 +1,89 @@
+#include "catch.hpp"
+
+#include <message-dispatcher.hpp>
+
+TEST_CASE("Dispatch to all clients", "[message-dispatcher]")
+{
+	advss::MessageDispatcher<int> dispatcher;
+	auto client1 = dispatcher.RegisterClient();
+	auto client2 = dispatcher.RegisterClient();
+
+	dispatcher.DispatchMessage(1);
+	REQUIRE(*client1->ConsumeMessage() == 1);
+	REQUIRE(*client2->ConsumeMessage() == 1);
+
+	dispatcher.DispatchMessage(2, "key");
+	REQUIRE(*client1->ConsumeMessage() == 2);
+	REQUIRE(*client2->ConsumeMessage() == 2);
+
+	client2.reset();
+	dispatcher.DispatchMessage(3);
+	REQUIRE(*client1->ConsumeMessage() == 3);
+	REQUIRE(client1->Empty());
+}
+
+TEST_CASE("Dispatch by key", "[message-dispatcher]")
+{
+	advss::MessageDispatcher<int> dispatcher;
+	auto all = dispatcher.RegisterClient();
+	auto a = dispatcher.RegisterClient("a");
+	auto b = dispatcher.RegisterClient("b");
+
+	dispatcher.DispatchMessage(1, "a");
+	REQUIRE(*all->ConsumeMessage() == 1);
+	REQUIRE(*a->ConsumeMessage() == 1);
+	REQUIRE(b->Empty());
+
+	dispatcher.DispatchMessage(2, "c");
+	REQUIRE(*all->ConsumeMessage() == 2);
+	REQUIRE(a->Empty());
+	REQUIRE(b->Empty());
+
+	// Messages without key are not delivered to keyed clients
+	dispatcher.DispatchMessage(3);
+	REQUIRE(*all->ConsumeMessage() == 3);
+	REQUIRE(a->Empty());
+	REQUIRE(b->Empty());
+
+	auto b2 = dispatcher.RegisterClient("b");
+	dispatcher.DispatchMessage(4, "b");
+	REQUIRE(*b->ConsumeMessage() == 4);
+	REQUIRE(*b2->ConsumeMessage() == 4);
+	REQUIRE(a->Empty());
+}
+
+TEST_CASE("Dispatch only to keyed clients", "[message-dispatcher]")
+{
+	advss::MessageDispatcher<int> dispatcher;
+	auto all = dispatcher.RegisterClient();
+	auto a = dispatcher.RegisterClient("a");
+
+	dispatcher.DispatchMessageToKey(1, "a");
+	REQUIRE(all->Empty());
+	REQUIRE(*a->ConsumeMessage() == 1);
+
+	dispatcher.DispatchMessageToKey(2, "b");
+	REQUIRE(all->Empty());
+	REQUIRE(a->Empty());
+}
+
+TEST_CASE("Messages keep their arrival time", "[message-dispatcher]")
+{
+	advss::MessageDispatcher<int> dispatcher;
+	auto client = dispatcher.RegisterClient();
+
+	const auto before = advss::MessageBuffer<int>::Clock::now();
+	dispatcher.DispatchMessage(1);
+	const auto between = advss::MessageBuffer<int>::Clock::now();
+	dispatcher.DispatchMessage(2);
+	const auto after = advss::MessageBuffer<int>::Clock::now();
+
+	advss::MessageBuffer<int>::Clock::time_point arrival;
+	REQUIRE(*client->ConsumeMessage(arrival) == 1);
+	REQUIRE(arrival >= before);
+	REQUIRE(arrival <= between);
+	REQUIRE(*client->ConsumeMessage(arrival) == 2);
+	REQUIRE(arrival >= between);
+	REQUIRE(arrival <= after);
+	REQUIRE_FALSE(client->ConsumeMessage(arrival));
+}
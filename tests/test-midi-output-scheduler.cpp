@@ -0,0 +1,147 @@
+#include "catch.hpp"
+
+#include <midi-output-scheduler.hpp>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("MIDI output events are returned in order", "[midi-output]")
+{
+	auto now = advss::MidiOutputQueue::Clock::now();
+	advss::MidiOutputQueue queue;
+
+	queue.Push({now + 20ms, {{0x90, 0x01, 0x7F}}});
+	queue.Push({now + 10ms, {{0x90, 0x02, 0x7F}}});
+	queue.Push({now + 10ms, {{0x90, 0x03, 0x7F}}});
+	REQUIRE(*queue.NextTime() == now + 10ms);
+
+	REQUIRE(queue.TakeDue(now).empty());
+	auto due = queue.TakeDue(now + 10ms);
+	REQUIRE(due.size() == 2);
+	REQUIRE(due[0].messages[0][1] == 0x02);
+	REQUIRE(due[1].messages[0][1] == 0x03);
+
+	due = queue.TakeDue(now + 1s);
+	REQUIRE(due.size() == 1);
+	REQUIRE(due[0].messages[0][1] == 0x01);
+	REQUIRE(queue.Empty());
+	REQUIRE_FALSE(queue.NextTime());
+}
+
+TEST_CASE("Redundant MIDI control changes are coalesced", "[midi-output]")
+{
+	auto now = advss::MidiOutputQueue::Clock::now();
+	advss::MidiOutputQueue queue;
+
+	queue.Push({now, {advss::MakeMidiControlChange(1, 7, 10)}});
+	queue.Push({now, {{0x90, 0x01, 0x7F}}});
+	queue.Push({now, {advss::MakeMidiControlChange(2, 7, 20)}});
+	queue.Push({now, {advss::MakeMidiControlChange(1, 7, 30)}});
+	queue.Push({now, advss::MakeMidiControlChange14Bit(1, 1, 1000)});
+	queue.Push({now, advss::MakeMidiControlChange14Bit(1, 1, 2000)});
+	queue.Push({now, {{0xF0, 0x7E, 0x7F, 0xF7}}});
+
+	auto due = queue.TakeDue(now);
+	REQUIRE(due.size() == 5);
+	REQUIRE(due[0].messages[0] == advss::RawMidiMessage{0x90, 0x01, 0x7F});
+	REQUIRE(due[1].messages[0] ==
+		advss::RawMidiMessage{0xB1, 0x07, 20});
+	REQUIRE(due[2].messages[0] ==
+		advss::RawMidiMessage{0xB0, 0x07, 30});
+	REQUIRE(due[3].messages ==
+		advss::MakeMidiControlChange14Bit(1, 1, 2000));
+	REQUIRE(due[4].messages[0].size() == 4);
+}
+
+TEST_CASE("14-bit MIDI control changes are split", "[midi-output]")
+{
+	auto messages = advss::MakeMidiControlChange14Bit(3, 7, 0x3FFF);
+	REQUIRE(messages.size() == 2);
+	REQUIRE(messages[0] == advss::RawMidiMessage{0xB2, 7, 0x7F});
+	REQUIRE(messages[1] == advss::RawMidiMessage{0xB2, 39, 0x7F});
+}
+
+TEST_CASE("MIDI sequences are parsed", "[midi-output]")
+{
+	auto start = advss::MidiOutputQueue::Clock::now();
+	std::string error;
+
+	auto events = advss::ParseMidiSequence("# comment\n"
+					       "B0 07 7F\n"
+					       "\n"
+					       "+100 F0 7E 7F 06 01 F7\n"
+					       "+50 cc14 1 1 8192\n",
+					       start, &error);
+	REQUIRE(events);
+	REQUIRE(events->size() == 3);
+	REQUIRE((*events)[0].time == start);
+	REQUIRE((*events)[0].messages[0] ==
+		advss::RawMidiMessage{0xB0, 0x07, 0x7F});
+	REQUIRE((*events)[1].time == start + 100ms);
+	REQUIRE((*events)[1].messages[0].size() == 6);
+	REQUIRE((*events)[2].time == start + 150ms);
+	REQUIRE((*events)[2].messages.size() == 2);
+
+	REQUIRE_FALSE(advss::ParseMidiSequence("B0 07 XY", start, &error));
+	REQUIRE(error == "line 1: invalid byte \"XY\"");
+	REQUIRE_FALSE(advss::ParseMidiSequence("+-1 B0 07 7F", start));
+	REQUIRE_FALSE(advss::ParseMidiSequence("07 7F", start));
+	REQUIRE_FALSE(advss::ParseMidiSequence("+10", start));
+	REQUIRE_FALSE(advss::ParseMidiSequence("cc14 1 40 0", start));
+}
+
+TEST_CASE("MIDI output scheduler sends events", "[midi-output]")
+{
+	std::mutex mutex;
+	std::condition_variable cv;
+	std::vector<advss::RawMidiMessage> sent;
+
+	advss::MidiOutputScheduler scheduler(
+		[&](const advss::RawMidiMessage &message) {
+			std::lock_guard<std::mutex> lock(mutex);
+			sent.push_back(message);
+			cv.notify_all();
+			return true;
+		});
+
+	auto now = advss::MidiOutputScheduler::Clock::now();
+	scheduler.Schedule({{now + 10ms, {{0x90, 0x02, 0x7F}}},
+			    {now, {{0x90, 0x01, 0x7F}}}});
+
+	std::unique_lock<std::mutex> lock(mutex);
+	REQUIRE(cv.wait_for(lock, 5s, [&]() { return sent.size() == 2; }));
+	REQUIRE(sent[0][1] == 0x01);
+	REQUIRE(sent[1][1] == 0x02);
+}
+
+TEST_CASE("MIDI output scheduler counts failed sends", "[midi-output]")
+{
+	std::mutex mutex;
+	std::condition_variable cv;
+	size_t attempts = 0;
+
+	advss::MidiOutputScheduler scheduler(
+		[&](const advss::RawMidiMessage &message) {
+			std::lock_guard<std::mutex> lock(mutex);
+			++attempts;
+			cv.notify_all();
+			return message[1] != 0x02;
+		});
+
+	auto now = advss::MidiOutputScheduler::Clock::now();
+	scheduler.Schedule({{now, {{0x90, 0x01, 0x7F}, {0x90, 0x02, 0x7F}}},
+			    {now + 10ms, {{0x90, 0x02, 0x7F}}}});
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		REQUIRE(cv.wait_for(lock, 5s, [&]() { return attempts == 3; }));
+	}
+	// The failures are counted once the flush completed
+	for (int i = 0; i < 500 && scheduler.FailedCount() != 2; i++) {
+		std::this_thread::sleep_for(10ms);
+	}
+	REQUIRE(scheduler.FailedCount() == 2);
+}
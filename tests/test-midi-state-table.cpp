@@ -0,0 +1,96 @@
+#include "catch.hpp"
+
+#include <midi-state-table.hpp>
+
+using namespace std::chrono_literals;
+using Kind = advss::MidiStateTable::Kind;
+
+TEST_CASE("MIDI state table stores last values", "[midi-state-table]")
+{
+	auto epoch = advss::MidiStateTable::Clock::now();
+	advss::MidiStateTable table(epoch);
+
+	REQUIRE_FALSE(table.Get(Kind::CONTROL_CHANGE, 1, 7));
+
+	table.Set(Kind::CONTROL_CHANGE, 1, 7, 42, epoch + 10ms);
+	table.Set(Kind::CONTROL_CHANGE, 1, 7, 100, epoch + 20ms);
+	auto entry = table.Get(Kind::CONTROL_CHANGE, 1, 7);
+	REQUIRE(entry);
+	REQUIRE(entry->value == 100);
+	REQUIRE(entry->time == epoch + 20ms);
+
+	// Kinds and channels are tracked separately
+	REQUIRE_FALSE(table.Get(Kind::NOTE, 1, 7));
+	REQUIRE_FALSE(table.Get(Kind::CONTROL_CHANGE, 2, 7));
+
+	// Zero is a valid value
+	table.Set(Kind::NOTE, 16, 127, 0, epoch);
+	entry = table.Get(Kind::NOTE, 16, 127);
+	REQUIRE(entry);
+	REQUIRE(entry->value == 0);
+
+	// The number is ignored for pitch bend
+	table.Set(Kind::PITCH_BEND, 3, 5, 64, epoch);
+	REQUIRE(table.Get(Kind::PITCH_BEND, 3)->value == 64);
+
+	table.Clear();
+	REQUIRE_FALSE(table.Get(Kind::CONTROL_CHANGE, 1, 7));
+	REQUIRE_FALSE(table.Get(Kind::PITCH_BEND, 3));
+}
+
+TEST_CASE("MIDI state table ignores invalid input", "[midi-state-table]")
+{
+	advss::MidiStateTable table;
+
+	table.Set(Kind::CONTROL_CHANGE, 0, 7, 1);
+	table.Set(Kind::CONTROL_CHANGE, 17, 7, 1);
+	table.Set(Kind::CONTROL_CHANGE, 1, 128, 1);
+	table.Set(Kind::CONTROL_CHANGE, 1, 7, -1);
+
+	REQUIRE_FALSE(table.Get(Kind::CONTROL_CHANGE, 0, 7));
+	REQUIRE_FALSE(table.Get(Kind::CONTROL_CHANGE, 17, 7));
+	REQUIRE_FALSE(table.Get(Kind::CONTROL_CHANGE, 1, 128));
+	REQUIRE_FALSE(table.Get(Kind::CONTROL_CHANGE, 1, 7));
+}
+
+TEST_CASE("MIDI state table returns latest value of any channel or number",
+	  "[midi-state-table]")
+{
+	auto epoch = advss::MidiStateTable::Clock::now();
+	advss::MidiStateTable table(epoch);
+
+	REQUIRE_FALSE(table.GetLatest(Kind::CONTROL_CHANGE, {}, {}));
+
+	table.Set(Kind::CONTROL_CHANGE, 1, 7, 10, epoch + 10ms);
+	table.Set(Kind::CONTROL_CHANGE, 5, 7, 20, epoch + 30ms);
+	table.Set(Kind::CONTROL_CHANGE, 1, 9, 30, epoch + 20ms);
+
+	auto entry = table.GetLatest(Kind::CONTROL_CHANGE, {}, {});
+	REQUIRE(entry);
+	REQUIRE(entry->value == 20);
+	REQUIRE(entry->channel == 5);
+	REQUIRE(entry->number == 7);
+
+	// Any number of the given channel
+	entry = table.GetLatest(Kind::CONTROL_CHANGE, 1, {});
+	REQUIRE(entry);
+	REQUIRE(entry->value == 30);
+	REQUIRE(entry->number == 9);
+
+	// Any channel of the given number
+	entry = table.GetLatest(Kind::CONTROL_CHANGE, {}, 9);
+	REQUIRE(entry);
+	REQUIRE(entry->channel == 1);
+
+	entry = table.GetLatest(Kind::CONTROL_CHANGE, 1, 7);
+	REQUIRE(entry);
+	REQUIRE(entry->value == 10);
+	REQUIRE_FALSE(table.GetLatest(Kind::CONTROL_CHANGE, 2, {}));
+	REQUIRE_FALSE(table.GetLatest(Kind::NOTE, {}, {}));
+
+	table.Set(Kind::PITCH_BEND, 3, 0, 64, epoch);
+	entry = table.GetLatest(Kind::PITCH_BEND, {}, 5);
+	REQUIRE(entry);
+	REQUIRE(entry->value == 64);
+	REQUIRE(entry->channel == 3);
+}
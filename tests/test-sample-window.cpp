@@ -0,0 +1,62 @@
+#include "catch.hpp"
+
+#include <sample-window.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Empty sample window", "[sample-window]")
+{
+	advss::SampleWindow window(4);
+
+	REQUIRE(window.Size() == 0);
+	REQUIRE_FALSE(window.Latest());
+	REQUIRE_FALSE(window.Average(10s));
+	REQUIRE_FALSE(window.Min(10s));
+	REQUIRE_FALSE(window.Max(10s));
+	REQUIRE_FALSE(window.Percentile(10s, 50.0));
+}
+
+TEST_CASE("Sample window aggregates", "[sample-window]")
+{
+	advss::SampleWindow window(8);
+	auto now = advss::SampleWindow::Clock::now();
+
+	window.Add(4.0, now - 4s);
+	window.Add(1.0, now - 3s);
+	window.Add(3.0, now - 2s);
+	window.Add(2.0, now - 1s);
+
+	REQUIRE(*window.Latest() == 2.0);
+	REQUIRE(*window.Average(10s, now) == 2.5);
+	REQUIRE(*window.Min(10s, now) == 1.0);
+	REQUIRE(*window.Max(10s, now) == 4.0);
+	REQUIRE(*window.Percentile(10s, 50.0, now) == 2.0);
+	REQUIRE(*window.Percentile(10s, 100.0, now) == 4.0);
+	REQUIRE(*window.Percentile(10s, 0.0, now) == 1.0);
+
+	// Only the two most recent samples are within the window
+	REQUIRE(*window.Average(2500ms, now) == 2.5);
+	REQUIRE(*window.Max(2500ms, now) == 3.0);
+
+	// The latest sample is always considered
+	REQUIRE(*window.Min(0ms, now) == 2.0);
+}
+
+TEST_CASE("Sample window overwrites oldest samples", "[sample-window]")
+{
+	advss::SampleWindow window(3);
+	auto now = advss::SampleWindow::Clock::now();
+
+	for (int i = 1; i <= 5; ++i) {
+		window.Add(i, now);
+	}
+
+	REQUIRE(window.Size() == 3);
+	REQUIRE(*window.Latest() == 5.0);
+	REQUIRE(*window.Min(10s, now) == 3.0);
+	REQUIRE(*window.Average(10s, now) == 4.0);
+
+	window.Clear();
+	REQUIRE(window.Size() == 0);
+	REQUIRE_FALSE(window.Latest());
+}
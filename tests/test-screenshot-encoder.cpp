@@ -0,0 +1,97 @@
+#include "catch.hpp"
+
+#include <screenshot-encoder.hpp>
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+static QImage createImage(const QColor &color)
+{
+	QImage image(16, 16, QImage::Format_RGBA8888);
+	image.fill(color);
+	return image;
+}
+
+TEST_CASE("Screenshot paths are formatted", "[screenshot-encoder]")
+{
+	const QDateTime time(QDate(2024, 1, 2), QTime(3, 4, 5, 6));
+	REQUIRE(advss::ScreenshotEncoder::FormatPath("a/{counter}.png", 42,
+						     time) ==
+		"a/000042.png");
+	REQUIRE(advss::ScreenshotEncoder::FormatPath("{timestamp}.png", 1,
+						     time) ==
+		"20240102-030405-006.png");
+	REQUIRE(advss::ScreenshotEncoder::FormatPath("plain.png", 1, time) ==
+		"plain.png");
+}
+
+TEST_CASE("Screenshots are encoded", "[screenshot-encoder]")
+{
+	QTemporaryDir dir;
+	REQUIRE(dir.isValid());
+	const auto pathTemplate =
+		QDir(dir.path()).filePath("{counter}.png").toStdString();
+
+	advss::ScreenshotEncoder encoder(8, 2);
+	advss::ScreenshotEncoder::Settings settings;
+	settings.format = advss::ScreenshotEncoder::Format::PNG;
+	settings.skipDuplicates = true;
+	settings.keepCount = 2;
+
+	REQUIRE(encoder.Enqueue(createImage(Qt::red), pathTemplate, settings));
+	encoder.WaitUntilIdle();
+	REQUIRE(encoder.Enqueue(createImage(Qt::red), pathTemplate, settings));
+	encoder.WaitUntilIdle();
+	REQUIRE(encoder.WrittenCount() == 1);
+	REQUIRE(encoder.SkippedCount() == 1);
+
+	REQUIRE(encoder.Enqueue(createImage(Qt::green), pathTemplate,
+				settings));
+	encoder.WaitUntilIdle();
+	REQUIRE(encoder.Enqueue(createImage(Qt::blue), pathTemplate,
+				settings));
+	encoder.WaitUntilIdle();
+	REQUIRE(encoder.WrittenCount() == 3);
+
+	// Only the two most recent files are kept
+	// and skipped images do not advance the counter
+	REQUIRE_FALSE(QFile::exists(dir.filePath("000001.png")));
+	REQUIRE(QFile::exists(dir.filePath("000002.png")));
+	REQUIRE(QFile::exists(dir.filePath("000003.png")));
+	REQUIRE_FALSE(QFile::exists(dir.filePath("000004.png")));
+
+	QImage loaded(dir.filePath("000003.png"));
+	REQUIRE(loaded.pixelColor(0, 0) == QColor(Qt::blue));
+}
+
+TEST_CASE("Screenshot duplicates are detected across workers",
+	  "[screenshot-encoder]")
+{
+	QTemporaryDir dir;
+	REQUIRE(dir.isValid());
+	const auto pathTemplate =
+		QDir(dir.path()).filePath("{counter}.png").toStdString();
+
+	advss::ScreenshotEncoder encoder(16, 4);
+	advss::ScreenshotEncoder::Settings settings;
+	settings.format = advss::ScreenshotEncoder::Format::PNG;
+	settings.skipDuplicates = true;
+
+	for (int i = 0; i < 8; i++) {
+		REQUIRE(encoder.Enqueue(createImage(Qt::red), pathTemplate,
+					settings));
+	}
+	for (int i = 0; i < 4; i++) {
+		REQUIRE(encoder.Enqueue(createImage(Qt::green), pathTemplate,
+					settings));
+	}
+	encoder.WaitUntilIdle();
+
+	REQUIRE(encoder.WrittenCount() == 2);
+	REQUIRE(encoder.SkippedCount() == 10);
+	QImage first(dir.filePath("000001.png"));
+	REQUIRE(first.pixelColor(0, 0) == QColor(Qt::red));
+	QImage second(dir.filePath("000002.png"));
+	REQUIRE(second.pixelColor(0, 0) == QColor(Qt::green));
+}
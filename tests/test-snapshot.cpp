@@ -0,0 +1,54 @@
+#include "catch.hpp"
+
+#include <snapshot.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Snapshot", "[snapshot]")
+{
+	advss::Snapshot<std::vector<int>> snapshot;
+	REQUIRE(snapshot.Get());
+	REQUIRE(snapshot.Get()->empty());
+	REQUIRE(snapshot.Version() == 0);
+
+	snapshot.Publish({1, 2, 3});
+	auto first = snapshot.Get();
+	REQUIRE(*first == std::vector<int>{1, 2, 3});
+	REQUIRE(snapshot.Version() == 1);
+	REQUIRE(snapshot.Get() == first);
+
+	// Previously acquired snapshots are not affected by updates
+	snapshot.Publish({4});
+	REQUIRE(*first == std::vector<int>{1, 2, 3});
+	REQUIRE(*snapshot.Get() == std::vector<int>{4});
+	REQUIRE(snapshot.Version() == 2);
+}
+
+TEST_CASE("Snapshot concurrent access", "[snapshot]")
+{
+	advss::Snapshot<std::vector<int>> snapshot;
+	std::atomic_bool stop = false;
+	std::atomic_bool inconsistent = false;
+
+	std::thread reader([&]() {
+		while (!stop) {
+			auto values = snapshot.Get();
+			for (size_t i = 0; i < values->size(); ++i) {
+				if ((*values)[i] != (int)values->size()) {
+					inconsistent = true;
+				}
+			}
+		}
+	});
+
+	for (int i = 0; i < 1000; ++i) {
+		snapshot.Publish(std::vector<int>(i, i));
+	}
+	stop = true;
+	reader.join();
+
+	REQUIRE_FALSE(inconsistent);
+	REQUIRE(snapshot.Version() == 1000);
+}
@@ -0,0 +1,77 @@
+#include "catch.hpp"
+
+#include <state-event-log.hpp>
+
+using namespace std::chrono_literals;
+
+enum class TestEvent { START, STOP, PAUSE };
+
+TEST_CASE("Empty state event log", "[state-event-log]")
+{
+	advss::StateEventLog<TestEvent> log(4);
+
+	REQUIRE(log.Size() == 0);
+	REQUIRE(log.LatestId() == 0);
+	REQUIRE_FALSE(log.Latest());
+	REQUIRE_FALSE(log.LastOccurrence(TestEvent::START));
+	REQUIRE_FALSE(log.OccurredSince(TestEvent::START, 0));
+	REQUIRE(log.GetEventTypesSince(0).empty());
+	REQUIRE(log.GetSince(0).empty());
+}
+
+TEST_CASE("State event log ids and timestamps", "[state-event-log]")
+{
+	advss::StateEventLog<TestEvent> log(4);
+	auto now = advss::StateEventLog<TestEvent>::Clock::now();
+
+	REQUIRE(log.Add(TestEvent::START, now - 3s) == 1);
+	REQUIRE(log.Add(TestEvent::STOP, now - 2s) == 2);
+	REQUIRE(log.Add(TestEvent::START, now - 1s) == 3);
+
+	REQUIRE(log.Size() == 3);
+	REQUIRE(log.LatestId() == 3);
+	REQUIRE(log.Latest()->event == TestEvent::START);
+
+	REQUIRE(log.OccurredSince(TestEvent::STOP, 1));
+	REQUIRE_FALSE(log.OccurredSince(TestEvent::STOP, 2));
+	REQUIRE(log.OccurredSince(TestEvent::START, 2));
+	REQUIRE_FALSE(log.OccurredSince(TestEvent::PAUSE, 0));
+
+	REQUIRE(log.OccurredSince(TestEvent::STOP, now - 2500ms));
+	REQUIRE_FALSE(log.OccurredSince(TestEvent::STOP, now - 1500ms));
+
+	const auto types = log.GetEventTypesSince(1);
+	REQUIRE(types.size() == 2);
+	REQUIRE(types.count(TestEvent::START));
+	REQUIRE(types.count(TestEvent::STOP));
+
+	const auto entries = log.GetSince(1);
+	REQUIRE(entries.size() == 2);
+	REQUIRE(entries[0].id == 2);
+	REQUIRE(entries[1].id == 3);
+}
+
+TEST_CASE("State event log keeps edges of overwritten entries",
+	  "[state-event-log]")
+{
+	advss::StateEventLog<TestEvent> log(2);
+
+	log.Add(TestEvent::PAUSE);
+	log.Add(TestEvent::START);
+	log.Add(TestEvent::STOP);
+	log.Add(TestEvent::START);
+
+	REQUIRE(log.Size() == 2);
+	REQUIRE(log.GetSince(0).size() == 2);
+
+	// The pause event was already overwritten in the ring buffer
+	REQUIRE(log.OccurredSince(TestEvent::PAUSE, 0));
+	REQUIRE(log.GetEventTypesSince(0).count(TestEvent::PAUSE));
+	REQUIRE_FALSE(log.GetEventTypesSince(1).count(TestEvent::PAUSE));
+
+	log.Clear();
+	REQUIRE(log.Size() == 0);
+	REQUIRE_FALSE(log.LastOccurrence(TestEvent::START));
+	// Ids keep increasing so remembered ids stay valid
+	REQUIRE(log.Add(TestEvent::START) == 5);
+}
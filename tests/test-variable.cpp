@@ -1,6 +1,8 @@
 #include "catch.hpp"
 
 #include <variable.hpp>
+#include <variable-template.hpp>
+#include <nlohmann/json.hpp>
 #include <thread>
 
 TEST_CASE("Variable", "[variable]")
@@ -50,3 +52,159 @@ TEST_CASE("Variable", "[variable]")
 	variable.SetValue(123);
 	REQUIRE(*variable.GetSecondsSinceLastChange() > 0);
 }
+
+TEST_CASE("Typed values", "[variable]")
+{
+	advss::Variable variable;
+
+	variable.SetIntValue(42);
+	REQUIRE(variable.GetValueType() == advss::VariableValue::Type::INT);
+	REQUIRE(*variable.IntValue() == 42);
+	REQUIRE(*variable.DoubleValue() == 42.0);
+	REQUIRE(variable.Value() == "42");
+
+	variable.SetValue(1.5);
+	REQUIRE(variable.GetValueType() ==
+		advss::VariableValue::Type::DOUBLE);
+	REQUIRE_FALSE(variable.IntValue());
+	REQUIRE(*variable.DoubleValue() == 1.5);
+	REQUIRE(variable.Value() == "1.5");
+	REQUIRE(variable.GetPreviousValue() == "42");
+
+	variable.SetBoolValue(true);
+	REQUIRE(variable.Value() == "true");
+	REQUIRE_FALSE(variable.DoubleValue());
+
+	variable.SetValue("12");
+	REQUIRE(variable.GetValueType() ==
+		advss::VariableValue::Type::STRING);
+	REQUIRE(*variable.IntValue() == 12);
+	REQUIRE(*variable.DoubleValue() == 12.0);
+
+	variable.SetValue("abc");
+	REQUIRE_FALSE(variable.IntValue());
+	REQUIRE_FALSE(variable.DoubleValue());
+	REQUIRE_FALSE(variable.JsonValue());
+
+	variable.SetValue("{\"a\": 1}");
+	auto json = variable.JsonValue();
+	REQUIRE(json);
+	REQUIRE(json->is_object());
+	REQUIRE(variable.JsonValue() == json);
+
+	variable.SetJsonValue((*json)["a"]);
+	REQUIRE(variable.GetValueType() == advss::VariableValue::Type::JSON);
+	REQUIRE(*variable.IntValue() == 1);
+	REQUIRE(variable.Value() == "1");
+}
+
+TEST_CASE("Typed value change detection", "[variable]")
+{
+	advss::Variable variable;
+	variable.SetIntValue(5);
+	REQUIRE(variable.GetValueChangeCount() == 1);
+
+	// Same value with different representations is not a change
+	variable.SetValue("5");
+	REQUIRE(variable.GetValueChangeCount() == 1);
+	variable.SetValue(5.0);
+	REQUIRE(variable.GetValueChangeCount() == 1);
+
+	variable.SetValue(6.0);
+	REQUIRE(variable.GetValueChangeCount() == 2);
+}
+
+TEST_CASE("List and map values", "[variable]")
+{
+	advss::Variable variable;
+	REQUIRE_FALSE(variable.Size());
+
+	REQUIRE(variable.ListPush("b"));
+	REQUIRE(variable.ListPush("a", true));
+	REQUIRE(variable.ListPush("c"));
+	REQUIRE(variable.GetValueType() == advss::VariableValue::Type::LIST);
+	REQUIRE(*variable.Size() == 3);
+	REQUIRE(*variable.ListGet(0) == "a");
+	REQUIRE_FALSE(variable.ListGet(3));
+	REQUIRE(variable.Contains("b"));
+	REQUIRE(variable.Value() == "[\"a\",\"b\",\"c\"]");
+	REQUIRE(variable.GetValueChangeCount() == 3);
+
+	REQUIRE(variable.ListSet(1, "x"));
+	REQUIRE_FALSE(variable.ListSet(3, "x"));
+	REQUIRE(variable.ListSet(1, "x"));
+	REQUIRE(variable.GetValueChangeCount() == 4);
+	REQUIRE(*variable.ListPop(true) == "a");
+	REQUIRE(*variable.ListPop() == "c");
+	REQUIRE(*variable.ListPop() == "x");
+	REQUIRE_FALSE(variable.ListPop());
+	REQUIRE(variable.Value() == "[]");
+
+	// Map operations on a list are rejected
+	REQUIRE_FALSE(variable.MapSet("key", "value"));
+
+	variable.SetValue("");
+	REQUIRE(variable.MapSet("user", "1"));
+	REQUIRE(variable.MapSet("other", "2"));
+	REQUIRE(variable.GetValueType() == advss::VariableValue::Type::MAP);
+	REQUIRE(*variable.MapGet("user") == "1");
+	REQUIRE(variable.Contains("other"));
+	REQUIRE_FALSE(variable.Contains("1"));
+	REQUIRE(variable.Value() == "{\"other\":\"2\",\"user\":\"1\"}");
+	REQUIRE(variable.MapRemove("other"));
+	REQUIRE_FALSE(variable.MapRemove("other"));
+	REQUIRE(*variable.Elements() == std::vector<std::string>{"user"});
+
+	// JSON values can be read without conversion and are converted once
+	// they are modified
+	variable.SetValue("[1, \"two\", {\"a\": true}]");
+	REQUIRE(variable.GetValueType() ==
+		advss::VariableValue::Type::STRING);
+	REQUIRE(*variable.Size() == 3);
+	REQUIRE(*variable.ListGet(1) == "two");
+	REQUIRE(variable.Contains("1"));
+	REQUIRE(variable.ListPush("x"));
+	REQUIRE(variable.GetValueType() == advss::VariableValue::Type::LIST);
+	REQUIRE(*variable.ListGet(2) == "{\"a\":true}");
+
+	variable.SetValue("not a list");
+	REQUIRE_FALSE(variable.ListPush("x"));
+	REQUIRE(variable.Value() == "not a list");
+}
+
+namespace {
+
+class NamedVariable : public advss::Variable {
+public:
+	NamedVariable(const std::string &name, const std::string &value)
+	{
+		_name = name;
+		SetValue(value);
+	}
+};
+
+} // namespace
+
+TEST_CASE("Variable template", "[variable]")
+{
+	advss::VariableTemplate text("a ${x} b ${unknown} ${x}${");
+	REQUIRE(text.HasReferences());
+	REQUIRE(text.Resolve() == "a ${x} b ${unknown} ${x}${");
+
+	auto &variables = advss::GetVariables();
+	variables.emplace_back(std::make_shared<NamedVariable>("x", "1"));
+	REQUIRE(text.Resolve() == "a 1 b ${unknown} 1${");
+	REQUIRE(text.GetUnknownVariables() ==
+		std::vector<std::string>{"unknown"});
+
+	// Values containing references are not resolved again
+	variables.emplace_back(std::make_shared<NamedVariable>("y", "${x}"));
+	REQUIRE(advss::VariableTemplate("${y}").Resolve() == "${x}");
+	REQUIRE(advss::VariableTemplate("${a${x}}").Resolve() == "${a1}");
+
+	REQUIRE_FALSE(advss::VariableTemplate("plain").HasReferences());
+	REQUIRE(advss::VariableTemplate("plain").Resolve() == "plain");
+
+	variables.clear();
+	REQUIRE(text.Resolve() == "a ${x} b ${unknown} ${x}${");
+}